@@ -0,0 +1,84 @@
+# Convert TZif files into constexpr byte tables compiled into the datetime library.
+#
+# datetime_embed_zones(OUTPUT <file> DIRECTORY <zoneinfo dir> ZONES <name>...)
+#
+# Writes <file> (included by datetime_zone.cpp) with one byte array per zone and the
+# dt_embeddedZones table. Version 2+ files keep only their 64-bit block: the version 1 block
+# is emptied, which readers of version 2+ data skip anyway. The cost of every zone is printed
+# and written next to <file> as <file>.txt.
+
+function(datetime_embed_zones)
+    cmake_parse_arguments(DT "" "OUTPUT;DIRECTORY" "ZONES" ${ARGN})
+
+    set(dt_arrays "")
+    set(dt_entries "")
+    set(dt_report "")
+    set(dt_total 0)
+    set(dt_index 0)
+    foreach(dt_zone IN LISTS DT_ZONES)
+        set(dt_path "${DT_DIRECTORY}/${dt_zone}")
+        if(NOT EXISTS "${dt_path}" OR IS_DIRECTORY "${dt_path}")
+            message(FATAL_ERROR "datetime: time zone ${dt_zone} not found in ${DT_DIRECTORY}")
+        endif()
+        set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${dt_path}")
+
+        file(READ "${dt_path}" dt_hex HEX)
+        string(LENGTH "${dt_hex}" dt_hexLength)
+        math(EXPR dt_sourceSize "${dt_hexLength} / 2")
+        string(SUBSTRING "${dt_hex}" 0 8 dt_magic)
+        if(NOT dt_magic STREQUAL "545a6966")
+            message(FATAL_ERROR "datetime: ${dt_path} is not a TZif file")
+        endif()
+
+        # Drop the version 1 block of version 2+ files (header counts at bytes 20-43)
+        string(SUBSTRING "${dt_hex}" 8 2 dt_version)
+        if(NOT dt_version STREQUAL "00")
+            set(dt_counts "")
+            foreach(dt_offset 40 48 56 64 72 80)
+                string(SUBSTRING "${dt_hex}" ${dt_offset} 8 dt_count)
+                math(EXPR dt_count "0x${dt_count}")
+                list(APPEND dt_counts ${dt_count})
+            endforeach()
+            list(GET dt_counts 0 dt_isUtc)
+            list(GET dt_counts 1 dt_isStd)
+            list(GET dt_counts 2 dt_leap)
+            list(GET dt_counts 3 dt_times)
+            list(GET dt_counts 4 dt_types)
+            list(GET dt_counts 5 dt_chars)
+            math(EXPR dt_secondHeader "(44 + ${dt_times} * 5 + ${dt_types} * 6 + ${dt_chars} + ${dt_leap} * 8 + ${dt_isStd} + ${dt_isUtc}) * 2")
+            string(SUBSTRING "${dt_hex}" ${dt_secondHeader} -1 dt_rest)
+            string(REPEAT "00" 39 dt_emptyCounts)
+            set(dt_hex "545a6966${dt_version}${dt_emptyCounts}${dt_rest}")
+        endif()
+
+        string(LENGTH "${dt_hex}" dt_hexLength)
+        math(EXPR dt_size "${dt_hexLength} / 2")
+        string(LENGTH "${dt_zone}" dt_nameLength)
+        math(EXPR dt_cost "${dt_size} + ${dt_nameLength} + 1")
+        math(EXPR dt_total "${dt_total} + ${dt_cost}")
+        message(STATUS "datetime: embedding ${dt_zone}: ${dt_cost} bytes (${dt_sourceSize} in tzdata)")
+        string(APPEND dt_report "${dt_zone}\t${dt_cost}\t${dt_sourceSize}\n")
+
+        string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," dt_bytes "${dt_hex}")
+        string(REGEX REPLACE "(0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,0x..,)" "\\1\n    " dt_bytes "${dt_bytes}")
+        string(APPEND dt_arrays "// ${dt_zone} (${dt_size} bytes)\nconstexpr unsigned char dt_embeddedZone${dt_index}[] = {\n    ${dt_bytes}\n};\n\n")
+        string(APPEND dt_entries "    DT_EmbeddedZone{\"${dt_zone}\", dt_embeddedZone${dt_index}},\n")
+        math(EXPR dt_index "${dt_index} + 1")
+    endforeach()
+
+    list(LENGTH DT_ZONES dt_zoneCount)
+    message(STATUS "datetime: embedded ${dt_zoneCount} time zones, ${dt_total} bytes")
+    string(APPEND dt_report "total\t${dt_total}\n")
+    file(WRITE "${DT_OUTPUT}.txt" "zone\tembedded bytes\ttzdata bytes\n${dt_report}")
+
+    # Only touch the output when it changes, so reconfiguring does not force a rebuild
+    set(dt_content "// Generated by DateTimeEmbedZones.cmake from ${DT_DIRECTORY}; do not edit\n\n${dt_arrays}")
+    string(APPEND dt_content "constexpr std::array<DT_EmbeddedZone, ${dt_zoneCount}> dt_embeddedZones{{\n${dt_entries}}};\n")
+    set(dt_previous "")
+    if(EXISTS "${DT_OUTPUT}")
+        file(READ "${DT_OUTPUT}" dt_previous)
+    endif()
+    if(NOT dt_previous STREQUAL dt_content)
+        file(WRITE "${DT_OUTPUT}" "${dt_content}")
+    endif()
+endfunction()
@@ -1,3 +1,5 @@
+#pragma once
+
 #include <chrono>
 #include <ctime>
 #include <iomanip>
@@ -9,6 +11,14 @@
 #include <vector>
 #include <optional>
 #include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <string_view>
+#include <charconv>
+#include <array>
+#include <algorithm>
+#include <utility>
 
 // Define formatter for custom time type
 namespace std {
@@ -33,16 +43,167 @@ public:
     explicit DateTimeException(const std::string& dt_message) : std::runtime_error(dt_message) {}
 };
 
+// IANA time zone loaded from TZif data (datetime_zone.hpp)
+class DateTimeZone;
+
 class DateTime {
 public:
     // Structure representing region time information
     struct RegionTime {
-        std::string identifier;   // Region identifier (e.g., "JST", "UTC")
+        std::string identifier;   // Region identifier (e.g., "JST", "UTC", "America/New_York")
         int hourOffset;           // Hour offset from reference time
         int minuteOffset;         // Additional minute offset from reference time
+        // Time zone with DST rules; when set, the offset is resolved per instant and the
+        // fields above hold the zone's standard offset
+        std::shared_ptr<const DateTimeZone> zone;
+
+        RegionTime(const std::string& dt_regionId, int dt_hours, int dt_minutes = 0,
+                   std::shared_ptr<const DateTimeZone> dt_zone = nullptr)
+            : identifier(dt_regionId), hourOffset(dt_hours), minuteOffset(dt_minutes), zone(std::move(dt_zone)) {}
+    };
+
+    // Small integer handle for a region registered in the process-wide region registry.
+    // Handles are stable for the lifetime of the process; WorldTime is always handle 0.
+    enum class RegionHandle : std::uint32_t { World = 0 };
 
-        RegionTime(const std::string& dt_regionId, int dt_hours, int dt_minutes = 0)
-            : identifier(dt_regionId), hourOffset(dt_hours), minuteOffset(dt_minutes) {}
+    // Clock used by now()
+    enum class ClockSource {
+        Precise,  // std::chrono::system_clock
+        Coarse,   // CLOCK_REALTIME_COARSE where available (tick-resolution, a few ms), otherwise Precise
+        Tsc       // Invariant CPU timestamp counter, kept in step with system_clock (resynchronized every 0.5 s), otherwise Precise
+    };
+
+    // Calendar date (proleptic Gregorian)
+    struct CivilDate {
+        int year;
+        int month;  // 1-12
+        int day;    // 1-31
+    };
+
+    // All date and time components of an instant, decomposed in one pass
+    struct Fields {
+        int year;
+        int month;        // 1-12
+        int day;          // 1-31
+        int hour;         // 0-23
+        int minute;       // 0-59
+        int second;       // 0-59
+        int millisecond;  // 0-999
+        int nanosecond;   // 0-999999999 (full sub-second part, at the precision of the system clock)
+        int dayOfWeek;    // 0=Sunday, 6=Saturday
+        int dayOfYear;    // 1-366
+    };
+
+    // Operations of a compiled format pattern
+    enum class FormatOpCode : std::uint8_t {
+        Literal,           // Run of pattern text (offset/length into the pattern)
+        Char,              // Single character stored in offset (from %%, %n, %t and expansions like %F)
+        Year,              // %Y
+        Century,           // %C
+        YearOfCentury,     // %y
+        Month,             // %m
+        Day,               // %d
+        DaySpacePadded,    // %e
+        Hour,              // %H
+        Hour12,            // %I
+        Minute,            // %M
+        Second,            // %S
+        DayOfYear,         // %j
+        WeekdayNumber,     // %w (0=Sunday)
+        IsoWeekdayNumber,  // %u (7=Sunday)
+        WeekdayShort,      // %a
+        WeekdayFull,       // %A
+        MonthShort,        // %b, %h
+        MonthFull,         // %B
+        AmPm,              // %p
+        Fraction,          // %f, %1f-%9f (digit count stored in offset, length 3 for an explicit count)
+        RegionName,        // %Z (region identifier, or the zone abbreviation in effect)
+        RegionOffset,      // %z (+hhmm)
+        Strftime           // Any other conversion, delegated to std::strftime (offset/length of the spec)
+    };
+    
+    struct FormatOp {
+        FormatOpCode code;
+        std::uint16_t offset;
+        std::uint16_t length;
+    };
+    
+    // strftime-style pattern compiled once into a flat list of formatting operations.
+    // Names (%a, %b, %p, ...) use the C locale.
+    class FormatPattern {
+    public:
+        explicit FormatPattern(std::string_view dt_pattern);
+        
+        // Patterns of literal text, %Y, %C, %y, two-digit fields and fractions render at a fixed layout for
+        // years 0-9999: the output with the literal text already in place, then the digits of each field
+        // (codes Century, YearOfCentury, Month, Day, Hour, Minute, Second or Fraction)
+        struct LayoutField {
+            std::uint16_t position;
+            FormatOpCode code;
+            std::uint8_t width;  // 2, or the digit count of a Fraction
+        };
+        
+        const std::string& pattern() const { return dt_pattern; }
+        const std::vector<FormatOp>& operations() const { return dt_ops; }
+        const std::string& layout() const { return dt_layout; }  // Empty when the pattern has no fixed layout
+        const std::vector<LayoutField>& layoutFields() const { return dt_layoutFields; }
+        
+        // Compile a pattern, calling dt_sink(FormatOp) for each operation. Returns nullptr on success or
+        // an error message; with dt_strict, non-standard conversions and a trailing '%' are errors instead
+        // of falling back to strftime / literal text. Usable in constant expressions.
+        template <class Sink>
+        static constexpr const char* compile(std::string_view dt_pattern, Sink&& dt_sink, bool dt_strict = false);
+    
+    private:
+        std::string dt_pattern;
+        std::vector<FormatOp> dt_ops;
+        std::string dt_layout;
+        std::vector<LayoutField> dt_layoutFields;
+    };
+
+    // Units for floorTo/ceilTo bucketing (weeks start on Monday, as in ISO 8601)
+    enum class TimeUnit : std::uint8_t { Millisecond, Second, Minute, Hour, Day, Week, Month, Quarter, Year };
+
+    // Reasons a parse can fail (see parseErrorMessage)
+    enum class ParseError : std::uint8_t {
+        None,
+        UnexpectedEnd,        // Input ended before the pattern
+        ExpectedDigit,
+        ExpectedLiteral,      // Input does not match literal pattern text
+        UnknownName,          // Weekday, month or AM/PM name not recognized
+        FieldOutOfRange,      // Hour, minute, second or offset out of range
+        InvalidDate,          // Day does not exist in the month, or year outside 1900-9999
+        TrailingCharacters    // Input continues after the pattern
+    };
+    
+    // Whole: the entire input must be the timestamp. Prefix: parse a leading timestamp (e.g. of a log
+    // line) and report where it ended in ParseResult::position.
+    enum class ParseMode : std::uint8_t { Whole, Prefix };
+    
+    // Outcome of parse(string_view, ...) / parseIso8601: value is meaningful only when error is None,
+    // otherwise position is the offset of the input character where parsing failed
+    struct ParseResult;
+    
+    // Pattern for parse(), compiled once. Supports the toString conversions except %Z and strftime-only
+    // ones; whitespace matches any run of whitespace, %z accepts Z, +hh, +hhmm and +hh:mm.
+    // Throws DateTimeException for unsupported patterns.
+    class ParsePattern {
+    public:
+        explicit ParsePattern(std::string_view dt_pattern);
+        
+        const std::string& pattern() const { return dt_pattern; }
+        const std::vector<FormatOp>& operations() const { return dt_ops; }
+    
+    private:
+        std::string dt_pattern;
+        std::vector<FormatOp> dt_ops;
+    };
+    
+    // Layout options for the fixed-layout ISO-8601 emitter
+    struct IsoFormat {
+        bool basic = false;          // 20240301T120000+0900 instead of 2024-03-01T12:00:00+09:00
+        int fractionDigits = 0;      // Digits after the seconds (0-9)
+        bool utcDesignator = true;   // Write "Z" instead of a zero numeric offset
     };
 
     // Commonly used region time definitions
@@ -53,25 +214,51 @@ public:
     
     // Constructors
     DateTime();
-    explicit DateTime(const std::chrono::system_clock::time_point& dt_time);
-    // Constructor with region time specification
-    DateTime(int dt_year, int dt_month, int dt_day, int dt_hour = 0, int dt_minute = 0, int dt_second = 0, int dt_millisecond = 0, const RegionTime& dt_region=WorldTime);
+    constexpr explicit DateTime(const std::chrono::system_clock::time_point& dt_time);
+    // Constructor for UTC; usable in constant expressions, where an invalid date/time is a compile error
+    // (throws DateTimeException at runtime)
+    constexpr DateTime(int dt_year, int dt_month, int dt_day, int dt_hour = 0, int dt_minute = 0, int dt_second = 0, int dt_millisecond = 0);
+    // Constructor with region time specification (throws DateTimeException for an invalid date/time)
+    DateTime(int dt_year, int dt_month, int dt_day, int dt_hour, int dt_minute, int dt_second, int dt_millisecond, const RegionTime& dt_region);
+    // Constructors with a sub-second fraction at any precision, e.g. std::chrono::microseconds(250)
+    constexpr DateTime(int dt_year, int dt_month, int dt_day, int dt_hour, int dt_minute, int dt_second, std::chrono::nanoseconds dt_fraction);
+    DateTime(int dt_year, int dt_month, int dt_day, int dt_hour, int dt_minute, int dt_second, std::chrono::nanoseconds dt_fraction, const RegionTime& dt_region);
     DateTime(const std::chrono::system_clock::time_point& dt_time, const RegionTime& dt_region);
+    // Constructor with an interned region (handle must come from internRegion or getRegionHandle)
+    constexpr DateTime(const std::chrono::system_clock::time_point& dt_time, RegionHandle dt_regionHandle);
     
     // Get current time
     static std::shared_ptr<DateTime> current();
     static std::shared_ptr<DateTime> current(const RegionTime& dt_region);
     
+    // Get current time by value (no allocation) from the selected clock
+    static DateTime now(ClockSource dt_source = ClockSource::Precise);
+    static DateTime now(RegionHandle dt_regionHandle, ClockSource dt_source = ClockSource::Precise);
+    static DateTime now(const RegionTime& dt_region, ClockSource dt_source = ClockSource::Precise);
+    static std::chrono::system_clock::time_point nowTimePoint(ClockSource dt_source);
+    
     // Set date and time
     void setDate(int dt_year, int dt_month, int dt_day);
     void setTime(int dt_hour, int dt_minute, int dt_second, int dt_millisecond = 0);
+    void setTime(int dt_hour, int dt_minute, int dt_second, std::chrono::nanoseconds dt_fraction);
     
     // Set and get region time
     void setRegion(const RegionTime& dt_region);
     const RegionTime& getRegion() const;
+    RegionHandle getRegionHandle() const;
+    // Offset of the region from UTC at this instant
+    std::chrono::seconds getUtcOffset() const;
+    
+    // Region registry: intern a region (same contents yield the same handle) and resolve a handle.
+    // Handles are never freed, so every distinct region (identifier, offset and zone data) stays
+    // interned for the life of the process; a zone whose tzdata changed on reload gets a new handle.
+    // The registry grows as needed (lock-free lookups cover the first 4096 regions).
+    static RegionHandle internRegion(const RegionTime& dt_region);
+    static const RegionTime& regionFromHandle(RegionHandle dt_regionHandle);
     
     // Get datetime in a different region time
     DateTime convertToRegion(const RegionTime& dt_targetRegion) const;
+    DateTime convertToRegion(RegionHandle dt_targetRegion) const;
     
     // Get date and time components
     int getYear() const;
@@ -81,63 +268,584 @@ public:
     int getMinute() const;
     int getSecond() const;
     int getMillisecond() const;
+    int getMicrosecond() const; // 0-999999
+    int getNanosecond() const;  // 0-999999999
     int getDayOfWeek() const; // Get day of week (0=Sunday, 6=Saturday)
     
+    // Sub-second part and time point truncated to the requested precision
+    // (e.g. getFraction<std::chrono::microseconds>(), getTimePoint<std::chrono::seconds>())
+    template <class Precision = std::chrono::milliseconds>
+    constexpr Precision getFraction() const;
+    template <class Precision>
+    constexpr std::chrono::time_point<std::chrono::system_clock, Precision> getTimePoint() const;
+    
+    // Get all components at once (single decomposition in the region time)
+    Fields fields() const;
+    
+    // Opt-in memoization of the last decomposition per thread, so repeated getter
+    // calls for the same instant skip the calendar computation (disabled by default)
+    static void setFieldCaching(bool dt_enabled);
+    static bool isFieldCachingEnabled();
+    
     // Date and time arithmetic
     DateTime plusYears(int dt_years) const;
     DateTime plusMonths(int dt_months) const;
-    DateTime plusDays(int dt_days) const;
-    DateTime plusHours(int dt_hours) const;
-    DateTime plusMinutes(int dt_minutes) const;
-    DateTime plusSeconds(int dt_seconds) const;
-    DateTime plusMilliseconds(int dt_milliseconds) const;
+    constexpr DateTime plusDays(int dt_days) const;
+    constexpr DateTime plusHours(int dt_hours) const;
+    constexpr DateTime plusMinutes(int dt_minutes) const;
+    constexpr DateTime plusSeconds(int dt_seconds) const;
+    constexpr DateTime plusMilliseconds(int dt_milliseconds) const;
+    constexpr DateTime plusMicroseconds(long long dt_microseconds) const;
+    constexpr DateTime plusNanoseconds(long long dt_nanoseconds) const;
+    template <class Rep, class Period>
+    constexpr DateTime plus(std::chrono::duration<Rep, Period> dt_duration) const;
+    
+    // Start of the unit containing this instant in local time (floorTo), or the first unit boundary
+    // at or after it (ceilTo). The result keeps the region; the overloads with a region bucket in
+    // that region's local time and return an instant in it.
+    DateTime floorTo(TimeUnit dt_unit) const;
+    DateTime floorTo(TimeUnit dt_unit, RegionHandle dt_region) const;
+    DateTime ceilTo(TimeUnit dt_unit) const;
+    DateTime ceilTo(TimeUnit dt_unit, RegionHandle dt_region) const;
+    // Batch bucket keys for group-by: dt_out[i] is floorTo/ceilTo of dt_epochMilliseconds[i] in the
+    // local time of dt_region, as epoch milliseconds. Fixed-size units use integer division;
+    // months, quarters and years use a cached table of month boundaries. Zone regions bucket each
+    // value at its own UTC offset. dt_out may alias the input.
+    static void floorTo(const std::int64_t* dt_epochMilliseconds, std::size_t dt_count, TimeUnit dt_unit,
+                        RegionHandle dt_region, std::int64_t* dt_out);
+    static void ceilTo(const std::int64_t* dt_epochMilliseconds, std::size_t dt_count, TimeUnit dt_unit,
+                       RegionHandle dt_region, std::int64_t* dt_out);
     
     // Comparison operators
-    bool operator==(const DateTime& dt_other) const;
-    bool operator!=(const DateTime& dt_other) const;
-    bool operator<(const DateTime& dt_other) const;
-    bool operator<=(const DateTime& dt_other) const;
-    bool operator>(const DateTime& dt_other) const;
-    bool operator>=(const DateTime& dt_other) const;
-    
-    // Formatting
+    constexpr bool operator==(const DateTime& dt_other) const;
+    constexpr bool operator!=(const DateTime& dt_other) const;
+    constexpr bool operator<(const DateTime& dt_other) const;
+    constexpr bool operator<=(const DateTime& dt_other) const;
+    constexpr bool operator>(const DateTime& dt_other) const;
+    constexpr bool operator>=(const DateTime& dt_other) const;
+    
+    // Formatting (strftime-style; additionally %f is the millisecond fraction and %1f-%9f
+    // the fraction with that many digits, e.g. "%H:%M:%S.%6f")
     std::string toString(const std::string& dt_format = "%Y-%m-%d %H:%M:%S") const;
+    // Formatting with a pre-compiled pattern (no pattern parsing, no streams)
+    std::string toString(const FormatPattern& dt_pattern) const;
+    // Allocation-free formatting into a caller buffer. On success ptr is the end of the output; if the
+    // buffer is too small ec is std::errc::value_too_large and ptr == dt_last
+    std::to_chars_result formatTo(char* dt_first, char* dt_last, const FormatPattern& dt_pattern) const;
+    std::to_chars_result formatTo(char* dt_first, char* dt_last, std::string_view dt_pattern) const;
+    // Allocation-free formatting into an output iterator (patterns over 65535 characters produce nothing)
+    template <class OutputIt>
+    OutputIt formatTo(OutputIt dt_out, const FormatPattern& dt_pattern) const;
+    template <class OutputIt>
+    OutputIt formatTo(OutputIt dt_out, std::string_view dt_pattern) const;
+    // Upper bound of the formatted length for any instant in any interned region
+    static std::size_t maxFormattedSize(const FormatPattern& dt_pattern);
+    static std::size_t maxFormattedSize(std::string_view dt_pattern);
+    
+    // Render one compiled operation for this instant's fields. Literal runs and %Z are returned as views
+    // of the pattern / region identifier; everything else is written to dt_buffer, which must hold
+    // MaxOperationSize characters.
+    static constexpr std::size_t MaxOperationSize = 64;
+    std::string_view formatOperation(const FormatOp& dt_op, std::string_view dt_pattern, const Fields& dt_fields,
+                                     char* dt_buffer) const;
+    
+    // Fixed-layout standard formats in the DateTime's region. The to* versions return a string, the
+    // format* versions write into a caller buffer like formatTo (MaxStandardFormatSize always fits).
+    //   ISO-8601:  2024-03-01T12:00:00.123+09:00 (extended) or 20240301T120000.123+0900 (basic)
+    //   RFC 3339:  ISO-8601 extended with "Z" for UTC
+    //   RFC 1123:  Fri, 01 Mar 2024 12:00:00 +0900 ("GMT" for zero offsets)
+    static constexpr std::size_t MaxStandardFormatSize = 48;
+    std::string toIso8601() const;
+    std::string toIso8601(const IsoFormat& dt_options) const;
+    std::string toRfc3339(int dt_fractionDigits = 0) const;
+    std::string toRfc1123() const;
+    std::to_chars_result formatIso8601(char* dt_first, char* dt_last) const;
+    std::to_chars_result formatIso8601(char* dt_first, char* dt_last, const IsoFormat& dt_options) const;
+    std::to_chars_result formatRfc3339(char* dt_first, char* dt_last, int dt_fractionDigits = 0) const;
+    std::to_chars_result formatRfc1123(char* dt_first, char* dt_last) const;
+    
     // Formatting with region time information
     std::string toStringWithRegion(const std::string& dt_format = "%Y-%m-%d %H:%M:%S %Z") const;
     
-    // String formatting using C++20 features
+    // String formatting using C++20 features: a std::format string with this DateTime as the only
+    // argument (e.g. "at {:%H:%M}", or "{0:%F} {0:%T}" to use it twice); a pattern without braces is
+    // formatted like toString()
     std::string formatString(std::string_view dt_fmt) const;
     
     // Get the difference between two datetimes
-    static std::chrono::seconds timeBetween(const DateTime& dt_dt1, const DateTime& dt_dt2);
+    static constexpr std::chrono::seconds timeBetween(const DateTime& dt_dt1, const DateTime& dt_dt2);
     
     // Get internal time point
-    std::chrono::system_clock::time_point getSystemTime() const;
+    constexpr std::chrono::system_clock::time_point getSystemTime() const;
 
     // Date and time validity verification methods
-    static bool isValidDate(int dt_year, int dt_month, int dt_day);
-    static bool isValidTime(int dt_hour, int dt_minute, int dt_second, int dt_millisecond);
+    static constexpr bool isValidDate(int dt_year, int dt_month, int dt_day);
+    static constexpr bool isValidTime(int dt_hour, int dt_minute, int dt_second, int dt_millisecond);
+    static constexpr bool isValidTime(int dt_hour, int dt_minute, int dt_second, std::chrono::nanoseconds dt_fraction);
+    
+    // Integer civil calendar kernel (days counted from 1970-01-01), usable in constant expressions.
+    // daysFromCivil accepts out-of-range months/days and normalizes them like timegm.
+    static constexpr std::int64_t daysFromCivil(std::int64_t dt_year, int dt_month, int dt_day);
+    static constexpr CivilDate civilFromDays(std::int64_t dt_days);
+    static constexpr bool isLeapYear(std::int64_t dt_year);
+    static constexpr int daysInMonth(std::int64_t dt_year, int dt_month);
+    // Division rounding toward negative infinity (for instants before the epoch); dt_divisor > 0
+    static constexpr std::int64_t floorDiv(std::int64_t dt_value, std::int64_t dt_divisor);
 
-    // Get timezone information from TZDB (C++20)
+    // IANA zone (e.g. "America/New_York") from the TZif database, or a POSIX TZ string such as
+    // "EST5EDT,M3.2.0,M11.1.0" (see DateTimeZone::load); nullopt if neither applies
     static std::optional<RegionTime> getRegionFromTZDB(const std::string& dt_tzName);
     
-    // Parse datetime from string (enhanced error handling)
+    // Parse datetime from string (enhanced error handling); %f accepts 1-9 fraction digits, %Nf exactly N.
+    // Text after the pattern is ignored.
     static std::optional<DateTime> parse(const std::string& dt_dateString, 
                                        const std::string& dt_format = "%Y-%m-%d %H:%M:%S");
+    // Allocation-free parsing with a compiled pattern. Instants with a parsed %z offset are returned in UTC.
+    static ParseResult parse(std::string_view dt_input, const ParsePattern& dt_pattern,
+                             ParseMode dt_mode = ParseMode::Whole);
+    // ISO-8601 / RFC 3339 fast path: YYYY-MM-DD, optionally followed by T (or t or a space) and
+    // hh:mm:ss[.fraction][Z|+hh:mm|+hhmm|+hh]; the basic form (YYYYMMDDThhmmss...) is also accepted
+    static ParseResult parseIso8601(std::string_view dt_input, ParseMode dt_mode = ParseMode::Whole);
+    static const char* parseErrorMessage(ParseError dt_error);
 
 private:
     std::chrono::system_clock::time_point dt_clockPoint;
-    RegionTime dt_timeRegion{WorldTime};  // Default is world time (UTC)
+    RegionHandle dt_regionHandle{RegionHandle::World};  // Default is world time (UTC)
     
     // Static mutex for thread-safe processing (moved from global variable)
     static std::mutex dt_timeMutex;
     
+    // Whether getters memoize their decomposition (see setFieldCaching)
+    static std::atomic<bool> dt_fieldCaching;
+    
     // Helper function to get time adjusted for region
     std::tm getRegionAdjustedTime() const;
+    
+    // Region time offset in seconds at this instant
+    std::int64_t getRegionOffsetSeconds() const;
+    // Offset to subtract from region-local seconds to get UTC (see DateTimeZone::offsetForLocal)
+    std::int64_t getRegionOffsetSecondsForLocal(std::int64_t dt_localSeconds) const;
+    
+    // Build a UTC time point from region-local fields and the region offset in seconds
+    static constexpr std::chrono::system_clock::time_point composeTimePoint(int dt_year, int dt_month, int dt_day,
+        int dt_hour, int dt_minute, int dt_second, std::chrono::nanoseconds dt_fraction, std::int64_t dt_offsetSeconds);
+    
+    [[noreturn]] static void throwInvalidDateTime(int dt_year, int dt_month, int dt_day,
+                                                  int dt_hour, int dt_minute, int dt_second, std::chrono::nanoseconds dt_fraction);
 
     // Thread-safe time retrieval function
     std::tm getThreadSafeTime(const std::time_t& dt_timeValue, bool dt_useLocalTime) const;
     
     // Helper function for timezone offset calculation (eliminate code duplication)
     std::time_t getLocalTimeOffset() const;
-};
\ No newline at end of file
+};
+
+// constexpr members are defined in the header so that they can be evaluated at compile time
+
+constexpr std::int64_t DateTime::floorDiv(std::int64_t dt_value, std::int64_t dt_divisor) {
+    return (dt_value >= 0 ? dt_value : dt_value - dt_divisor + 1) / dt_divisor;
+}
+
+// Based on Howard Hinnant's days_from_civil algorithm
+constexpr std::int64_t DateTime::daysFromCivil(std::int64_t dt_year, int dt_month, int dt_day) {
+    // Normalize month into [1, 12] first
+    std::int64_t dt_monthIndex = dt_month - 1;
+    dt_year += floorDiv(dt_monthIndex, 12);
+    dt_monthIndex -= floorDiv(dt_monthIndex, 12) * 12;
+    
+    // Shift to a March-based year so that the leap day is the last day of the year
+    dt_year -= dt_monthIndex < 2;
+    const std::int64_t dt_era = floorDiv(dt_year, 400);
+    const std::int64_t dt_yearOfEra = dt_year - dt_era * 400;                          // [0, 399]
+    const std::int64_t dt_marchMonth = (dt_monthIndex + 10) % 12;                     // [0, 11]
+    const std::int64_t dt_dayOfYear = (153 * dt_marchMonth + 2) / 5 + dt_day - 1;     // [0, 365]
+    const std::int64_t dt_dayOfEra = dt_yearOfEra * 365 + dt_yearOfEra / 4 - dt_yearOfEra / 100 + dt_dayOfYear;
+    return dt_era * 146097 + dt_dayOfEra - 719468;
+}
+
+// Based on Howard Hinnant's civil_from_days algorithm
+constexpr DateTime::CivilDate DateTime::civilFromDays(std::int64_t dt_days) {
+    dt_days += 719468;
+    const std::int64_t dt_era = floorDiv(dt_days, 146097);
+    const std::int64_t dt_dayOfEra = dt_days - dt_era * 146097;                       // [0, 146096]
+    const std::int64_t dt_yearOfEra = (dt_dayOfEra - dt_dayOfEra / 1460 + dt_dayOfEra / 36524 - dt_dayOfEra / 146096) / 365;
+    const std::int64_t dt_dayOfYear = dt_dayOfEra - (365 * dt_yearOfEra + dt_yearOfEra / 4 - dt_yearOfEra / 100);
+    const std::int64_t dt_marchMonth = (5 * dt_dayOfYear + 2) / 153;                  // [0, 11]
+    
+    CivilDate dt_date{};
+    dt_date.day = static_cast<int>(dt_dayOfYear - (153 * dt_marchMonth + 2) / 5 + 1);
+    dt_date.month = static_cast<int>(dt_marchMonth < 10 ? dt_marchMonth + 3 : dt_marchMonth - 9);
+    dt_date.year = static_cast<int>(dt_yearOfEra + dt_era * 400 + (dt_date.month <= 2));
+    return dt_date;
+}
+
+constexpr bool DateTime::isLeapYear(std::int64_t dt_year) {
+    return (dt_year % 4 == 0) && ((dt_year % 100 != 0) || (dt_year % 400 == 0));
+}
+
+constexpr int DateTime::daysInMonth(std::int64_t dt_year, int dt_month) {
+    constexpr int dt_daysPerMonth[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return (dt_month == 2 && isLeapYear(dt_year)) ? 29 : dt_daysPerMonth[dt_month - 1];
+}
+
+// Date validity verification function
+constexpr bool DateTime::isValidDate(int dt_year, int dt_month, int dt_day) {
+    if (dt_month < 1 || dt_month > 12 || dt_day < 1)
+        return false;
+    if (dt_year < 1900 || dt_year > 9999)
+        return false;
+    return dt_day <= daysInMonth(dt_year, dt_month);
+}
+
+constexpr bool DateTime::isValidTime(int dt_hour, int dt_minute, int dt_second, int dt_millisecond) {
+    return dt_hour >= 0 && dt_hour < 24 &&
+           dt_minute >= 0 && dt_minute < 60 &&
+           dt_second >= 0 && dt_second < 60 &&
+           dt_millisecond >= 0 && dt_millisecond < 1000;
+}
+
+constexpr bool DateTime::isValidTime(int dt_hour, int dt_minute, int dt_second, std::chrono::nanoseconds dt_fraction) {
+    return isValidTime(dt_hour, dt_minute, dt_second, 0) &&
+           dt_fraction >= std::chrono::nanoseconds::zero() && dt_fraction < std::chrono::seconds(1);
+}
+
+constexpr std::chrono::system_clock::time_point DateTime::composeTimePoint(int dt_year, int dt_month, int dt_day,
+    int dt_hour, int dt_minute, int dt_second, std::chrono::nanoseconds dt_fraction, std::int64_t dt_offsetSeconds) {
+    const std::int64_t dt_seconds = daysFromCivil(dt_year, dt_month, dt_day) * 86400 +
+                                    dt_hour * std::int64_t{3600} + dt_minute * std::int64_t{60} + dt_second -
+                                    dt_offsetSeconds;
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::seconds(dt_seconds) + dt_fraction));
+}
+
+constexpr DateTime::DateTime(const std::chrono::system_clock::time_point& dt_time)
+    : dt_clockPoint(dt_time), dt_regionHandle(RegionHandle::World) {}
+
+constexpr DateTime::DateTime(int dt_year, int dt_month, int dt_day,
+                             int dt_hour, int dt_minute, int dt_second, int dt_millisecond)
+    : DateTime(dt_year, dt_month, dt_day, dt_hour, dt_minute, dt_second,
+               std::chrono::nanoseconds(std::chrono::milliseconds(dt_millisecond))) {}
+
+constexpr DateTime::DateTime(int dt_year, int dt_month, int dt_day,
+                             int dt_hour, int dt_minute, int dt_second, std::chrono::nanoseconds dt_fraction)
+    : dt_clockPoint(composeTimePoint(dt_year, dt_month, dt_day, dt_hour, dt_minute, dt_second, dt_fraction, 0)),
+      dt_regionHandle(RegionHandle::World)
+{
+    // Reaching the throw during constant evaluation makes an invalid constant date a compile error
+    if (!isValidDate(dt_year, dt_month, dt_day) || !isValidTime(dt_hour, dt_minute, dt_second, dt_fraction)) {
+        throwInvalidDateTime(dt_year, dt_month, dt_day, dt_hour, dt_minute, dt_second, dt_fraction);
+    }
+}
+
+constexpr DateTime::DateTime(const std::chrono::system_clock::time_point& dt_time, RegionHandle dt_regionHandle)
+    : dt_clockPoint(dt_time), dt_regionHandle(dt_regionHandle) {}
+
+constexpr DateTime DateTime::plusDays(int dt_days) const {
+    return DateTime(dt_clockPoint + std::chrono::hours(24 * static_cast<std::int64_t>(dt_days)), dt_regionHandle);
+}
+
+constexpr DateTime DateTime::plusHours(int dt_hours) const {
+    return DateTime(dt_clockPoint + std::chrono::hours(dt_hours), dt_regionHandle);
+}
+
+constexpr DateTime DateTime::plusMinutes(int dt_minutes) const {
+    return DateTime(dt_clockPoint + std::chrono::minutes(dt_minutes), dt_regionHandle);
+}
+
+constexpr DateTime DateTime::plusSeconds(int dt_seconds) const {
+    return DateTime(dt_clockPoint + std::chrono::seconds(dt_seconds), dt_regionHandle);
+}
+
+constexpr DateTime DateTime::plusMilliseconds(int dt_milliseconds) const {
+    return DateTime(dt_clockPoint + std::chrono::milliseconds(dt_milliseconds), dt_regionHandle);
+}
+
+constexpr DateTime DateTime::plusMicroseconds(long long dt_microseconds) const {
+    return plus(std::chrono::microseconds(dt_microseconds));
+}
+
+constexpr DateTime DateTime::plusNanoseconds(long long dt_nanoseconds) const {
+    return plus(std::chrono::nanoseconds(dt_nanoseconds));
+}
+
+template <class Rep, class Period>
+constexpr DateTime DateTime::plus(std::chrono::duration<Rep, Period> dt_duration) const {
+    return DateTime(dt_clockPoint + std::chrono::duration_cast<std::chrono::system_clock::duration>(dt_duration),
+                    dt_regionHandle);
+}
+
+template <class Precision>
+constexpr Precision DateTime::getFraction() const {
+    const auto dt_sinceEpoch = dt_clockPoint.time_since_epoch();
+    return std::chrono::floor<Precision>(dt_sinceEpoch - std::chrono::floor<std::chrono::seconds>(dt_sinceEpoch));
+}
+
+template <class Precision>
+constexpr std::chrono::time_point<std::chrono::system_clock, Precision> DateTime::getTimePoint() const {
+    return std::chrono::floor<Precision>(dt_clockPoint);
+}
+
+constexpr bool DateTime::operator==(const DateTime& dt_other) const {
+    return dt_clockPoint == dt_other.dt_clockPoint;
+}
+
+constexpr bool DateTime::operator!=(const DateTime& dt_other) const {
+    return dt_clockPoint != dt_other.dt_clockPoint;
+}
+
+constexpr bool DateTime::operator<(const DateTime& dt_other) const {
+    return dt_clockPoint < dt_other.dt_clockPoint;
+}
+
+constexpr bool DateTime::operator<=(const DateTime& dt_other) const {
+    return dt_clockPoint <= dt_other.dt_clockPoint;
+}
+
+constexpr bool DateTime::operator>(const DateTime& dt_other) const {
+    return dt_clockPoint > dt_other.dt_clockPoint;
+}
+
+constexpr bool DateTime::operator>=(const DateTime& dt_other) const {
+    return dt_clockPoint >= dt_other.dt_clockPoint;
+}
+
+constexpr std::chrono::seconds DateTime::timeBetween(const DateTime& dt_dt1, const DateTime& dt_dt2) {
+    // Take the difference between time_points directly, cast to seconds
+    return std::chrono::duration_cast<std::chrono::seconds>(dt_dt2.dt_clockPoint - dt_dt1.dt_clockPoint);
+}
+
+constexpr std::chrono::system_clock::time_point DateTime::getSystemTime() const {
+    return dt_clockPoint;
+}
+
+template <class OutputIt>
+OutputIt DateTime::formatTo(OutputIt dt_out, const FormatPattern& dt_pattern) const {
+    const Fields dt_fields = fields();
+    char dt_buffer[MaxOperationSize];
+    for (const FormatOp& dt_op : dt_pattern.operations()) {
+        const std::string_view dt_piece = formatOperation(dt_op, dt_pattern.pattern(), dt_fields, dt_buffer);
+        dt_out = std::copy(dt_piece.begin(), dt_piece.end(), dt_out);
+    }
+    return dt_out;
+}
+
+template <class OutputIt>
+OutputIt DateTime::formatTo(OutputIt dt_out, std::string_view dt_pattern) const {
+    // Render each operation as it is compiled, so no operation list is materialized
+    const Fields dt_fields = fields();
+    char dt_buffer[MaxOperationSize];
+    FormatPattern::compile(dt_pattern, [&](const FormatOp& dt_op) {
+        const std::string_view dt_piece = formatOperation(dt_op, dt_pattern, dt_fields, dt_buffer);
+        dt_out = std::copy(dt_piece.begin(), dt_piece.end(), dt_out);
+    });
+    return dt_out;
+}
+
+template <class Sink>
+constexpr const char* DateTime::FormatPattern::compile(std::string_view dt_pattern, Sink&& dt_sink, bool dt_strict) {
+    if (dt_pattern.size() > 0xFFFF) {
+        return "format pattern is too long";
+    }
+    
+    auto dt_emit = [&dt_sink](FormatOpCode dt_code, std::size_t dt_offset = 0, std::size_t dt_length = 0) {
+        dt_sink(FormatOp{dt_code, static_cast<std::uint16_t>(dt_offset), static_cast<std::uint16_t>(dt_length)});
+    };
+    auto dt_emitChar = [&dt_emit](char dt_char) {
+        dt_emit(FormatOpCode::Char, static_cast<unsigned char>(dt_char));
+    };
+    
+    std::size_t dt_literalStart = 0;
+    std::size_t dt_pos = 0;
+    while (dt_pos < dt_pattern.size()) {
+        if (dt_pattern[dt_pos] != '%') {
+            ++dt_pos;
+            continue;
+        }
+        if (dt_pos > dt_literalStart) {
+            dt_emit(FormatOpCode::Literal, dt_literalStart, dt_pos - dt_literalStart);
+        }
+        if (dt_pos + 1 >= dt_pattern.size()) {
+            if (dt_strict) {
+                return "format pattern ends with '%'";
+            }
+            dt_literalStart = dt_pos;
+            dt_pos = dt_pattern.size();
+            break;
+        }
+        
+        const char dt_spec = dt_pattern[dt_pos + 1];
+        std::size_t dt_specLength = 2;
+        switch (dt_spec) {
+            case 'Y': dt_emit(FormatOpCode::Year); break;
+            case 'C': dt_emit(FormatOpCode::Century); break;
+            case 'y': dt_emit(FormatOpCode::YearOfCentury); break;
+            case 'm': dt_emit(FormatOpCode::Month); break;
+            case 'd': dt_emit(FormatOpCode::Day); break;
+            case 'e': dt_emit(FormatOpCode::DaySpacePadded); break;
+            case 'H': dt_emit(FormatOpCode::Hour); break;
+            case 'I': dt_emit(FormatOpCode::Hour12); break;
+            case 'M': dt_emit(FormatOpCode::Minute); break;
+            case 'S': dt_emit(FormatOpCode::Second); break;
+            case 'j': dt_emit(FormatOpCode::DayOfYear); break;
+            case 'w': dt_emit(FormatOpCode::WeekdayNumber); break;
+            case 'u': dt_emit(FormatOpCode::IsoWeekdayNumber); break;
+            case 'a': dt_emit(FormatOpCode::WeekdayShort); break;
+            case 'A': dt_emit(FormatOpCode::WeekdayFull); break;
+            case 'b':
+            case 'h': dt_emit(FormatOpCode::MonthShort); break;
+            case 'B': dt_emit(FormatOpCode::MonthFull); break;
+            case 'p': dt_emit(FormatOpCode::AmPm); break;
+            case 'f': dt_emit(FormatOpCode::Fraction, 3, 2); break;
+            case 'Z': dt_emit(FormatOpCode::RegionName); break;
+            case 'z': dt_emit(FormatOpCode::RegionOffset); break;
+            case '%': dt_emitChar('%'); break;
+            case 'n': dt_emitChar('\n'); break;
+            case 't': dt_emitChar('\t'); break;
+            case 'F':
+                dt_emit(FormatOpCode::Year); dt_emitChar('-');
+                dt_emit(FormatOpCode::Month); dt_emitChar('-');
+                dt_emit(FormatOpCode::Day);
+                break;
+            case 'T':
+                dt_emit(FormatOpCode::Hour); dt_emitChar(':');
+                dt_emit(FormatOpCode::Minute); dt_emitChar(':');
+                dt_emit(FormatOpCode::Second);
+                break;
+            case 'R':
+                dt_emit(FormatOpCode::Hour); dt_emitChar(':');
+                dt_emit(FormatOpCode::Minute);
+                break;
+            case 'D':
+                dt_emit(FormatOpCode::Month); dt_emitChar('/');
+                dt_emit(FormatOpCode::Day); dt_emitChar('/');
+                dt_emit(FormatOpCode::YearOfCentury);
+                break;
+            case 'r':
+                dt_emit(FormatOpCode::Hour12); dt_emitChar(':');
+                dt_emit(FormatOpCode::Minute); dt_emitChar(':');
+                dt_emit(FormatOpCode::Second); dt_emitChar(' ');
+                dt_emit(FormatOpCode::AmPm);
+                break;
+            default:
+                if (dt_spec >= '1' && dt_spec <= '9' && dt_pos + 2 < dt_pattern.size() && dt_pattern[dt_pos + 2] == 'f') {
+                    dt_emit(FormatOpCode::Fraction, static_cast<std::size_t>(dt_spec - '0'), 3);
+                    dt_specLength = 3;
+                    break;
+                }
+                // E and O modifiers take one more character
+                if ((dt_spec == 'E' || dt_spec == 'O') && dt_pos + 2 < dt_pattern.size()) {
+                    dt_specLength = 3;
+                }
+                if (dt_strict) {
+                    // Only standard strftime conversions may fall back to strftime
+                    const std::string_view dt_allowed = dt_specLength == 3
+                        ? (dt_spec == 'E' ? std::string_view("cCxXyY") : std::string_view("deHImMSuUVwWy"))
+                        : std::string_view("cgGUVWxX");
+                    if (dt_allowed.find(dt_pattern[dt_pos + dt_specLength - 1]) == std::string_view::npos) {
+                        return "unsupported conversion specifier in format pattern";
+                    }
+                }
+                dt_emit(FormatOpCode::Strftime, dt_pos, dt_specLength);
+                break;
+        }
+        dt_pos += dt_specLength;
+        dt_literalStart = dt_pos;
+    }
+    if (dt_literalStart < dt_pattern.size()) {
+        dt_emit(FormatOpCode::Literal, dt_literalStart, dt_pattern.size() - dt_literalStart);
+    }
+    return nullptr;
+}
+
+struct DateTime::ParseResult {
+    DateTime value;
+    ParseError error;
+    std::size_t position;
+    
+    explicit operator bool() const { return error == ParseError::None; }
+};
+
+// std::format support: std::format("{:%F %T.%3f %Z}", dt). The spec uses toString syntax and is
+// compiled by parse(), so with std::format_string an invalid spec is a compile error.
+// An empty spec formats as "%Y-%m-%d %H:%M:%S".
+namespace std {
+    template<>
+    struct formatter<DateTime> {
+        // Maximum number of operations a spec may compile to
+        static constexpr std::size_t dt_maxOperations = 64;
+        
+        std::array<DateTime::FormatOp, dt_maxOperations> dt_operations{};
+        std::size_t dt_operationCount = 0;
+        std::string_view dt_pattern;  // Refers into the format string, which outlives the format call
+        
+        constexpr format_parse_context::iterator parse(format_parse_context& dt_ctx) {
+            auto dt_it = dt_ctx.begin();
+            auto dt_end = dt_it;
+            while (dt_end != dt_ctx.end() && *dt_end != '}') {
+                if (*dt_end == '{') {
+                    throw format_error("invalid '{' in DateTime format spec");
+                }
+                ++dt_end;
+            }
+            dt_pattern = dt_it == dt_end ? std::string_view("%Y-%m-%d %H:%M:%S")
+                                         : std::string_view(&*dt_it, static_cast<std::size_t>(dt_end - dt_it));
+            
+            bool dt_overflow = false;
+            const char* dt_error = DateTime::FormatPattern::compile(dt_pattern, [this, &dt_overflow](const DateTime::FormatOp& dt_op) {
+                if (dt_operationCount == dt_maxOperations) {
+                    dt_overflow = true;
+                    return;
+                }
+                dt_operations[dt_operationCount++] = dt_op;
+            }, true);
+            if (dt_error != nullptr) {
+                throw format_error(dt_error);
+            }
+            if (dt_overflow) {
+                throw format_error("DateTime format spec has too many fields");
+            }
+            return dt_end;
+        }
+        
+        template <class FormatContext>
+        auto format(const DateTime& dt_value, FormatContext& dt_ctx) const {
+            const DateTime::Fields dt_fields = dt_value.fields();
+            char dt_buffer[DateTime::MaxOperationSize];
+            auto dt_out = dt_ctx.out();
+            for (std::size_t dt_index = 0; dt_index < dt_operationCount; ++dt_index) {
+                const std::string_view dt_piece = dt_value.formatOperation(dt_operations[dt_index], dt_pattern, dt_fields, dt_buffer);
+                dt_out = std::copy(dt_piece.begin(), dt_piece.end(), dt_out);
+            }
+            return dt_out;
+        }
+    };
+}
+
+// User-defined literals for constant dates: 2024_y/3/1 is 2024-03-01 00:00:00 UTC
+namespace datetime_literals {
+    struct YearLiteral {
+        int year;
+    };
+    
+    struct YearMonthLiteral {
+        int year;
+        int month;
+    };
+    
+    constexpr YearLiteral operator""_y(unsigned long long dt_year) {
+        return YearLiteral{static_cast<int>(dt_year)};
+    }
+    
+    constexpr YearMonthLiteral operator/(YearLiteral dt_year, int dt_month) {
+        return YearMonthLiteral{dt_year.year, dt_month};
+    }
+    
+    constexpr DateTime operator/(YearMonthLiteral dt_yearMonth, int dt_day) {
+        return DateTime(dt_yearMonth.year, dt_yearMonth.month, dt_day);
+    }
+}
+
+// DateTime is a plain value (time point + region handle) so it can be stored densely and copied with memcpy
+static_assert(std::is_trivially_copyable_v<DateTime>, "DateTime must stay trivially copyable");
+static_assert(sizeof(DateTime) <= 16, "DateTime must stay 16 bytes or smaller");
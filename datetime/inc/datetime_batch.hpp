@@ -0,0 +1,88 @@
+#pragma once
+
+#include "datetime.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
+
+class DateTimeColumn;
+
+// Bulk conversion of fixed-width timestamp columns (CSV / staging files) to epoch milliseconds.
+// Rows are validated and converted with SSE4.2 or AVX2 when the CPU supports them (selected at
+// runtime), with a portable scalar fallback.
+class DateTimeBatchParser {
+public:
+    // Supported fixed layouts (UTC; the date/time separator may be ' ' or 'T')
+    enum class Layout {
+        Seconds,        // YYYY-MM-DD HH:MM:SS      (19 characters)
+        Milliseconds    // YYYY-MM-DD HH:MM:SS.mmm  (23 characters)
+    };
+
+    // Instruction set used for a batch; Auto picks the best one the CPU supports
+    enum class Isa { Auto, Scalar, Sse42, Avx2 };
+
+    // Value written for malformed rows
+    static constexpr std::int64_t InvalidTimestamp = std::numeric_limits<std::int64_t>::min();
+
+    static constexpr std::size_t rowLength(Layout dt_layout) {
+        return dt_layout == Layout::Seconds ? 19 : 23;
+    }
+
+    // Best instruction set available on this CPU
+    static Isa supportedIsa();
+
+    // Parse dt_count rows, row i starting at dt_data + i * dt_stride, into dt_out[i] (epoch milliseconds).
+    // Malformed rows (bad digits/separators or out-of-range fields) get InvalidTimestamp and their
+    // indices are appended to dt_malformedRows when given. Returns the number of malformed rows.
+    // A requested Isa the CPU lacks falls back to the best supported one.
+    static std::size_t parse(const char* dt_data, std::size_t dt_count, std::size_t dt_stride, Layout dt_layout,
+                             std::int64_t* dt_out, std::vector<std::size_t>* dt_malformedRows = nullptr,
+                             Isa dt_isa = Isa::Auto);
+
+    // Same, with row i starting at dt_data + dt_offsets[i]
+    static std::size_t parse(const char* dt_data, const std::size_t* dt_offsets, std::size_t dt_count, Layout dt_layout,
+                             std::int64_t* dt_out, std::vector<std::size_t>* dt_malformedRows = nullptr,
+                             Isa dt_isa = Isa::Auto);
+};
+
+// Renders a batch of instants with one compiled pattern into a single contiguous arena plus an
+// offsets array (Arrow large-string layout: row i is arena[offsets[i], offsets[i + 1])). The
+// buffers are reused across batches. For fixed-width patterns the exact batch size is reserved
+// up front and every row is written in place without reallocation. Not thread-safe.
+class DateTimeBatchFormatter {
+public:
+    explicit DateTimeBatchFormatter(std::string_view dt_pattern = "%Y-%m-%d %H:%M:%S");
+
+    // Render a batch, replacing the previous one; returns the number of rows
+    std::size_t format(std::span<const DateTime> dt_values);
+    std::size_t format(const std::int64_t* dt_epochMilliseconds, std::size_t dt_count,
+                       DateTime::RegionHandle dt_region = DateTime::RegionHandle::World);
+    std::size_t format(const DateTimeColumn& dt_column);
+
+    std::size_t size() const { return dt_offsets.size() - 1; }
+    std::string_view operator[](std::size_t dt_row) const {
+        return std::string_view(dt_arena.data() + dt_offsets[dt_row],
+                                static_cast<std::size_t>(dt_offsets[dt_row + 1] - dt_offsets[dt_row]));
+    }
+
+    // Rendered text of the whole batch and the row boundaries (size() + 1 entries)
+    std::string_view arena() const { return std::string_view(dt_arena.data(), dt_used); }
+    const std::vector<std::int64_t>& offsets() const { return dt_offsets; }
+
+    // Row width when every operation of the pattern has a fixed width (4-digit years), else 0
+    std::size_t fixedWidth() const { return dt_fixedWidth; }
+    const DateTime::FormatPattern& pattern() const { return dt_pattern; }
+
+private:
+    template <class ValueAt>
+    std::size_t render(ValueAt dt_valueAt, std::size_t dt_count);
+
+    DateTime::FormatPattern dt_pattern;
+    std::size_t dt_fixedWidth;
+    std::vector<char> dt_arena;
+    std::size_t dt_used = 0;
+    std::vector<std::int64_t> dt_offsets{0};
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "datetime.hpp"
+#include "datetime_batch.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Structure-of-arrays column of timestamps: one contiguous int64 array of epoch milliseconds and
+// either a single region for the whole column or one region handle per row. Bulk arithmetic,
+// range filters, min/max and differences run over the raw array (AVX2 when the CPU supports it,
+// selected at runtime, with a scalar fallback). Values are stored at millisecond precision;
+// finer parts of appended DateTimes are floored.
+class DateTimeColumn {
+public:
+    using Isa = DateTimeBatchParser::Isa;
+
+    // Destination arrays for extractFields (one element per row); null members are skipped
+    struct FieldArrays {
+        std::int32_t* year = nullptr;
+        std::int32_t* month = nullptr;        // 1-12
+        std::int32_t* day = nullptr;          // 1-31
+        std::int32_t* hour = nullptr;         // 0-23
+        std::int32_t* minute = nullptr;       // 0-59
+        std::int32_t* second = nullptr;       // 0-59
+        std::int32_t* millisecond = nullptr;  // 0-999
+        std::int32_t* dayOfWeek = nullptr;    // 0=Sunday, 6=Saturday
+    };
+
+    explicit DateTimeColumn(DateTime::RegionHandle dt_region = DateTime::RegionHandle::World);
+    // Adopt an epoch-millisecond array (e.g. the output of DateTimeBatchParser)
+    explicit DateTimeColumn(std::vector<std::int64_t> dt_epochMilliseconds,
+                            DateTime::RegionHandle dt_region = DateTime::RegionHandle::World);
+    // Per-row regions are kept only when the values do not share one region
+    explicit DateTimeColumn(const std::vector<DateTime>& dt_source);
+
+    void push_back(const DateTime& dt_value);
+    void reserve(std::size_t dt_count);
+    void clear();
+    std::size_t size() const { return dt_values.size(); }
+    bool empty() const { return dt_values.empty(); }
+
+    DateTime operator[](std::size_t dt_row) const;
+
+    // Raw epoch milliseconds
+    std::int64_t* data() { return dt_values.data(); }
+    const std::int64_t* data() const { return dt_values.data(); }
+    const std::vector<std::int64_t>& epochMilliseconds() const { return dt_values; }
+
+    // Column region, or the region of one row
+    DateTime::RegionHandle region() const { return dt_region; }
+    DateTime::RegionHandle region(std::size_t dt_row) const;
+    bool hasRowRegions() const { return !dt_rowRegions.empty(); }
+
+    // Kernel instruction set (Auto by default; Sse42 uses the scalar kernels). For tests and benchmarks.
+    void setIsa(Isa dt_requested) { dt_isa = dt_requested; }
+
+    // In-place arithmetic on every row (fixed-length units, like DateTime::plusDays)
+    DateTimeColumn& plusDays(int dt_days);
+    DateTimeColumn& plusHours(int dt_hours);
+    DateTimeColumn& plusMinutes(int dt_minutes);
+    DateTimeColumn& plusSeconds(int dt_seconds);
+    DateTimeColumn& plusMilliseconds(std::int64_t dt_milliseconds);
+
+    // Replace every row by the start (floorTo) or end (ceilTo) of its unit in the row's local time,
+    // e.g. group-by keys per local hour or month (see DateTime::floorTo)
+    DateTimeColumn& floorTo(DateTime::TimeUnit dt_unit);
+    DateTimeColumn& ceilTo(DateTime::TimeUnit dt_unit);
+
+    // Rows with dt_from <= value < dt_to
+    std::size_t countInRange(const DateTime& dt_from, const DateTime& dt_to) const;
+    std::vector<std::size_t> filterRange(const DateTime& dt_from, const DateTime& dt_to) const;
+
+    // Earliest/latest instant (nullopt for an empty column)
+    std::optional<DateTime> min() const;
+    std::optional<DateTime> max() const;
+
+    // Milliseconds from each row of dt_from to the same row of dt_to (columns must have equal size)
+    static void timeBetween(const DateTimeColumn& dt_from, const DateTimeColumn& dt_to, std::int64_t* dt_out);
+    // Milliseconds from dt_origin to each row
+    void timeBetween(const DateTime& dt_origin, std::int64_t* dt_out) const;
+
+    // Calendar fields of dt_count epoch-millisecond values at a fixed UTC offset, matching
+    // DateTime::fields(). The AVX2 kernel is branch-free and exact within about 17,000 years of
+    // the epoch; values beyond that take the scalar path.
+    static void extractFields(const std::int64_t* dt_epochMilliseconds, std::size_t dt_count,
+                              std::chrono::seconds dt_utcOffset, const FieldArrays& dt_out, Isa dt_isa = Isa::Auto);
+    static void extractFields(const std::int64_t* dt_epochMilliseconds, std::size_t dt_count,
+                              DateTime::RegionHandle dt_region, const FieldArrays& dt_out, Isa dt_isa = Isa::Auto);
+    // Calendar fields of every row in its own region
+    void extractFields(const FieldArrays& dt_out) const;
+
+private:
+    Isa resolvedIsa() const;
+    std::optional<DateTime> extreme(bool dt_maximum) const;
+    // Call dt_visit(rows, count, region) for each run of consecutive rows in one region
+    template <class Visit>
+    void forEachRegionRun(Visit&& dt_visit);
+
+    std::vector<std::int64_t> dt_values;
+    DateTime::RegionHandle dt_region;
+    std::vector<DateTime::RegionHandle> dt_rowRegions;  // Empty while every row uses dt_region
+    Isa dt_isa = Isa::Auto;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "datetime.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+// Detects the timestamp format of a log source from its first lines and then stays on the
+// winning parser. Each line is parsed as a leading timestamp (ParseMode::Prefix), so whole log
+// lines can be passed. When the locked format fails on a line, detection starts again from
+// that line. Not thread-safe; use one sniffer per source.
+class DateTimeFormatSniffer {
+public:
+    enum class Format : std::uint8_t {
+        Unknown,
+        Iso8601,            // 2024-03-01T12:00:00.123+09:00, 2024-03-01 12:00:00
+        Rfc1123,            // Fri, 01 Mar 2024 03:00:00 GMT
+        Apache,             // 01/Mar/2024:12:00:00 +0900
+        Syslog,             // Mar  1 12:00:00 (year supplied by the sniffer)
+        EpochSeconds,       // 1709294400 (9-11 digits)
+        EpochMilliseconds,  // 1709294400123 (12-14 digits)
+        Custom              // A pattern registered with addPattern
+    };
+
+    struct Statistics {
+        std::uint64_t hits = 0;        // Lines parsed by the locked format
+        std::uint64_t misses = 0;      // Lines the locked format rejected (each restarts detection)
+        std::uint64_t detections = 0;  // Times a format was locked
+        std::uint64_t failures = 0;    // Lines no candidate could parse
+    };
+
+    // dt_samples: lines that must be seen before a format is locked.
+    // dt_syslogYear: year used for syslog timestamps, which carry none.
+    explicit DateTimeFormatSniffer(std::size_t dt_samples = 3, int dt_syslogYear = 0);
+
+    // Additional candidate pattern (ParsePattern syntax), tried after the built-in formats
+    void addPattern(std::string_view dt_pattern);
+
+    // Parse the leading timestamp of a line; position in the result is where the timestamp ended
+    DateTime::ParseResult parse(std::string_view dt_line);
+
+    // Locked format (Unknown while detecting) and, for Custom, the index of the pattern
+    Format format() const { return dt_locked ? dt_candidates[dt_lockedCandidate].format : Format::Unknown; }
+    std::size_t customPatternIndex() const;
+    const Statistics& statistics() const { return dt_statistics; }
+
+    // Forget the locked format and counters
+    void reset();
+
+    static const char* formatName(Format dt_format);
+
+private:
+    struct Candidate {
+        Format format;
+        std::optional<DateTime::ParsePattern> pattern;
+        std::size_t customIndex;
+        std::uint32_t votes;
+    };
+
+    DateTime::ParseResult tryCandidate(const Candidate& dt_candidate, std::string_view dt_line) const;
+
+    std::vector<Candidate> dt_candidates;
+    std::size_t dt_samples;
+    int dt_syslogYear;
+    std::size_t dt_customCount = 0;
+
+    bool dt_locked = false;
+    std::size_t dt_lockedCandidate = 0;
+    std::size_t dt_samplesSeen = 0;
+    Statistics dt_statistics;
+};
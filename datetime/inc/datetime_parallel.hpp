@@ -0,0 +1,96 @@
+#pragma once
+
+#include "datetime.hpp"
+#include "datetime_batch.hpp"
+#include "datetime_column.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Work-stealing executor for bulk parse, format, region conversion and field extraction over
+// large spans. Rows are split into cache-sized chunks; each worker starts on its own contiguous
+// range of chunks and steals from the back of other workers' ranges once it runs dry. Results are
+// written by row index, so the output never depends on scheduling. The calling thread takes part
+// as worker 0. One batch runs at a time; calls from several threads are serialized.
+class DateTimeParallelExecutor {
+public:
+    // Rows per chunk (16K epoch values = 128 KiB of input, about one L2 slice)
+    static constexpr std::size_t DefaultChunkRows = 16384;
+
+    // Worker-local buffers, reused across the chunks (and batches) a worker processes
+    struct Scratch {
+        std::vector<char> text;
+        std::vector<std::size_t> rows;
+    };
+
+    // Called once per chunk with its row range [dt_begin, dt_end) and index
+    using ChunkTask = std::function<void(std::size_t dt_begin, std::size_t dt_end, std::size_t dt_chunk, Scratch& dt_scratch)>;
+
+    // dt_threadCount: workers including the caller (0 = hardware concurrency)
+    explicit DateTimeParallelExecutor(std::size_t dt_threadCount = 0, std::size_t dt_chunkRows = DefaultChunkRows);
+    ~DateTimeParallelExecutor();
+
+    DateTimeParallelExecutor(const DateTimeParallelExecutor&) = delete;
+    DateTimeParallelExecutor& operator=(const DateTimeParallelExecutor&) = delete;
+
+    std::size_t threadCount() const { return dt_scratch.size(); }
+    std::size_t chunkRows() const { return dt_chunkRows; }
+
+    // Run dt_task over [0, dt_rows) and wait for every chunk. The first exception thrown by a
+    // chunk is rethrown here once all workers have stopped. Must not be called from a chunk task.
+    void forEachChunk(std::size_t dt_rows, const ChunkTask& dt_task);
+
+    // DateTimeBatchParser::parse over strided rows; malformed row indices are reported in order
+    std::size_t parse(const char* dt_data, std::size_t dt_rows, std::size_t dt_stride, DateTimeBatchParser::Layout dt_layout,
+                      std::int64_t* dt_out, std::vector<std::size_t>* dt_malformedRows = nullptr);
+
+    // Render every value with one pattern into dt_arena, with dt_offsets in the
+    // DateTimeBatchFormatter layout (row i is dt_arena[dt_offsets[i], dt_offsets[i + 1]))
+    void format(std::span<const DateTime> dt_values, const DateTime::FormatPattern& dt_pattern, std::string& dt_arena,
+                std::vector<std::int64_t>& dt_offsets);
+
+    // dt_out[i] = dt_values[i].convertToRegion(dt_target)
+    void convertToRegion(std::span<const DateTime> dt_values, DateTime::RegionHandle dt_target, DateTime* dt_out);
+
+    // DateTimeColumn::extractFields split across workers
+    void extractFields(const std::int64_t* dt_epochMilliseconds, std::size_t dt_rows, std::chrono::seconds dt_utcOffset,
+                       const DateTimeColumn::FieldArrays& dt_out);
+
+private:
+    // Remaining chunks of one worker packed as (end << 32 | next): the owner takes from the front,
+    // thieves from the back, both with one CAS on the same word
+    struct alignas(64) ChunkRange {
+        std::atomic<std::uint64_t> range{0};
+    };
+
+    // forEachChunk body (caller holds dt_batchMutex)
+    void runChunksLocked(std::size_t dt_rows, const ChunkTask& dt_task);
+    bool takeChunk(std::size_t dt_worker, std::size_t& dt_chunk);
+    void runWorker(std::size_t dt_worker);
+    void workerLoop(std::size_t dt_worker);
+
+    std::size_t dt_chunkRows;
+    std::vector<Scratch> dt_scratch;
+    std::unique_ptr<ChunkRange[]> dt_ranges;
+    std::vector<std::thread> dt_threads;
+
+    // Current batch, published to the workers by the release increment of dt_generation
+    const ChunkTask* dt_task = nullptr;
+    std::size_t dt_count = 0;
+    std::exception_ptr dt_error;  // First failure of the batch (guarded by dt_errorMutex)
+
+    std::mutex dt_batchMutex;  // Serializes forEachChunk callers
+    std::mutex dt_errorMutex;
+    std::atomic<std::uint64_t> dt_generation{0};  // Workers wait on this for the next batch
+    std::atomic<std::size_t> dt_active{0};        // Helper workers still running the batch
+    std::atomic<bool> dt_stopping{false};
+};
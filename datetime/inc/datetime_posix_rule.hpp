@@ -0,0 +1,71 @@
+#pragma once
+
+#include "datetime.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// POSIX TZ rule such as "EST5EDT,M3.2.0,M11.1.0" or "<+0330>-3:30" (the TZif footer format,
+// including the RFC 8536 extension of transition times from -167 to 167 hours). Offsets follow
+// ISO sign conventions here (seconds east of UTC), not the inverted POSIX ones of the string.
+// A year's DST start and end instants are computed once and kept in a small lock-free cache,
+// so repeated conversions within a year cost one atomic load.
+class DateTimePosixRule {
+public:
+    // DST period of one year as UTC seconds; dstStart > dstEnd in the southern hemisphere
+    struct YearTransitions {
+        std::int64_t dstStart;
+        std::int64_t dstEnd;
+    };
+
+    // Throws DateTimeException for an invalid rule string
+    explicit DateTimePosixRule(std::string_view dt_rule);
+
+    DateTimePosixRule(const DateTimePosixRule&) = delete;
+    DateTimePosixRule& operator=(const DateTimePosixRule&) = delete;
+
+    const std::string& text() const { return dt_text; }
+    const std::string& standardName() const { return dt_standardName; }
+    const std::string& dstName() const { return dt_dstName; }
+    std::int32_t standardOffset() const { return dt_standardOffset; }
+    std::int32_t dstOffset() const { return dt_dstOffset; }
+    bool hasDst() const { return !dt_dstName.empty(); }
+
+    // DST start/end of a calendar year (memoized)
+    YearTransitions transitionsFor(std::int64_t dt_year) const;
+
+    bool isDstAt(std::int64_t dt_utcSeconds) const;
+    std::int32_t offsetAt(std::int64_t dt_utcSeconds) const;
+    // Same resolution as DateTimeZone::offsetForLocal: earlier instant for repeated local times,
+    // offset before the gap for skipped ones
+    std::int32_t offsetForLocal(std::int64_t dt_localSeconds) const;
+
+private:
+    // One transition date: Jn (1-365, February 29 never counted), n (0-365) or Mm.w.d
+    struct DateRule {
+        enum class Kind : std::uint8_t { JulianNoLeap, JulianZero, MonthWeekDay };
+        Kind kind = Kind::MonthWeekDay;
+        int day = 0;     // Julian day, or weekday (0 = Sunday) for Mm.w.d
+        int week = 0;    // 1-5, 5 = last
+        int month = 0;   // 1-12
+        std::int32_t time = 7200;  // Local seconds after midnight (default 02:00)
+    };
+
+    static constexpr std::size_t dt_cacheSlots = 16;
+
+    static std::int64_t dayOfYear(const DateRule& dt_date, std::int64_t dt_year);
+    YearTransitions computeTransitions(std::int64_t dt_year) const;
+
+    std::string dt_text;
+    std::string dt_standardName;
+    std::string dt_dstName;
+    std::int32_t dt_standardOffset = 0;
+    std::int32_t dt_dstOffset = 0;
+    DateRule dt_start;
+    DateRule dt_end;
+
+    // Direct-mapped by year; each slot packs (valid, year tag, start, end) into one word
+    mutable std::array<std::atomic<std::uint64_t>, dt_cacheSlots> dt_cache{};
+};
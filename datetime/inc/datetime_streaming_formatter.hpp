@@ -0,0 +1,45 @@
+#pragma once
+
+#include "datetime.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Stateful formatter for streams of timestamps (log lines, metrics). It keeps the last rendered
+// text and, when the next instant falls in the same local day, re-renders only the fields that
+// changed (hour, minute, second, fraction) in place. Not thread-safe; use one per thread.
+class DateTimeStreamingFormatter {
+public:
+    explicit DateTimeStreamingFormatter(std::string_view dt_pattern = "%Y-%m-%d %H:%M:%S");
+
+    // Render an instant (in its own region). The view stays valid until the next call.
+    std::string_view format(const DateTime& dt_value);
+
+    const DateTime::FormatPattern& pattern() const { return dt_pattern; }
+
+private:
+    // Finest time unit an operation depends on; Constant operations never change within a region
+    enum class Level : std::uint8_t { Constant, Day, Hour, Minute, Second, Fraction };
+
+    struct Slot {
+        std::uint32_t position;   // Start of the operation's text in dt_text
+        Level level;
+    };
+
+    void renderAll(const DateTime& dt_value);
+
+    DateTime::FormatPattern dt_pattern;
+    std::vector<Slot> dt_slots;
+    std::string dt_text;
+    bool dt_hasStrftime = false;  // strftime fallbacks may change width, so they force a full render
+
+    // State of the last rendered instant
+    bool dt_valid = false;
+    DateTime::RegionHandle dt_region = DateTime::RegionHandle::World;
+    std::int64_t dt_offsetSeconds = 0;
+    std::int64_t dt_localSeconds = 0;
+    std::int64_t dt_nanosecond = 0;
+    DateTime::Fields dt_fields{};
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "datetime.hpp"
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Opt-in clock ticker: a background thread publishes the current time several times per
+// second together with pre-rendered strings for registered formats, so hot threads can read a
+// timestamp and its text without locks, reference counts or allocation. Publications go round a
+// small ring of slots guarded by sequence numbers: a reader loads the latest sequence, copies the
+// slot out and retries only if the ticker overwrote that slot meanwhile.
+class DateTimeTicker {
+public:
+    using FormatId = std::size_t;
+
+    static constexpr std::size_t dt_maxFormats = 256;
+
+    // One publication of the clock
+    struct Tick {
+        DateTime time;           // Instant of the tick (UTC)
+        std::uint64_t sequence;  // Increases by one per publication, 0 before the first one
+    };
+
+    explicit DateTimeTicker(std::chrono::milliseconds dt_interval = std::chrono::milliseconds(100),
+                            DateTime::ClockSource dt_source = DateTime::ClockSource::Precise);
+    ~DateTimeTicker();
+
+    DateTimeTicker(const DateTimeTicker&) = delete;
+    DateTimeTicker& operator=(const DateTimeTicker&) = delete;
+
+    // Register a pattern (toString syntax, %Z prints the region identifier or zone abbreviation) rendered in the given region.
+    // Can be called before or while the ticker runs; the next snapshot includes it. Throws
+    // DateTimeException after dt_maxFormats formats.
+    FormatId addFormat(const std::string& dt_pattern, const DateTime::RegionTime& dt_region = DateTime::WorldTime);
+
+    // Start/stop the background thread (start publishes a first snapshot synchronously)
+    void start();
+    void stop();
+    bool isRunning() const;
+
+    // Latest publication (published once started or after a format was added)
+    Tick tick() const noexcept;
+    // Time of the latest publication, or the clock itself before the first one
+    DateTime now() const;
+    // Copy the latest text of a format into [dt_first, dt_last) (not null-terminated); dt_tick, if
+    // given, receives the publication it belongs to. Fails with errc::invalid_argument for an
+    // unknown format and errc::value_too_large if the text does not fit; maxTextSize() always does.
+    std::to_chars_result text(FormatId dt_format, char* dt_first, char* dt_last, Tick* dt_tick = nullptr) const noexcept;
+    // Longest text a format can produce (0 for an unknown format)
+    std::size_t maxTextSize(FormatId dt_format) const noexcept;
+
+    // Process-wide ticker (not started until start() is called)
+    static DateTimeTicker& global();
+
+private:
+    // Publications a reader can fall behind before it has to retry
+    static constexpr std::size_t dt_ringSize = 8;
+
+    // Texts of one format, one per ring slot, stored as words so readers can copy them with
+    // relaxed atomic loads while the ticker writes another slot
+    struct Format {
+        Format(const std::string& dt_pattern, DateTime::RegionHandle dt_region);
+
+        DateTime::FormatPattern pattern;
+        DateTime::RegionHandle region;
+        std::size_t capacity;  // Bytes per slot (maxFormattedSize of the pattern)
+        std::size_t words;     // Words per slot
+        std::unique_ptr<std::atomic<std::uint64_t>[]> text;
+        std::array<std::atomic<std::size_t>, dt_ringSize> length{};
+    };
+
+    struct Slot {
+        std::atomic<std::uint64_t> sequence{0};  // Publication held by the slot, 0 while it is rewritten
+        std::atomic<std::int64_t> nanoseconds{0};
+    };
+
+    std::chrono::milliseconds dt_interval;
+    DateTime::ClockSource dt_source;
+
+    std::array<Slot, dt_ringSize> dt_slots;
+    std::atomic<std::uint64_t> dt_latest{0};
+    std::uint64_t dt_sequence = 0;
+
+    // Formats are never moved or freed while the ticker lives; dt_formatCount is raised once a
+    // publication includes the new one
+    std::array<std::unique_ptr<Format>, dt_maxFormats> dt_formats;
+    std::atomic<std::size_t> dt_formatCount{0};
+    std::size_t dt_renderedCount = 0;  // Formats rendered by publishLocked
+    std::vector<char> dt_buffer;       // Rendering scratch of the publishing thread
+
+    mutable std::mutex dt_mutex;  // Guards the sequence, format registration and the thread state
+    std::condition_variable dt_wakeup;
+    std::thread dt_thread;
+    bool dt_running = false;
+
+    // Render and publish a new snapshot (caller holds dt_mutex)
+    void publishLocked();
+    void run();
+};
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "datetime.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// IANA time zone backed by a TZif (RFC 8536) file. The file is memory-mapped read-only and the
+// transition and local time type tables are read in place, so loading a zone copies nothing but
+// its name. Version 1 files use the 32-bit block; version 2+ files the 64-bit block and footer.
+// Instants after the last transition follow the footer's POSIX TZ rule (DateTimePosixRule), so
+// zones stay correct past the end of their table (2037 in most tzdata builds). Zones are
+// immutable and safe to share between threads.
+//
+// Lookups inside the index window (1970-2100 by default, see setIndexYears) go through a dense
+// table of 2^24-second (~194 day) buckets, each holding the up to two transitions inside it and
+// the types around them in 32 bytes, so an instant resolves with one cache-line touch. Instants
+// outside the window, or in buckets with more transitions, binary-search the TZif table.
+class DateTimePosixRule;
+
+class DateTimeZone {
+public:
+    // One local time type of the zone (the TZif ttinfo record)
+    struct LocalType {
+        std::int32_t utcOffset;         // Seconds east of UTC
+        bool isDst;
+        std::string_view abbreviation;  // e.g. "EDT"
+    };
+
+    struct Transition {
+        std::int64_t utcSeconds;  // Instant the type takes effect (seconds since the epoch)
+        LocalType type;
+    };
+
+    ~DateTimeZone();
+    DateTimeZone(const DateTimeZone&) = delete;
+    DateTimeZone& operator=(const DateTimeZone&) = delete;
+
+    // Load a zone such as "America/New_York": an embedded zone if the library was built with it,
+    // otherwise the file in zoneInfoDirectory(), otherwise a POSIX TZ string such as
+    // "CET-1CEST,M3.5.0,M10.5.0/3". Loaded zones are kept in DateTimeZoneRegistry, so every call
+    // with the same name returns the same object until a reload finds changed data (POSIX TZ
+    // strings are parsed again on every call unless registered through an alias). Throws
+    // DateTimeException if the zone does not exist or the file is not valid TZif.
+    static std::shared_ptr<const DateTimeZone> load(std::string_view dt_name);
+    // Same lookup as load() without the registry: every call reads the zone again
+    static std::shared_ptr<const DateTimeZone> read(std::string_view dt_name);
+    // Embedded zone or file in zoneInfoDirectory() only, without the POSIX TZ string fallback
+    static std::shared_ptr<const DateTimeZone> readTzif(std::string_view dt_name);
+    // Map an explicit TZif file (not cached)
+    static std::shared_ptr<const DateTimeZone> fromFile(const std::string& dt_path, std::string_view dt_name);
+    // Use TZif bytes that outlive the zone (e.g. data compiled into the binary) without copying
+    static std::shared_ptr<const DateTimeZone> fromMemory(std::string_view dt_name, std::span<const unsigned char> dt_data);
+    // Zone without a transition table, defined only by a POSIX TZ string (not cached). Throws
+    // DateTimeException for an invalid rule.
+    static std::shared_ptr<const DateTimeZone> fromPosixRule(std::string_view dt_rule);
+
+    // Zones compiled into the library (CMake option DATETIME_EMBED_ZONES), found by a
+    // compile-time perfect hash without filesystem access
+    static bool isEmbedded(std::string_view dt_name);
+    static std::vector<std::string_view> embeddedZoneNames();
+
+    // Directory searched by load(): $TZDIR if set, otherwise /usr/share/zoneinfo. Setting it
+    // reloads the registered zones from the new directory (DateTimeZoneRegistry::reload).
+    static std::string zoneInfoDirectory();
+    static void setZoneInfoDirectory(const std::string& dt_directory);
+
+    // Years [dt_firstYear, dt_lastYear) covered by the lookup index of zones created afterwards
+    // (an empty range disables the index)
+    static void setIndexYears(int dt_firstYear, int dt_lastYear);
+    static std::pair<int, int> indexYears();
+
+    const std::string& name() const { return dt_name; }
+    // True when both zones have the same name and TZif data (e.g. a reload of an unchanged file)
+    bool sameData(const DateTimeZone& dt_other) const;
+    // TZif format version ('\0' for version 1, otherwise '2', '3', ...)
+    char version() const { return dt_version; }
+    // True when the data is a read-only file mapping rather than a heap copy
+    bool isMapped() const { return dt_mapping != nullptr; }
+    // POSIX TZ string from the version 2+ footer (e.g. "EST5EDT,M3.2.0,M11.1.0"), empty for version 1
+    std::string_view footer() const { return dt_footer; }
+    // Parsed footer, or nullptr when there is none (or it is not a valid rule)
+    const DateTimePosixRule* rule() const { return dt_rule.get(); }
+
+    // Transition table, sorted by time
+    std::size_t transitionCount() const { return dt_transitionCount; }
+    Transition transition(std::size_t dt_index) const;
+    std::size_t localTypeCount() const { return dt_typeCount; }
+    LocalType localType(std::size_t dt_index) const;
+
+    // Local time type and UTC offset in effect at an instant
+    LocalType localTypeAt(std::int64_t dt_utcSeconds) const;
+    std::int32_t offsetAt(std::int64_t dt_utcSeconds) const;
+    // UTC offset to apply to local wall-clock seconds. An ambiguous local time (clocks set back)
+    // takes the earlier instant; a skipped one (clocks set forward) is read with the offset
+    // before the gap, which moves it forward by the gap.
+    std::int32_t offsetForLocal(std::int64_t dt_localSeconds) const;
+    // Offset of the most recent standard-time type (the zone's "usual" offset)
+    std::int32_t standardOffset() const { return dt_standardOffset; }
+    // Longest abbreviation of any local type or of the footer rule (bounds %Z output)
+    std::size_t maxAbbreviationLength() const;
+
+    // offsetAt by binary search over the TZif table (or the footer rule), bypassing the index. For
+    // tests and benchmarks.
+    std::int32_t searchOffsetAt(std::int64_t dt_utcSeconds) const;
+    // Index buckets (0 when the zone has no index)
+    std::size_t indexBucketCount() const { return dt_index.size(); }
+
+private:
+    static constexpr int dt_bucketShift = 24;
+
+    // Transitions inside one index bucket: type[0] before first, type[1] from first, type[2] from second
+    struct alignas(32) IndexBucket {
+        std::int64_t first;
+        std::int64_t second;
+        std::int32_t offset[3];
+        std::uint8_t type[3];
+        bool overflow;  // More than two transitions: search instead
+    };
+
+    DateTimeZone(std::string_view dt_name, const unsigned char* dt_data, std::size_t dt_size);
+
+    void parse();
+    void buildIndex();
+    std::int64_t transitionTime(std::size_t dt_index) const;
+    std::size_t searchTypeIndexAt(std::int64_t dt_utcSeconds) const;
+    std::size_t typeIndexAt(std::int64_t dt_utcSeconds) const;
+    // Bucket covering an instant, or nullptr outside the index or for an overflowing bucket
+    const IndexBucket* bucketAt(std::int64_t dt_utcSeconds) const;
+
+    std::string dt_name;
+    const unsigned char* dt_data;
+    std::size_t dt_size;
+    void* dt_mapping = nullptr;               // munmap on destruction when set
+    std::vector<unsigned char> dt_ownedData;  // Fallback copy where mmap is unavailable
+
+    // Views into dt_data (all multi-byte fields are big-endian)
+    char dt_version = 0;
+    std::size_t dt_timeSize = 8;              // 4 for the version 1 block
+    const unsigned char* dt_transitionTimes = nullptr;
+    const unsigned char* dt_transitionTypes = nullptr;
+    const unsigned char* dt_types = nullptr;  // 6-byte ttinfo records
+    const char* dt_abbreviations = nullptr;
+    std::size_t dt_transitionCount = 0;
+    std::size_t dt_typeCount = 0;
+    std::size_t dt_abbreviationSize = 0;
+    std::string_view dt_footer;
+    std::int32_t dt_standardOffset = 0;
+
+    // The footer rule applies from the last transition on (from the start without transitions)
+    std::unique_ptr<const DateTimePosixRule> dt_rule;
+    std::int64_t dt_ruleStart = 0;
+
+    std::vector<IndexBucket> dt_index;
+    std::int64_t dt_indexStart = 0;
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "datetime_zone.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Process-wide registry of time zones by name (IANA name or alias). A zone is loaded on first
+// use and then published as a plain pointer, so every later lookup is a lock-free hash probe plus
+// one atomic pointer load; readers never wait for the write mutex and touch no shared reference
+// count. The registry lives for the whole process and owns every zone it registers: reload()
+// publishes fresh data per name while readers keep going and keeps the superseded zone, so
+// pointers handed out earlier stay valid. Only zones whose data changed are replaced, so memory
+// grows by one zone per tzdata change of a zone in use.
+//
+// Names that fail to load are remembered until the next reload(), so an unknown name costs a file
+// lookup once rather than on every call (at most dt_maxMisses names are remembered; further
+// unknown names are looked up again each time). POSIX TZ strings are parsed on every lookup and
+// only registered when an alias points at them, so arbitrary input does not fill the table.
+// DateTimeZone::load() goes through the registry.
+class DateTimeZoneRegistry {
+public:
+    static constexpr std::size_t dt_maxNames = 4096;
+    static constexpr std::size_t dt_maxMisses = 1024;
+
+    static DateTimeZoneRegistry& instance();
+
+    DateTimeZoneRegistry(const DateTimeZoneRegistry&) = delete;
+    DateTimeZoneRegistry& operator=(const DateTimeZoneRegistry&) = delete;
+
+    // Zone for a name or alias, loaded on first use (see DateTimeZone::read); nullptr if it cannot
+    // be loaded. Only embedded zones, TZif files and alias targets are registered. A registered
+    // zone is returned without shared ownership (the registry keeps it alive), so copies of the
+    // pointer cost no atomic operations; a POSIX TZ string is returned as a new owned zone.
+    std::shared_ptr<const DateTimeZone> find(std::string_view dt_name);
+    // Same as find(), but throws DateTimeException if the zone cannot be loaded
+    std::shared_ptr<const DateTimeZone> get(std::string_view dt_name);
+
+    // Make dt_alias resolve to the zone of dt_target (loaded on first use through either name).
+    // Throws DateTimeException if dt_alias is already registered for something else.
+    void addAlias(std::string_view dt_alias, std::string_view dt_target);
+
+    // Read every loaded zone again (e.g. after a tzdata update, which replaces files by rename)
+    // and publish the new data name by name without blocking readers. Zones whose data did not
+    // change, or that no longer load, stay as they are. Names that failed to load are tried again
+    // on their next lookup. Returns the number of zones replaced.
+    std::size_t reload();
+    // Number of completed reloads
+    std::uint64_t generation() const { return dt_generation.load(std::memory_order_acquire); }
+
+    // Registered names (zones and aliases) and their count, not counting remembered misses
+    std::vector<std::string> names() const;
+    std::size_t size() const { return dt_registered.load(std::memory_order_acquire); }
+
+private:
+    // Outcome of the last failed load of a name, cleared by reload()
+    enum class Miss : std::uint8_t {
+        None,       // Not known to fail: load on lookup
+        PosixRule,  // No zone file, but the name is a POSIX TZ string (parsed on every lookup)
+        Unknown     // Neither a zone nor a POSIX TZ string
+    };
+
+    // The name is immutable once visible; the other fields only change under dt_writeMutex
+    struct Entry {
+        std::string name;
+        std::atomic<Entry*> target{nullptr};  // Entry an alias resolves to, nullptr for a zone
+        std::atomic<bool> registered{false};  // False while the entry only records a failed lookup
+        std::atomic<const DateTimeZone*> zone{nullptr};
+        std::atomic<Miss> miss{Miss::None};
+    };
+
+    // Open-addressing index holding (entry + 1), 0 marks an empty slot
+    static constexpr std::size_t dt_maxEntries = dt_maxNames + dt_maxMisses;
+    static constexpr std::size_t dt_indexSize = 16384;  // Power of two, at least twice dt_maxEntries
+    static constexpr std::size_t dt_indexMask = dt_indexSize - 1;
+
+    DateTimeZoneRegistry() = default;
+
+    static std::size_t hashName(std::string_view dt_name);
+    Entry* lookup(std::string_view dt_name, std::size_t dt_hash) const;
+    // A registered zone as returned by find(): the registry owns it, so the pointer shares nothing
+    static std::shared_ptr<const DateTimeZone> borrowed(const DateTimeZone* dt_zone);
+    // Resolve aliases and load on first use; nullptr on failure, with the reason in dt_error
+    std::shared_ptr<const DateTimeZone> resolve(std::string_view dt_name, std::string* dt_error);
+    // Remember that dt_name failed to load, unless a reload completed after dt_sinceGeneration
+    void recordMiss(std::string_view dt_name, std::size_t dt_hash, Miss dt_miss, std::uint64_t dt_sinceGeneration);
+    // Add an entry (caller holds dt_writeMutex); an unregistered one only records a miss and is
+    // not added (nullptr) once dt_maxMisses of them exist
+    Entry* insertLocked(std::string_view dt_name, std::size_t dt_hash, Entry* dt_target, bool dt_isRegistered);
+    // Turn a miss entry into a registered name (caller holds dt_writeMutex)
+    void registerLocked(Entry& dt_entry);
+    // Take ownership of a zone and publish it for dt_entry (caller holds dt_writeMutex)
+    void publishLocked(Entry& dt_entry, std::shared_ptr<const DateTimeZone> dt_zone);
+
+    std::array<std::atomic<Entry*>, dt_maxEntries> dt_entries{};
+    std::array<std::atomic<std::uint32_t>, dt_indexSize> dt_index{};
+    std::atomic<std::uint32_t> dt_size{0};
+    std::atomic<std::uint32_t> dt_registered{0};
+    std::size_t dt_missCount = 0;
+    std::atomic<std::uint64_t> dt_generation{0};
+    mutable std::mutex dt_writeMutex;  // Serializes inserts and publications, never taken by readers
+    std::mutex dt_reloadMutex;         // Serializes reloads
+    std::vector<std::unique_ptr<Entry>> dt_ownedEntries;
+    std::vector<std::shared_ptr<const DateTimeZone>> dt_ownedZones;  // Every zone ever published
+};
@@ -1,13 +1,26 @@
 #include "datetime.hpp"
+#include "datetime_zone.hpp"
 #include <chrono>
 #include <ctime>
-#include <time.h>  // Added for timegm
-#include <iomanip>
-#include <sstream>
 #include <format>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define DATETIME_HAS_TSC 1
+#endif
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <unordered_map>
 
 // Initialize static region time constants
 const DateTime::RegionTime DateTime::WorldTime{"UTC", 0};
@@ -18,39 +31,1146 @@ const DateTime::RegionTime DateTime::PacificTime{"PST", -8};
 // Initialize static mutex (as a class member rather than a global variable)
 std::mutex DateTime::dt_timeMutex;
 
+// Field caching is opt-in
+std::atomic<bool> DateTime::dt_fieldCaching{false};
+
+namespace {
+
+// Decomposition helpers built on the integer civil calendar kernel (DateTime::daysFromCivil /
+// DateTime::civilFromDays). They use no libc calls and no shared state, so they are safe
+// to call from any thread without locking.
+constexpr std::int64_t dt_secondsPerDay = 86400;
+
+// Break seconds since the epoch down into calendar fields (millisecond is left at 0)
+DateTime::Fields dt_secondsToFields(std::int64_t dt_seconds) {
+    const std::int64_t dt_days = DateTime::floorDiv(dt_seconds, dt_secondsPerDay);
+    const std::int64_t dt_secondOfDay = dt_seconds - dt_days * dt_secondsPerDay;
+    
+    const DateTime::CivilDate dt_date = DateTime::civilFromDays(dt_days);
+    
+    DateTime::Fields dt_fields{};
+    dt_fields.year = dt_date.year;
+    dt_fields.month = dt_date.month;
+    dt_fields.day = dt_date.day;
+    dt_fields.hour = static_cast<int>(dt_secondOfDay / 3600);
+    dt_fields.minute = static_cast<int>(dt_secondOfDay % 3600 / 60);
+    dt_fields.second = static_cast<int>(dt_secondOfDay % 60);
+    // 1970-01-01 was a Thursday (4)
+    dt_fields.dayOfWeek = static_cast<int>(dt_days + 4 - DateTime::floorDiv(dt_days + 4, 7) * 7);
+    // Days before the month, plus one from March on in leap years
+    constexpr int dt_daysBeforeMonth[] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+    dt_fields.dayOfYear = dt_daysBeforeMonth[dt_date.month - 1] + dt_date.day + (dt_date.month > 2 && DateTime::isLeapYear(dt_date.year));
+    return dt_fields;
+}
+
+// Break seconds since the epoch down into a std::tm (replacement for gmtime_r)
+std::tm dt_secondsToTm(std::int64_t dt_seconds) {
+    const DateTime::Fields dt_fields = dt_secondsToFields(dt_seconds);
+    
+    std::tm dt_timeStruct{};
+    dt_timeStruct.tm_year = dt_fields.year - 1900;
+    dt_timeStruct.tm_mon = dt_fields.month - 1;
+    dt_timeStruct.tm_mday = dt_fields.day;
+    dt_timeStruct.tm_hour = dt_fields.hour;
+    dt_timeStruct.tm_min = dt_fields.minute;
+    dt_timeStruct.tm_sec = dt_fields.second;
+    dt_timeStruct.tm_wday = dt_fields.dayOfWeek;
+    dt_timeStruct.tm_yday = dt_fields.dayOfYear - 1;
+    return dt_timeStruct;
+}
+
+// Process-wide region registry. Entries are created once and never modified or freed,
+// so readers resolve handles with one or two atomic loads and no locking. The first
+// dt_fastRegions regions are also found by a lock-free hash probe when interned again; the
+// table then keeps growing in chunks (up to the 32-bit handle range), and interning beyond the
+// first dt_fastRegions takes the writer mutex. Zones handed out by DateTimeZoneRegistry carry no
+// ownership, so entries do not pin them; any other zone is kept alive by its entry.
+class DT_RegionRegistry {
+public:
+    struct Entry {
+        DateTime::RegionTime region;
+        std::int64_t offsetSeconds;
+    };
+    
+    static constexpr std::size_t dt_fastRegions = 4096;
+    
+    static DT_RegionRegistry& instance() {
+        static DT_RegionRegistry dt_registry;
+        return dt_registry;
+    }
+    
+    const Entry& entry(DateTime::RegionHandle dt_handle) const {
+        const std::uint32_t dt_value = static_cast<std::uint32_t>(dt_handle);
+        if (dt_value < dt_fastRegions) {
+            return *dt_entries[dt_value].load(std::memory_order_acquire);
+        }
+        const ChunkPosition dt_position = chunkPosition(dt_value);
+        return *dt_chunks[dt_position.chunk].load(std::memory_order_acquire)[dt_position.offset].load(std::memory_order_acquire);
+    }
+    
+    DateTime::RegionHandle intern(const DateTime::RegionTime& dt_region) {
+        const std::int64_t dt_offset = dt_region.hourOffset * std::int64_t{3600} + dt_region.minuteOffset * std::int64_t{60};
+        const std::size_t dt_hash = hashRegion(dt_region.identifier, dt_offset);
+        
+        // Lock-free lookup of an existing entry
+        std::uint32_t dt_found = find(dt_region, dt_offset, dt_hash);
+        if (dt_found != 0) {
+            return static_cast<DateTime::RegionHandle>(dt_found - 1);
+        }
+        
+        std::lock_guard<std::mutex> dt_lock(dt_writeMutex);
+        dt_found = find(dt_region, dt_offset, dt_hash);
+        if (dt_found != 0) {
+            return static_cast<DateTime::RegionHandle>(dt_found - 1);
+        }
+        const auto [dt_begin, dt_end] = dt_slowIndex.equal_range(dt_hash);
+        for (auto dt_it = dt_begin; dt_it != dt_end; ++dt_it) {
+            if (matches(entry(static_cast<DateTime::RegionHandle>(dt_it->second)), dt_region, dt_offset)) {
+                return static_cast<DateTime::RegionHandle>(dt_it->second);
+            }
+        }
+        
+        const std::uint32_t dt_count = dt_size.load(std::memory_order_relaxed);
+        if (dt_count == std::numeric_limits<std::uint32_t>::max()) {
+            throw DateTimeException("Region registry is full, cannot register: " + dt_region.identifier);
+        }
+        const Entry* dt_entry = new Entry{dt_region, dt_offset};
+        const std::size_t dt_nameLength = dt_region.zone ? dt_region.zone->maxAbbreviationLength() : dt_region.identifier.size();
+        if (dt_nameLength > dt_maxRegionNameLength.load(std::memory_order_relaxed)) {
+            dt_maxRegionNameLength.store(dt_nameLength, std::memory_order_release);
+        }
+        
+        if (dt_count >= dt_fastRegions) {
+            const ChunkPosition dt_position = chunkPosition(dt_count);
+            std::atomic<const Entry*>* dt_chunk = dt_chunks[dt_position.chunk].load(std::memory_order_relaxed);
+            if (dt_chunk == nullptr) {
+                dt_chunk = new std::atomic<const Entry*>[dt_fastRegions << dt_position.chunk]();
+                dt_chunks[dt_position.chunk].store(dt_chunk, std::memory_order_release);
+            }
+            dt_chunk[dt_position.offset].store(dt_entry, std::memory_order_release);
+            dt_slowIndex.emplace(dt_hash, dt_count);
+            dt_size.store(dt_count + 1, std::memory_order_release);
+            return static_cast<DateTime::RegionHandle>(dt_count);
+        }
+        dt_entries[dt_count].store(dt_entry, std::memory_order_release);
+        
+        // Publish in the index after the entry itself is visible
+        for (std::size_t dt_slot = dt_hash & dt_indexMask;; dt_slot = (dt_slot + 1) & dt_indexMask) {
+            if (dt_index[dt_slot].load(std::memory_order_relaxed) == 0) {
+                dt_index[dt_slot].store(dt_count + 1, std::memory_order_release);
+                break;
+            }
+        }
+        dt_size.store(dt_count + 1, std::memory_order_release);
+        return static_cast<DateTime::RegionHandle>(dt_count);
+    }
+    
+    std::uint32_t size() const {
+        return dt_size.load(std::memory_order_acquire);
+    }
+    
+    // Longest %Z text of any interned region: its identifier, or the longest zone abbreviation
+    std::size_t maxRegionNameLength() const {
+        return dt_maxRegionNameLength.load(std::memory_order_acquire);
+    }
+
+private:
+    // Open-addressing index holding (handle + 1) of the first dt_fastRegions entries, 0 marks an empty slot
+    static constexpr std::size_t dt_indexSize = dt_fastRegions * 2;
+    static constexpr std::size_t dt_indexMask = dt_indexSize - 1;
+    // Handles from dt_fastRegions on live in chunks of dt_fastRegions << chunk entries
+    static constexpr std::size_t dt_chunkCount = 20;
+    
+    struct ChunkPosition {
+        std::size_t chunk;
+        std::size_t offset;
+    };
+    
+    std::array<std::atomic<const Entry*>, dt_fastRegions> dt_entries{};
+    std::array<std::atomic<std::uint32_t>, dt_indexSize> dt_index{};
+    std::array<std::atomic<std::atomic<const Entry*>*>, dt_chunkCount> dt_chunks{};
+    std::unordered_multimap<std::size_t, std::uint32_t> dt_slowIndex;  // Hash to handle beyond dt_fastRegions (under dt_writeMutex)
+    std::atomic<std::uint32_t> dt_size{0};
+    std::mutex dt_writeMutex;
+    std::atomic<std::size_t> dt_maxRegionNameLength{0};
+    
+    DT_RegionRegistry() {
+        // Built-in regions get fixed handles in declaration order (WorldTime must be 0)
+        intern(DateTime::RegionTime("UTC", 0));
+        intern(DateTime::RegionTime("JST", 9));
+        intern(DateTime::RegionTime("EST", -5));
+        intern(DateTime::RegionTime("PST", -8));
+    }
+    
+    static ChunkPosition chunkPosition(std::uint32_t dt_handle) {
+        const std::size_t dt_chunk = static_cast<std::size_t>(std::bit_width(dt_handle / dt_fastRegions)) - 1;
+        return ChunkPosition{dt_chunk, dt_handle - (dt_fastRegions << dt_chunk)};
+    }
+    
+    static std::size_t hashRegion(const std::string& dt_identifier, std::int64_t dt_offset) {
+        // FNV-1a over the identifier, mixed with the offset
+        std::uint64_t dt_hash = 14695981039346656037ull;
+        for (unsigned char dt_char : dt_identifier) {
+            dt_hash = (dt_hash ^ dt_char) * 1099511628211ull;
+        }
+        dt_hash ^= static_cast<std::uint64_t>(dt_offset) * 0x9E3779B97F4A7C15ull;
+        return static_cast<std::size_t>(dt_hash ^ (dt_hash >> 32));
+    }
+    
+    // Zones are matched by name and data rather than by object, so zones read again by
+    // DateTimeZoneRegistry::reload() reuse the handle unless their tzdata changed
+    static bool sameZone(const DateTimeZone* dt_first, const DateTimeZone* dt_second) {
+        return dt_first == dt_second || (dt_first && dt_second && dt_first->sameData(*dt_second));
+    }
+    
+    static bool matches(const Entry& dt_entry, const DateTime::RegionTime& dt_region, std::int64_t dt_offset) {
+        return dt_entry.offsetSeconds == dt_offset && sameZone(dt_entry.region.zone.get(), dt_region.zone.get()) &&
+               dt_entry.region.hourOffset == dt_region.hourOffset &&
+               dt_entry.region.minuteOffset == dt_region.minuteOffset &&
+               dt_entry.region.identifier == dt_region.identifier;
+    }
+    
+    std::uint32_t find(const DateTime::RegionTime& dt_region, std::int64_t dt_offset, std::size_t dt_hash) const {
+        for (std::size_t dt_slot = dt_hash & dt_indexMask;; dt_slot = (dt_slot + 1) & dt_indexMask) {
+            const std::uint32_t dt_value = dt_index[dt_slot].load(std::memory_order_acquire);
+            if (dt_value == 0) {
+                return 0;
+            }
+            if (matches(*dt_entries[dt_value - 1].load(std::memory_order_acquire), dt_region, dt_offset)) {
+                return dt_value;
+            }
+        }
+    }
+};
+
+// Two-digit lookup table: characters 2n and 2n+1 are the decimal digits of n (0-99)
+constexpr auto dt_digitPairs = [] {
+    std::array<char, 200> dt_table{};
+    for (int dt_value = 0; dt_value < 100; ++dt_value) {
+        dt_table[dt_value * 2] = static_cast<char>('0' + dt_value / 10);
+        dt_table[dt_value * 2 + 1] = static_cast<char>('0' + dt_value % 10);
+    }
+    return dt_table;
+}();
+
+constexpr const char* dt_weekdayNames[] = {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
+constexpr const char* dt_monthNames[] = {"January", "February", "March", "April", "May", "June",
+                                         "July", "August", "September", "October", "November", "December"};
+
+inline char* dt_write2(char* dt_out, int dt_value) {
+    std::memcpy(dt_out, &dt_digitPairs[static_cast<std::size_t>(dt_value) * 2], 2);
+    return dt_out + 2;
+}
+
+// Write a non-negative value zero-padded to at least dt_minWidth digits
+inline char* dt_writeUnsigned(char* dt_out, std::uint64_t dt_value, int dt_minWidth) {
+    char dt_buffer[20];
+    int dt_length = 0;
+    do {
+        dt_buffer[dt_length++] = static_cast<char>('0' + dt_value % 10);
+        dt_value /= 10;
+    } while (dt_value != 0);
+    while (dt_length < dt_minWidth) {
+        dt_buffer[dt_length++] = '0';
+    }
+    while (dt_length > 0) {
+        *dt_out++ = dt_buffer[--dt_length];
+    }
+    return dt_out;
+}
+
+inline char* dt_writeSigned(char* dt_out, std::int64_t dt_value, int dt_minWidth) {
+    if (dt_value < 0) {
+        *dt_out++ = '-';
+        return dt_writeUnsigned(dt_out, static_cast<std::uint64_t>(-(dt_value + 1)) + 1, dt_minWidth);
+    }
+    return dt_writeUnsigned(dt_out, static_cast<std::uint64_t>(dt_value), dt_minWidth);
+}
+
+inline char* dt_writeName(char* dt_out, const char* dt_name, bool dt_abbreviated) {
+    const std::size_t dt_length = dt_abbreviated ? 3 : std::strlen(dt_name);
+    std::memcpy(dt_out, dt_name, dt_length);
+    return dt_out + dt_length;
+}
+
+// Leading dt_digits (1-9) digits of a nanosecond value, written two at a time from the right
+inline char* dt_writeFraction(char* dt_out, int dt_nanosecond, int dt_digits) {
+    constexpr std::uint32_t dt_divisors[] = {1000000000, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1};
+    std::uint32_t dt_value = static_cast<std::uint32_t>(dt_nanosecond) / dt_divisors[dt_digits];
+    char* const dt_end = dt_out + dt_digits;
+    char* dt_cursor = dt_end;
+    for (; dt_cursor - dt_out >= 2; dt_value /= 100) {
+        dt_cursor -= 2;
+        std::memcpy(dt_cursor, &dt_digitPairs[dt_value % 100 * 2], 2);
+    }
+    if (dt_cursor != dt_out) {
+        *dt_out = static_cast<char>('0' + dt_value);
+    }
+    return dt_end;
+}
+
+// Value of a plain two-digit field operation, -1 for any other operation
+inline int dt_twoDigitField(DateTime::FormatOpCode dt_code, const DateTime::Fields& dt_fields) {
+    switch (dt_code) {
+        case DateTime::FormatOpCode::Month:
+            return dt_fields.month;
+        case DateTime::FormatOpCode::Day:
+            return dt_fields.day;
+        case DateTime::FormatOpCode::Hour:
+            return dt_fields.hour;
+        case DateTime::FormatOpCode::Minute:
+            return dt_fields.minute;
+        case DateTime::FormatOpCode::Second:
+            return dt_fields.second;
+        default:
+            return -1;
+    }
+}
+
+// Render one non-literal operation (everything except Literal and RegionName) into dt_buffer,
+// which must hold DateTime::MaxOperationSize characters; returns the number of characters written
+std::size_t dt_renderOp(const DateTime::FormatOp& dt_op, std::string_view dt_text,
+                        const DateTime::Fields& dt_fields, std::int64_t dt_offsetSeconds, char* dt_buffer) {
+    using Op = DateTime::FormatOpCode;
+    char* dt_out = dt_buffer;
+    switch (dt_op.code) {
+        case Op::Char:
+            *dt_out++ = static_cast<char>(dt_op.offset);
+            break;
+        case Op::Year:
+            if (dt_fields.year >= 0 && dt_fields.year <= 9999) {
+                dt_out = dt_write2(dt_out, dt_fields.year / 100);
+                dt_out = dt_write2(dt_out, dt_fields.year % 100);
+            } else {
+                dt_out = dt_writeSigned(dt_out, dt_fields.year, 4);
+            }
+            break;
+        case Op::Century:
+            dt_out = dt_writeSigned(dt_out, DateTime::floorDiv(dt_fields.year, 100), 2);
+            break;
+        case Op::YearOfCentury:
+            dt_out = dt_write2(dt_out, static_cast<int>(dt_fields.year - DateTime::floorDiv(dt_fields.year, 100) * 100));
+            break;
+        case Op::Month:
+            dt_out = dt_write2(dt_out, dt_fields.month);
+            break;
+        case Op::Day:
+            dt_out = dt_write2(dt_out, dt_fields.day);
+            break;
+        case Op::DaySpacePadded:
+            dt_out = dt_write2(dt_out, dt_fields.day);
+            if (dt_fields.day < 10) {
+                dt_buffer[0] = ' ';
+            }
+            break;
+        case Op::Hour:
+            dt_out = dt_write2(dt_out, dt_fields.hour);
+            break;
+        case Op::Hour12:
+            dt_out = dt_write2(dt_out, dt_fields.hour % 12 == 0 ? 12 : dt_fields.hour % 12);
+            break;
+        case Op::Minute:
+            dt_out = dt_write2(dt_out, dt_fields.minute);
+            break;
+        case Op::Second:
+            dt_out = dt_write2(dt_out, dt_fields.second);
+            break;
+        case Op::DayOfYear:
+            *dt_out++ = static_cast<char>('0' + dt_fields.dayOfYear / 100);
+            dt_out = dt_write2(dt_out, dt_fields.dayOfYear % 100);
+            break;
+        case Op::WeekdayNumber:
+            *dt_out++ = static_cast<char>('0' + dt_fields.dayOfWeek);
+            break;
+        case Op::IsoWeekdayNumber:
+            *dt_out++ = static_cast<char>('0' + (dt_fields.dayOfWeek == 0 ? 7 : dt_fields.dayOfWeek));
+            break;
+        case Op::WeekdayShort:
+        case Op::WeekdayFull:
+            dt_out = dt_writeName(dt_out, dt_weekdayNames[dt_fields.dayOfWeek], dt_op.code == Op::WeekdayShort);
+            break;
+        case Op::MonthShort:
+        case Op::MonthFull:
+            dt_out = dt_writeName(dt_out, dt_monthNames[dt_fields.month - 1], dt_op.code == Op::MonthShort);
+            break;
+        case Op::AmPm:
+            *dt_out++ = dt_fields.hour < 12 ? 'A' : 'P';
+            *dt_out++ = 'M';
+            break;
+        case Op::Fraction:
+            dt_out = dt_writeFraction(dt_out, dt_fields.nanosecond, dt_op.offset);
+            break;
+        case Op::RegionOffset: {
+            const std::int64_t dt_absolute = dt_offsetSeconds < 0 ? -dt_offsetSeconds : dt_offsetSeconds;
+            *dt_out++ = dt_offsetSeconds < 0 ? '-' : '+';
+            dt_out = dt_write2(dt_out, static_cast<int>(dt_absolute / 3600 % 100));
+            dt_out = dt_write2(dt_out, static_cast<int>(dt_absolute / 60 % 60));
+            break;
+        }
+        case Op::Strftime: {
+            std::tm dt_timeStruct{};
+            dt_timeStruct.tm_year = dt_fields.year - 1900;
+            dt_timeStruct.tm_mon = dt_fields.month - 1;
+            dt_timeStruct.tm_mday = dt_fields.day;
+            dt_timeStruct.tm_hour = dt_fields.hour;
+            dt_timeStruct.tm_min = dt_fields.minute;
+            dt_timeStruct.tm_sec = dt_fields.second;
+            dt_timeStruct.tm_wday = dt_fields.dayOfWeek;
+            dt_timeStruct.tm_yday = dt_fields.dayOfYear - 1;
+            
+            char dt_spec[4] = {};
+            std::memcpy(dt_spec, dt_text.data() + dt_op.offset, std::min<std::size_t>(dt_op.length, 3));
+            dt_out += std::strftime(dt_out, DateTime::MaxOperationSize, dt_spec, &dt_timeStruct);
+            break;
+        }
+        case Op::Literal:
+        case Op::RegionName:
+            break;
+    }
+    return static_cast<std::size_t>(dt_out - dt_buffer);
+}
+
+// Upper bound of one operation's output (dt_maxRegionName covers %Z)
+std::size_t dt_maxOpSize(const DateTime::FormatOp& dt_op, std::size_t dt_maxRegionName) {
+    using Op = DateTime::FormatOpCode;
+    switch (dt_op.code) {
+        case Op::Literal:
+            return dt_op.length;
+        case Op::Char:
+        case Op::WeekdayNumber:
+        case Op::IsoWeekdayNumber:
+            return 1;
+        case Op::Year:
+        case Op::Century:
+            return 11;  // Sign and digits of any int
+        case Op::YearOfCentury:
+        case Op::Month:
+        case Op::Day:
+        case Op::DaySpacePadded:
+        case Op::Hour:
+        case Op::Hour12:
+        case Op::Minute:
+        case Op::Second:
+        case Op::AmPm:
+            return 2;
+        case Op::DayOfYear:
+        case Op::WeekdayShort:
+        case Op::MonthShort:
+            return 3;
+        case Op::WeekdayFull:
+        case Op::MonthFull:
+            return 9;  // "Wednesday", "September"
+        case Op::Fraction:
+            return dt_op.offset;
+        case Op::RegionName:
+            return dt_maxRegionName;
+        case Op::RegionOffset:
+            return 5;
+        case Op::Strftime:
+            return DateTime::MaxOperationSize;
+    }
+    return DateTime::MaxOperationSize;
+}
+
+#if defined(DATETIME_HAS_TSC)
+// Timestamp counter clock: nanoseconds = baseNanoseconds + (ticks - baseTicks) * scale >> 32.
+// Only used when the counter is invariant (constant rate across P-states and sleep states). The
+// first use calibrates over 5 ms; after that, the first reader past dt_refreshNanoseconds measures
+// the rate against system_clock over the whole period and slews onto the system clock by the next
+// refresh, so NTP frequency corrections are followed without jumps. An error beyond dt_maxSlew
+// (a step of the system clock) re-anchors directly. Parameters are published under a sequence lock.
+class DT_TscClock {
+public:
+    static DT_TscClock& instance() {
+        static DT_TscClock dt_clock;
+        return dt_clock;
+    }
+    
+    // Nanoseconds since the epoch, or nullopt when the counter is not usable
+    std::optional<std::int64_t> nanoseconds() {
+        if (!dt_usable) {
+            return std::nullopt;
+        }
+        std::uint64_t dt_ticks = __rdtsc();
+        Parameters dt_parameters = load();
+        if (static_cast<std::int64_t>(dt_ticks - dt_parameters.baseTicks) >= dt_parameters.refreshTicks) {
+            refresh();
+            dt_ticks = __rdtsc();
+            dt_parameters = load();
+        }
+        return dt_parameters.nanoseconds(dt_ticks);
+    }
+
+private:
+    static constexpr std::int64_t dt_refreshNanoseconds = 500000000;
+    static constexpr double dt_maxSlew = 1000000.0;
+    
+    struct Parameters {
+        std::uint64_t baseTicks;
+        std::int64_t baseNanoseconds;
+        std::uint64_t scale;        // Nanoseconds per tick in 32.32 fixed point
+        std::int64_t refreshTicks;  // Ticks after baseTicks that trigger a refresh
+        
+        std::int64_t nanoseconds(std::uint64_t dt_ticks) const {
+            // Signed: another thread may have re-anchored just after this thread read the counter
+            const std::int64_t dt_delta = static_cast<std::int64_t>(dt_ticks - baseTicks);
+        #if defined(__SIZEOF_INT128__)
+            return baseNanoseconds + static_cast<std::int64_t>((static_cast<__int128>(dt_delta) * static_cast<__int128>(scale)) >> 32);
+        #else
+            return baseNanoseconds + static_cast<std::int64_t>(static_cast<double>(dt_delta) * static_cast<double>(scale) / 4294967296.0);
+        #endif
+        }
+    };
+    
+    bool dt_usable = false;
+    std::atomic<std::uint64_t> dt_sequence{0};
+    std::atomic<std::uint64_t> dt_baseTicks{0};
+    std::atomic<std::int64_t> dt_baseNanoseconds{0};
+    std::atomic<std::uint64_t> dt_scale{0};
+    std::atomic<std::int64_t> dt_refreshTicks{0};
+    
+    // Last system clock sample, owned by the thread holding dt_refreshing
+    std::atomic<bool> dt_refreshing{false};
+    std::uint64_t dt_anchorTicks = 0;
+    std::int64_t dt_anchorNanoseconds = 0;
+    
+    static std::int64_t systemNanoseconds() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    
+    DT_TscClock() {
+        // CPUID 0x80000007 EDX bit 8: invariant TSC
+        unsigned int dt_eax = 0, dt_ebx = 0, dt_ecx = 0, dt_edx = 0;
+        if (__get_cpuid(0x80000007, &dt_eax, &dt_ebx, &dt_ecx, &dt_edx) == 0 || (dt_edx & (1u << 8)) == 0) {
+            return;
+        }
+        
+        // Measure the counter against the system clock over a short busy-wait window
+        const std::int64_t dt_startTime = systemNanoseconds();
+        const std::uint64_t dt_startTicks = __rdtsc();
+        std::int64_t dt_endTime = dt_startTime;
+        while (dt_endTime - dt_startTime < 5000000) {
+            dt_endTime = systemNanoseconds();
+        }
+        const std::uint64_t dt_endTicks = __rdtsc();
+        if (dt_endTicks <= dt_startTicks) {
+            return;
+        }
+        const double dt_rate = static_cast<double>(dt_endTime - dt_startTime) / static_cast<double>(dt_endTicks - dt_startTicks);
+        dt_anchorTicks = dt_endTicks;
+        dt_anchorNanoseconds = dt_endTime;
+        store(Parameters{dt_endTicks, dt_endTime, toFixed(dt_rate), static_cast<std::int64_t>(dt_refreshNanoseconds / dt_rate)});
+        dt_usable = true;
+    }
+    
+    static std::uint64_t toFixed(double dt_rate) {
+        return static_cast<std::uint64_t>(dt_rate * 4294967296.0);
+    }
+    
+    Parameters load() const {
+        for (;;) {
+            const std::uint64_t dt_before = dt_sequence.load(std::memory_order_acquire);
+            if ((dt_before & 1) != 0) {
+                continue;
+            }
+            const Parameters dt_parameters{dt_baseTicks.load(std::memory_order_relaxed), dt_baseNanoseconds.load(std::memory_order_relaxed),
+                                           dt_scale.load(std::memory_order_relaxed), dt_refreshTicks.load(std::memory_order_relaxed)};
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (dt_sequence.load(std::memory_order_relaxed) == dt_before) {
+                return dt_parameters;
+            }
+        }
+    }
+    
+    // Single writer: the constructor, then the thread holding dt_refreshing
+    void store(const Parameters& dt_parameters) {
+        const std::uint64_t dt_before = dt_sequence.load(std::memory_order_relaxed);
+        dt_sequence.store(dt_before + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        dt_baseTicks.store(dt_parameters.baseTicks, std::memory_order_relaxed);
+        dt_baseNanoseconds.store(dt_parameters.baseNanoseconds, std::memory_order_relaxed);
+        dt_scale.store(dt_parameters.scale, std::memory_order_relaxed);
+        dt_refreshTicks.store(dt_parameters.refreshTicks, std::memory_order_relaxed);
+        dt_sequence.store(dt_before + 2, std::memory_order_release);
+    }
+    
+    void refresh() {
+        // Other readers keep using the current parameters while one thread refreshes
+        if (dt_refreshing.exchange(true, std::memory_order_acquire)) {
+            return;
+        }
+        const Parameters dt_current = load();
+        const std::int64_t dt_systemTime = systemNanoseconds();
+        const std::uint64_t dt_ticks = __rdtsc();
+        const std::int64_t dt_elapsedTicks = static_cast<std::int64_t>(dt_ticks - dt_anchorTicks);
+        const double dt_error = static_cast<double>(dt_systemTime - dt_current.nanoseconds(dt_ticks));
+        
+        Parameters dt_next{dt_ticks, dt_systemTime, dt_current.scale, dt_current.refreshTicks};
+        if (dt_elapsedTicks > 0 && std::abs(dt_error) < dt_maxSlew) {
+            // Rate over the whole period, adjusted to absorb the error by the next refresh
+            const double dt_rate = static_cast<double>(dt_systemTime - dt_anchorNanoseconds) / static_cast<double>(dt_elapsedTicks);
+            if (dt_rate > 0) {
+                dt_next.baseNanoseconds = dt_current.nanoseconds(dt_ticks);
+                dt_next.scale = toFixed(dt_rate * (static_cast<double>(dt_refreshNanoseconds) + dt_error) / static_cast<double>(dt_refreshNanoseconds));
+                dt_next.refreshTicks = static_cast<std::int64_t>(static_cast<double>(dt_refreshNanoseconds) / dt_rate);
+            }
+        }
+        dt_anchorTicks = dt_ticks;
+        dt_anchorNanoseconds = dt_systemTime;
+        store(dt_next);
+        dt_refreshing.store(false, std::memory_order_release);
+    }
+};
+#endif
+
+// Last decomposition made by this thread (used when field caching is enabled)
+struct DT_FieldMemo {
+    bool valid = false;
+    std::int64_t localSeconds = 0;
+    DateTime::Fields fields{};
+};
+thread_local DT_FieldMemo dt_fieldMemo;
+
+// Seconds since the epoch for a broken-down UTC time (replacement for timegm).
+// Fields outside their normal ranges are normalized the same way timegm does.
+std::int64_t dt_tmToSeconds(const std::tm& dt_timeStruct) {
+    const std::int64_t dt_days = DateTime::daysFromCivil(static_cast<std::int64_t>(dt_timeStruct.tm_year) + 1900,
+                                                  dt_timeStruct.tm_mon + 1, dt_timeStruct.tm_mday);
+    return dt_days * dt_secondsPerDay + dt_timeStruct.tm_hour * std::int64_t{3600} +
+           dt_timeStruct.tm_min * std::int64_t{60} + dt_timeStruct.tm_sec;
+}
+
+// Write a year with at least 4 digits (sign only for negative years)
+char* dt_writeYear(char* dt_out, int dt_year) {
+    if (dt_year >= 0 && dt_year <= 9999) {
+        dt_out = dt_write2(dt_out, dt_year / 100);
+        return dt_write2(dt_out, dt_year % 100);
+    }
+    return dt_writeSigned(dt_out, dt_year, 4);
+}
+
+// Copy a rendered standard format into the caller buffer
+std::to_chars_result dt_copyFormatted(const char* dt_begin, const char* dt_end, char* dt_first, char* dt_last) {
+    const std::size_t dt_length = static_cast<std::size_t>(dt_end - dt_begin);
+    if (dt_length > static_cast<std::size_t>(dt_last - dt_first)) {
+        return {dt_last, std::errc::value_too_large};
+    }
+    std::memcpy(dt_first, dt_begin, dt_length);
+    return {dt_first + dt_length, std::errc{}};
+}
+
+// Broken-down values collected while parsing
+struct DT_ParseState {
+    int year = 1900;
+    int month = 1;
+    int day = 1;
+    int hour = 0;
+    int minute = 0;
+    int second = 0;
+    std::int64_t nanosecond = 0;
+    std::int64_t offsetSeconds = 0;
+    int century = -1;
+    int yearOfCentury = -1;
+    int dayOfYear = 0;
+    bool hasMonthOrDay = false;
+    bool hasAmPm = false;
+    bool pm = false;
+    std::size_t datePosition = 0;  // Start of the last date field, reported for invalid dates
+};
+
+// Cursor over the parse input; the read functions record the failure reason and position
+struct DT_ParseCursor {
+    std::string_view input;
+    std::size_t position = 0;
+    DateTime::ParseError error = DateTime::ParseError::None;
+    
+    bool fail(DateTime::ParseError dt_error) {
+        error = dt_error;
+        return false;
+    }
+    
+    bool atEnd() const {
+        return position >= input.size();
+    }
+    
+    bool isDigitAt(std::size_t dt_index) const {
+        return dt_index < input.size() && input[dt_index] >= '0' && input[dt_index] <= '9';
+    }
+    
+    // Read between dt_minDigits and dt_maxDigits decimal digits
+    bool readNumber(int dt_minDigits, int dt_maxDigits, int& dt_value) {
+        dt_value = 0;
+        int dt_count = 0;
+        while (dt_count < dt_maxDigits && isDigitAt(position)) {
+            dt_value = dt_value * 10 + (input[position++] - '0');
+            ++dt_count;
+        }
+        if (dt_count < dt_minDigits) {
+            return fail(atEnd() ? DateTime::ParseError::UnexpectedEnd : DateTime::ParseError::ExpectedDigit);
+        }
+        return true;
+    }
+    
+    // Read a number and check its range; the error points at the start of the field
+    bool readField(int dt_minDigits, int dt_maxDigits, int dt_min, int dt_max, int& dt_value) {
+        const std::size_t dt_start = position;
+        if (!readNumber(dt_minDigits, dt_maxDigits, dt_value)) {
+            return false;
+        }
+        if (dt_value < dt_min || dt_value > dt_max) {
+            position = dt_start;
+            return fail(DateTime::ParseError::FieldOutOfRange);
+        }
+        return true;
+    }
+    
+    // Fraction digits scaled to nanoseconds; digits beyond the ninth are consumed and ignored
+    bool readFraction(int dt_minDigits, int dt_maxDigits, std::int64_t& dt_nanoseconds) {
+        std::int64_t dt_value = 0;
+        int dt_count = 0;
+        while (dt_count < dt_maxDigits && isDigitAt(position)) {
+            if (dt_count < 9) {
+                dt_value = dt_value * 10 + (input[position] - '0');
+            }
+            ++position;
+            ++dt_count;
+        }
+        if (dt_count < dt_minDigits) {
+            return fail(atEnd() ? DateTime::ParseError::UnexpectedEnd : DateTime::ParseError::ExpectedDigit);
+        }
+        for (int dt_index = dt_count; dt_index < 9; ++dt_index) {
+            dt_value *= 10;
+        }
+        dt_nanoseconds = dt_value;
+        return true;
+    }
+    
+    // Literal pattern text; whitespace in the pattern matches any run of whitespace (including none)
+    bool matchLiteral(char dt_expected) {
+        if (dt_expected == ' ' || dt_expected == '\t' || dt_expected == '\n') {
+            while (!atEnd() && std::isspace(static_cast<unsigned char>(input[position]))) {
+                ++position;
+            }
+            return true;
+        }
+        if (atEnd()) {
+            return fail(DateTime::ParseError::UnexpectedEnd);
+        }
+        if (input[position] != dt_expected) {
+            return fail(DateTime::ParseError::ExpectedLiteral);
+        }
+        ++position;
+        return true;
+    }
+    
+    // Case-insensitive full or three-letter name; dt_index receives the table index
+    bool readName(const char* const* dt_names, int dt_count, int& dt_index) {
+        for (int dt_candidate = 0; dt_candidate < dt_count; ++dt_candidate) {
+            const std::size_t dt_fullLength = std::strlen(dt_names[dt_candidate]);
+            for (std::size_t dt_length : {dt_fullLength, std::size_t{3}}) {
+                if (position + dt_length > input.size()) {
+                    continue;
+                }
+                bool dt_match = true;
+                for (std::size_t dt_char = 0; dt_char < dt_length && dt_match; ++dt_char) {
+                    dt_match = std::tolower(static_cast<unsigned char>(input[position + dt_char])) ==
+                               std::tolower(static_cast<unsigned char>(dt_names[dt_candidate][dt_char]));
+                }
+                if (dt_match) {
+                    position += dt_length;
+                    dt_index = dt_candidate;
+                    return true;
+                }
+            }
+        }
+        return fail(atEnd() ? DateTime::ParseError::UnexpectedEnd : DateTime::ParseError::UnknownName);
+    }
+    
+    // UTC offset: Z, +hh, +hhmm or +hh:mm (or with '-')
+    bool readOffset(std::int64_t& dt_offsetSeconds) {
+        if (atEnd()) {
+            return fail(DateTime::ParseError::UnexpectedEnd);
+        }
+        if (input[position] == 'Z' || input[position] == 'z') {
+            ++position;
+            dt_offsetSeconds = 0;
+            return true;
+        }
+        if (input[position] != '+' && input[position] != '-') {
+            return fail(DateTime::ParseError::ExpectedLiteral);
+        }
+        const bool dt_negative = input[position++] == '-';
+        int dt_hours = 0;
+        int dt_minutes = 0;
+        if (!readField(2, 2, 0, 23, dt_hours)) {
+            return false;
+        }
+        if (!atEnd() && input[position] == ':') {
+            ++position;
+            if (!readField(2, 2, 0, 59, dt_minutes)) {
+                return false;
+            }
+        } else if (isDigitAt(position) && !readField(2, 2, 0, 59, dt_minutes)) {
+            return false;
+        }
+        dt_offsetSeconds = (dt_hours * std::int64_t{3600} + dt_minutes * std::int64_t{60}) * (dt_negative ? -1 : 1);
+        return true;
+    }
+};
+
+DateTime::ParseResult dt_parseFailure(const DT_ParseCursor& dt_cursor) {
+    return {DateTime(std::chrono::system_clock::time_point{}), dt_cursor.error, dt_cursor.position};
+}
+
+// Validate the collected values and build the instant (UTC)
+DateTime::ParseResult dt_finishParse(DT_ParseState& dt_state, std::size_t dt_position) {
+    if (dt_state.yearOfCentury >= 0) {
+        const int dt_century = dt_state.century >= 0 ? dt_state.century : (dt_state.yearOfCentury < 69 ? 20 : 19);
+        dt_state.year = dt_century * 100 + dt_state.yearOfCentury;
+    } else if (dt_state.century >= 0) {
+        dt_state.year = dt_state.century * 100 + dt_state.year % 100;
+    }
+    if (dt_state.hasAmPm) {
+        dt_state.hour = dt_state.hour % 12 + (dt_state.pm ? 12 : 0);
+    }
+    
+    std::int64_t dt_days = 0;
+    if (dt_state.dayOfYear > 0 && !dt_state.hasMonthOrDay) {
+        if (dt_state.dayOfYear > (DateTime::isLeapYear(dt_state.year) ? 366 : 365) ||
+            dt_state.year < 1900 || dt_state.year > 9999) {
+            return {DateTime(std::chrono::system_clock::time_point{}), DateTime::ParseError::InvalidDate, dt_state.datePosition};
+        }
+        dt_days = DateTime::daysFromCivil(dt_state.year, 1, 1) + dt_state.dayOfYear - 1;
+    } else {
+        if (!DateTime::isValidDate(dt_state.year, dt_state.month, dt_state.day)) {
+            return {DateTime(std::chrono::system_clock::time_point{}), DateTime::ParseError::InvalidDate, dt_state.datePosition};
+        }
+        dt_days = DateTime::daysFromCivil(dt_state.year, dt_state.month, dt_state.day);
+    }
+    
+    const std::int64_t dt_seconds = dt_days * dt_secondsPerDay + dt_state.hour * std::int64_t{3600} +
+                                    dt_state.minute * std::int64_t{60} + dt_state.second - dt_state.offsetSeconds;
+    const auto dt_sinceEpoch = std::chrono::seconds(dt_seconds) + std::chrono::nanoseconds(dt_state.nanosecond);
+    return {DateTime(std::chrono::system_clock::time_point(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(dt_sinceEpoch))),
+            DateTime::ParseError::None, dt_position};
+}
+
+// Generic parser driven by compiled pattern operations
+DateTime::ParseResult dt_parseWithOps(std::string_view dt_input, const std::vector<DateTime::FormatOp>& dt_ops,
+                                      std::string_view dt_pattern, bool dt_allowTrailing) {
+    using Op = DateTime::FormatOpCode;
+    DT_ParseCursor dt_cursor{dt_input};
+    DT_ParseState dt_state;
+    int dt_ignored = 0;
+    
+    for (const DateTime::FormatOp& dt_op : dt_ops) {
+        bool dt_ok = true;
+        const std::size_t dt_fieldStart = dt_cursor.position;
+        switch (dt_op.code) {
+            case Op::Literal:
+                for (std::size_t dt_index = 0; dt_index < dt_op.length && dt_ok; ++dt_index) {
+                    dt_ok = dt_cursor.matchLiteral(dt_pattern[dt_op.offset + dt_index]);
+                }
+                break;
+            case Op::Char:
+                dt_ok = dt_cursor.matchLiteral(static_cast<char>(dt_op.offset));
+                break;
+            case Op::Year:
+                dt_ok = dt_cursor.readNumber(1, 4, dt_state.year);
+                dt_state.datePosition = dt_fieldStart;
+                break;
+            case Op::Century:
+                dt_ok = dt_cursor.readNumber(1, 2, dt_state.century);
+                dt_state.datePosition = dt_fieldStart;
+                break;
+            case Op::YearOfCentury:
+                dt_ok = dt_cursor.readNumber(1, 2, dt_state.yearOfCentury);
+                dt_state.datePosition = dt_fieldStart;
+                break;
+            case Op::Month:
+                dt_ok = dt_cursor.readField(1, 2, 1, 12, dt_state.month);
+                dt_state.hasMonthOrDay = true;
+                dt_state.datePosition = dt_fieldStart;
+                break;
+            case Op::DaySpacePadded:
+                dt_ok = dt_cursor.matchLiteral(' ');
+                [[fallthrough]];
+            case Op::Day:
+                dt_ok = dt_ok && dt_cursor.readField(1, 2, 1, 31, dt_state.day);
+                dt_state.hasMonthOrDay = true;
+                dt_state.datePosition = dt_fieldStart;
+                break;
+            case Op::Hour:
+                dt_ok = dt_cursor.readField(1, 2, 0, 23, dt_state.hour);
+                break;
+            case Op::Hour12:
+                dt_ok = dt_cursor.readField(1, 2, 1, 12, dt_state.hour);
+                break;
+            case Op::Minute:
+                dt_ok = dt_cursor.readField(1, 2, 0, 59, dt_state.minute);
+                break;
+            case Op::Second:
+                dt_ok = dt_cursor.readField(1, 2, 0, 59, dt_state.second);
+                break;
+            case Op::DayOfYear:
+                dt_ok = dt_cursor.readField(1, 3, 1, 366, dt_state.dayOfYear);
+                dt_state.datePosition = dt_fieldStart;
+                break;
+            case Op::WeekdayNumber:
+                dt_ok = dt_cursor.readField(1, 1, 0, 6, dt_ignored);
+                break;
+            case Op::IsoWeekdayNumber:
+                dt_ok = dt_cursor.readField(1, 1, 1, 7, dt_ignored);
+                break;
+            case Op::WeekdayShort:
+            case Op::WeekdayFull:
+                dt_ok = dt_cursor.readName(dt_weekdayNames, 7, dt_ignored);
+                break;
+            case Op::MonthShort:
+            case Op::MonthFull:
+                dt_ok = dt_cursor.readName(dt_monthNames, 12, dt_state.month);
+                dt_state.month += 1;
+                dt_state.hasMonthOrDay = true;
+                dt_state.datePosition = dt_fieldStart;
+                break;
+            case Op::AmPm: {
+                static constexpr const char* dt_amPm[] = {"AM", "PM"};
+                int dt_index = 0;
+                dt_ok = dt_cursor.readName(dt_amPm, 2, dt_index);
+                dt_state.hasAmPm = true;
+                dt_state.pm = dt_index == 1;
+                break;
+            }
+            case Op::Fraction:
+                // %f reads 1-9 digits, %Nf exactly N
+                dt_ok = dt_op.length != 3 ? dt_cursor.readFraction(1, 9, dt_state.nanosecond)
+                                          : dt_cursor.readFraction(dt_op.offset, dt_op.offset, dt_state.nanosecond);
+                break;
+            case Op::RegionOffset:
+                dt_ok = dt_cursor.readOffset(dt_state.offsetSeconds);
+                break;
+            case Op::RegionName:
+            case Op::Strftime:
+                // Rejected when the ParsePattern is compiled
+                break;
+        }
+        if (!dt_ok) {
+            return dt_parseFailure(dt_cursor);
+        }
+    }
+    
+    if (!dt_allowTrailing && !dt_cursor.atEnd()) {
+        dt_cursor.fail(DateTime::ParseError::TrailingCharacters);
+        return dt_parseFailure(dt_cursor);
+    }
+    return dt_finishParse(dt_state, dt_cursor.position);
+}
+
+// Bucketing (floorTo/ceilTo) on epoch milliseconds
+constexpr std::int64_t dt_millisecondsPerDay = dt_secondsPerDay * 1000;
+
+// First day (days since the epoch) of every month from 1600-01 to 2400-01, built once.
+// 400 Gregorian years are exactly 4800 months and 146097 days.
+struct DT_MonthStarts {
+    static constexpr int firstYear = 1600;
+    static constexpr std::size_t months = 800 * 12;
+    std::array<std::int64_t, months + 1> days;
+
+    static const DT_MonthStarts& instance() {
+        static const DT_MonthStarts dt_table = [] {
+            DT_MonthStarts dt_starts{};
+            for (std::size_t dt_index = 0; dt_index <= months; ++dt_index) {
+                dt_starts.days[dt_index] = DateTime::daysFromCivil(firstYear + static_cast<int>(dt_index / 12),
+                                                                   static_cast<int>(dt_index % 12) + 1, 1);
+            }
+            return dt_starts;
+        }();
+        return dt_table;
+    }
+};
+
+// [start, next) day range of the month, quarter or year containing dt_days
+void dt_periodBounds(std::int64_t dt_days, DateTime::TimeUnit dt_unit, std::int64_t& dt_start, std::int64_t& dt_next) {
+    const std::int64_t dt_span = dt_unit == DateTime::TimeUnit::Month ? 1 : dt_unit == DateTime::TimeUnit::Quarter ? 3 : 12;
+    const DT_MonthStarts& dt_table = DT_MonthStarts::instance();
+    if (dt_days >= dt_table.days.front() && dt_days < dt_table.days.back()) {
+        // Estimate the month from the mean month length, then correct by at most one
+        std::int64_t dt_month = (dt_days - dt_table.days.front()) * 4800 / 146097;
+        while (dt_table.days[dt_month] > dt_days) {
+            --dt_month;
+        }
+        while (dt_table.days[dt_month + 1] <= dt_days) {
+            ++dt_month;
+        }
+        dt_month -= dt_month % dt_span;
+        dt_start = dt_table.days[dt_month];
+        dt_next = dt_table.days[dt_month + dt_span];
+        return;
+    }
+    // Outside the table: the civil kernel
+    const DateTime::CivilDate dt_date = DateTime::civilFromDays(dt_days);
+    const std::int64_t dt_month = (dt_date.month - 1) - (dt_date.month - 1) % dt_span;
+    dt_start = DateTime::daysFromCivil(dt_date.year, static_cast<int>(dt_month) + 1, 1);
+    dt_next = DateTime::daysFromCivil(dt_date.year + static_cast<int>((dt_month + dt_span) / 12),
+                                      static_cast<int>((dt_month + dt_span) % 12) + 1, 1);
+}
+
+constexpr std::int64_t dt_unitMilliseconds(DateTime::TimeUnit dt_unit) {
+    switch (dt_unit) {
+        case DateTime::TimeUnit::Millisecond: return 1;
+        case DateTime::TimeUnit::Second: return 1000;
+        case DateTime::TimeUnit::Minute: return 60 * 1000;
+        case DateTime::TimeUnit::Hour: return 3600 * 1000;
+        case DateTime::TimeUnit::Day: return dt_millisecondsPerDay;
+        case DateTime::TimeUnit::Week: return 7 * dt_millisecondsPerDay;
+        default: return 0;  // Calendar units
+    }
+}
+
+// Fixed-size units: one floor division per value (the unit is a compile-time constant).
+// Weeks are shifted so that boundaries fall on Mondays (1970-01-05 was one).
+template <std::int64_t UnitMilliseconds, std::int64_t ShiftMilliseconds, bool Ceil>
+void dt_bucketFixed(const std::int64_t* dt_in, std::size_t dt_count, std::int64_t dt_offset, std::int64_t* dt_out) {
+    const std::int64_t dt_shift = dt_offset - ShiftMilliseconds;
+    for (std::size_t dt_index = 0; dt_index < dt_count; ++dt_index) {
+        const std::int64_t dt_local = dt_in[dt_index] + dt_shift;
+        std::int64_t dt_bucket = DateTime::floorDiv(dt_local, UnitMilliseconds) * UnitMilliseconds;
+        if (Ceil && dt_bucket != dt_local) {
+            dt_bucket += UnitMilliseconds;
+        }
+        dt_out[dt_index] = dt_bucket - dt_shift;
+    }
+}
+
+// Calendar units: the last period's bounds are reused while values stay inside it
+template <bool Ceil>
+void dt_bucketCalendar(const std::int64_t* dt_in, std::size_t dt_count, DateTime::TimeUnit dt_unit, std::int64_t dt_offset,
+                       std::int64_t* dt_out) {
+    std::int64_t dt_start = 0;
+    std::int64_t dt_next = 0;  // Empty range: the first value looks up its period
+    for (std::size_t dt_index = 0; dt_index < dt_count; ++dt_index) {
+        const std::int64_t dt_local = dt_in[dt_index] + dt_offset;
+        if (dt_local < dt_start * dt_millisecondsPerDay || dt_local >= dt_next * dt_millisecondsPerDay) {
+            dt_periodBounds(DateTime::floorDiv(dt_local, dt_millisecondsPerDay), dt_unit, dt_start, dt_next);
+        }
+        std::int64_t dt_bucket = dt_start * dt_millisecondsPerDay;
+        if (Ceil && dt_bucket != dt_local) {
+            dt_bucket = dt_next * dt_millisecondsPerDay;
+        }
+        dt_out[dt_index] = dt_bucket - dt_offset;
+    }
+}
+
+template <bool Ceil>
+void dt_bucketValues(const std::int64_t* dt_in, std::size_t dt_count, DateTime::TimeUnit dt_unit, std::int64_t dt_offset,
+               std::int64_t* dt_out) {
+    constexpr std::int64_t dt_mondayShift = 4 * dt_millisecondsPerDay;
+    switch (dt_unit) {
+        case DateTime::TimeUnit::Millisecond:
+            std::copy(dt_in, dt_in + dt_count, dt_out);
+            return;
+        case DateTime::TimeUnit::Second:
+            return dt_bucketFixed<dt_unitMilliseconds(DateTime::TimeUnit::Second), 0, Ceil>(dt_in, dt_count, dt_offset, dt_out);
+        case DateTime::TimeUnit::Minute:
+            return dt_bucketFixed<dt_unitMilliseconds(DateTime::TimeUnit::Minute), 0, Ceil>(dt_in, dt_count, dt_offset, dt_out);
+        case DateTime::TimeUnit::Hour:
+            return dt_bucketFixed<dt_unitMilliseconds(DateTime::TimeUnit::Hour), 0, Ceil>(dt_in, dt_count, dt_offset, dt_out);
+        case DateTime::TimeUnit::Day:
+            return dt_bucketFixed<dt_unitMilliseconds(DateTime::TimeUnit::Day), 0, Ceil>(dt_in, dt_count, dt_offset, dt_out);
+        case DateTime::TimeUnit::Week:
+            return dt_bucketFixed<dt_unitMilliseconds(DateTime::TimeUnit::Week), dt_mondayShift, Ceil>(dt_in, dt_count, dt_offset, dt_out);
+        case DateTime::TimeUnit::Month:
+        case DateTime::TimeUnit::Quarter:
+        case DateTime::TimeUnit::Year:
+            return dt_bucketCalendar<Ceil>(dt_in, dt_count, dt_unit, dt_offset, dt_out);
+    }
+}
+
+// Bucket in the local time of a region. Zone regions shift each value by its own offset, bucket
+// the local values, and map each boundary back with the value's offset where that is consistent
+// (keeping the same side of a repeated hour), otherwise with DateTimeZone::offsetForLocal.
+template <bool Ceil>
+void dt_bucketInRegion(const std::int64_t* dt_in, std::size_t dt_count, DateTime::TimeUnit dt_unit,
+                       DateTime::RegionHandle dt_region, std::int64_t* dt_out) {
+    const DT_RegionRegistry::Entry& dt_entry = DT_RegionRegistry::instance().entry(dt_region);
+    const DateTimeZone* dt_zone = dt_entry.region.zone.get();
+    if (dt_zone == nullptr) {
+        dt_bucketValues<Ceil>(dt_in, dt_count, dt_unit, dt_entry.offsetSeconds * 1000, dt_out);
+        return;
+    }
+    constexpr std::size_t dt_blockRows = 256;
+    std::int64_t dt_offsets[dt_blockRows];
+    for (std::size_t dt_start = 0; dt_start < dt_count; dt_start += dt_blockRows) {
+        const std::size_t dt_rows = std::min(dt_blockRows, dt_count - dt_start);
+        std::int64_t* dt_block = dt_out + dt_start;
+        for (std::size_t dt_index = 0; dt_index < dt_rows; ++dt_index) {
+            const std::int64_t dt_value = dt_in[dt_start + dt_index];
+            dt_offsets[dt_index] = dt_zone->offsetAt(DateTime::floorDiv(dt_value, 1000)) * std::int64_t{1000};
+            dt_block[dt_index] = dt_value + dt_offsets[dt_index];
+        }
+        dt_bucketValues<Ceil>(dt_block, dt_rows, dt_unit, 0, dt_block);
+        for (std::size_t dt_index = 0; dt_index < dt_rows; ++dt_index) {
+            const std::int64_t dt_local = dt_block[dt_index];
+            const std::int64_t dt_own = dt_local - dt_offsets[dt_index];
+            dt_block[dt_index] = dt_zone->offsetAt(DateTime::floorDiv(dt_own, 1000)) * std::int64_t{1000} == dt_offsets[dt_index]
+                                     ? dt_own
+                                     : dt_local - dt_zone->offsetForLocal(DateTime::floorDiv(dt_local, 1000)) * std::int64_t{1000};
+        }
+    }
+}
+
+} // namespace
+
 // Use common prefix (dt_) for all variable names and methods
-DateTime::DateTime() : dt_clockPoint(std::chrono::system_clock::now()), dt_timeRegion(WorldTime) {}
+DateTime::DateTime() : dt_clockPoint(std::chrono::system_clock::now()), dt_regionHandle(RegionHandle::World) {}
 
-DateTime::DateTime(const std::chrono::system_clock::time_point& dt_time) : dt_clockPoint(dt_time), dt_timeRegion(WorldTime) {}
 
 
 // Constructor with region time specification
 DateTime::DateTime(int dt_year, int dt_month, int dt_day, 
                     int dt_hour, int dt_minute, int dt_second, int dt_millisecond, 
-                    const RegionTime& dt_region) : dt_timeRegion(dt_region) 
+                    const RegionTime& dt_region) : dt_regionHandle(internRegion(dt_region)) 
 {
-    std::tm dt_timeStruct{};
-    dt_timeStruct.tm_year = dt_year - 1900;
-    dt_timeStruct.tm_mon = dt_month - 1;
-    dt_timeStruct.tm_mday = dt_day;
-    dt_timeStruct.tm_hour = dt_hour;
-    dt_timeStruct.tm_min = dt_minute;
-    dt_timeStruct.tm_sec = dt_second;
-    
-    // Interpret the specified time as region time
-    std::time_t dt_timeValue = timegm(&dt_timeStruct);
+    if (!isValidDate(dt_year, dt_month, dt_day) || !isValidTime(dt_hour, dt_minute, dt_second, dt_millisecond)) {
+        throwInvalidDateTime(dt_year, dt_month, dt_day, dt_hour, dt_minute, dt_second, std::chrono::milliseconds(dt_millisecond));
+    }
     
-    // Reverse apply the region time offset to convert to UTC-based time point
-    std::time_t dt_offsetSeconds = -1 * (dt_region.hourOffset * 3600 + dt_region.minuteOffset * 60);
-    dt_timeValue += dt_offsetSeconds;
+    // Interpret the specified time as region time and reverse apply the region offset
+    dt_clockPoint = composeTimePoint(dt_year, dt_month, dt_day, dt_hour, dt_minute, dt_second,
+                                     std::chrono::milliseconds(dt_millisecond),
+                                     getRegionOffsetSecondsForLocal(daysFromCivil(dt_year, dt_month, dt_day) * dt_secondsPerDay +
+                                                                    dt_hour * 3600 + dt_minute * 60 + dt_second));
+}
+
+DateTime::DateTime(int dt_year, int dt_month, int dt_day, 
+                    int dt_hour, int dt_minute, int dt_second, std::chrono::nanoseconds dt_fraction, 
+                    const RegionTime& dt_region) : dt_regionHandle(internRegion(dt_region)) 
+{
+    if (!isValidDate(dt_year, dt_month, dt_day) || !isValidTime(dt_hour, dt_minute, dt_second, dt_fraction)) {
+        throwInvalidDateTime(dt_year, dt_month, dt_day, dt_hour, dt_minute, dt_second, dt_fraction);
+    }
     
-    // Convert adjusted time to time point
-    dt_clockPoint = std::chrono::system_clock::from_time_t(dt_timeValue);
-    dt_clockPoint += std::chrono::milliseconds(dt_millisecond);
+    dt_clockPoint = composeTimePoint(dt_year, dt_month, dt_day, dt_hour, dt_minute, dt_second, dt_fraction,
+                                     getRegionOffsetSecondsForLocal(daysFromCivil(dt_year, dt_month, dt_day) * dt_secondsPerDay +
+                                                                    dt_hour * 3600 + dt_minute * 60 + dt_second));
+}
+
+void DateTime::throwInvalidDateTime(int dt_year, int dt_month, int dt_day,
+                                    int dt_hour, int dt_minute, int dt_second, std::chrono::nanoseconds dt_fraction) {
+    throw DateTimeException("Invalid date/time specified: " + 
+                           std::to_string(dt_year) + "-" + 
+                           std::to_string(dt_month) + "-" + 
+                           std::to_string(dt_day) + " " +
+                           std::to_string(dt_hour) + ":" + 
+                           std::to_string(dt_minute) + ":" + 
+                           std::to_string(dt_second) + " +" +
+                           std::to_string(dt_fraction.count()) + "ns");
 }
 
 DateTime::DateTime(const std::chrono::system_clock::time_point& dt_time, const RegionTime& dt_region) 
-    : dt_clockPoint(dt_time), dt_timeRegion(dt_region) {}
+    : dt_clockPoint(dt_time), dt_regionHandle(internRegion(dt_region)) {}
+
 
 std::shared_ptr<DateTime> DateTime::current() {
     return std::make_shared<DateTime>(std::chrono::system_clock::now(), WorldTime);
@@ -60,20 +1180,59 @@ std::shared_ptr<DateTime> DateTime::current(const RegionTime& dt_region) {
     return std::make_shared<DateTime>(std::chrono::system_clock::now(), dt_region);
 }
 
+std::chrono::system_clock::time_point DateTime::nowTimePoint(ClockSource dt_source) {
+    switch (dt_source) {
+        case ClockSource::Coarse: {
+        #if defined(__linux__) && defined(CLOCK_REALTIME_COARSE)
+            timespec dt_spec{};
+            if (clock_gettime(CLOCK_REALTIME_COARSE, &dt_spec) == 0) {
+                return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                    std::chrono::seconds(dt_spec.tv_sec) + std::chrono::nanoseconds(dt_spec.tv_nsec)));
+            }
+        #endif
+            break;
+        }
+        case ClockSource::Tsc: {
+        #if defined(DATETIME_HAS_TSC)
+            if (const std::optional<std::int64_t> dt_nanoseconds = DT_TscClock::instance().nanoseconds()) {
+                return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                    std::chrono::nanoseconds(*dt_nanoseconds)));
+            }
+        #endif
+            break;
+        }
+        case ClockSource::Precise:
+            break;
+    }
+    return std::chrono::system_clock::now();
+}
+
+DateTime DateTime::now(ClockSource dt_source) {
+    return DateTime(nowTimePoint(dt_source), RegionHandle::World);
+}
+
+DateTime DateTime::now(RegionHandle dt_regionHandle, ClockSource dt_source) {
+    return DateTime(nowTimePoint(dt_source), dt_regionHandle);
+}
+
+DateTime DateTime::now(const RegionTime& dt_region, ClockSource dt_source) {
+    return DateTime(nowTimePoint(dt_source), internRegion(dt_region));
+}
+
 // Thread-safe tm struct retrieval function
 std::tm DateTime::getThreadSafeTime(const std::time_t& dt_timeValue, bool dt_useLocalTime) const {
     std::tm dt_timeStruct{};
-    std::lock_guard<std::mutex> dt_lock(dt_timeMutex);  // Using static member instead of global
     
     #if defined(__linux__) || defined(__APPLE__)
-        // Use thread-safe version on Linux/Mac
+        // Use reentrant version on Linux/Mac (no locking required)
         if (dt_useLocalTime) {
             localtime_r(&dt_timeValue, &dt_timeStruct);
         } else {
             gmtime_r(&dt_timeValue, &dt_timeStruct);
         }
     #else
-        // On other platforms like Windows, protect with mutex
+        // On other platforms like Windows, protect the shared static buffer with mutex
+        std::lock_guard<std::mutex> dt_lock(dt_timeMutex);  // Using static member instead of global
         if (dt_useLocalTime) {
             dt_timeStruct = *std::localtime(&dt_timeValue);
         } else {
@@ -101,39 +1260,6 @@ std::time_t DateTime::getLocalTimeOffset() const {
     #endif
 }
 
-// Date validity verification function
-bool DateTime::isValidDate(int dt_year, int dt_month, int dt_day) {
-    if (dt_month < 1 || dt_month > 12 || dt_day < 1)
-        return false;
-        
-    // Date validation using C++20 calendar type
-    try {
-        if (dt_year < 1900 || dt_year > 9999) return false;
-        
-        // Calculate the last day of each month
-        const int dt_daysInMonth[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-        int dt_maxDay = dt_daysInMonth[dt_month];
-        
-        // February has 29 days in leap years
-        if (dt_month == 2) {
-            bool dt_isLeap = (dt_year % 4 == 0) && ((dt_year % 100 != 0) || (dt_year % 400 == 0));
-            if (dt_isLeap) dt_maxDay = 29;
-        }
-        
-        return dt_day <= dt_maxDay;
-    }
-    catch (const std::exception&) {
-        return false;
-    }
-}
-
-bool DateTime::isValidTime(int dt_hour, int dt_minute, int dt_second, int dt_millisecond) {
-    return dt_hour >= 0 && dt_hour < 24 &&
-           dt_minute >= 0 && dt_minute < 60 &&
-           dt_second >= 0 && dt_second < 60 &&
-           dt_millisecond >= 0 && dt_millisecond < 1000;
-}
-
 // Add validation when setting date/time
 void DateTime::setDate(int dt_year, int dt_month, int dt_day) {
     // Date validity verification
@@ -150,10 +1276,10 @@ void DateTime::setDate(int dt_year, int dt_month, int dt_day) {
     dt_timeStruct.tm_mday = dt_day;
     
     // Interpret the specified time as region time
-    std::time_t dt_timeValue = timegm(&dt_timeStruct);
+    std::time_t dt_timeValue = static_cast<std::time_t>(dt_tmToSeconds(dt_timeStruct));
     
     // Reverse apply the region time offset to convert to UTC-based time point
-    std::time_t dt_offsetSeconds = -1 * (dt_timeRegion.hourOffset * 3600 + dt_timeRegion.minuteOffset * 60);
+    std::time_t dt_offsetSeconds = -getRegionOffsetSecondsForLocal(dt_timeValue);
     dt_timeValue += dt_offsetSeconds;
     
     // Convert adjusted time to time point
@@ -170,89 +1296,217 @@ void DateTime::setTime(int dt_hour, int dt_minute, int dt_second, int dt_millise
                                std::to_string(dt_millisecond));
     }
     
+    setTime(dt_hour, dt_minute, dt_second, std::chrono::milliseconds(dt_millisecond));
+}
+
+void DateTime::setTime(int dt_hour, int dt_minute, int dt_second, std::chrono::nanoseconds dt_fraction) {
+    // Time validity verification (fraction must be within one second)
+    if (!isValidTime(dt_hour, dt_minute, dt_second, dt_fraction)) {
+        throw DateTimeException("Invalid time specified: " + 
+                               std::to_string(dt_hour) + ":" + 
+                               std::to_string(dt_minute) + ":" + 
+                               std::to_string(dt_second) + " +" +
+                               std::to_string(dt_fraction.count()) + "ns");
+    }
+    
     std::tm dt_timeStruct = getRegionAdjustedTime();
     dt_timeStruct.tm_hour = dt_hour;
     dt_timeStruct.tm_min = dt_minute;
     dt_timeStruct.tm_sec = dt_second;
     
     // Interpret the specified time as region time
-    std::time_t dt_timeValue = timegm(&dt_timeStruct);
+    std::time_t dt_timeValue = static_cast<std::time_t>(dt_tmToSeconds(dt_timeStruct));
     
     // Reverse apply the region time offset to convert to UTC-based time point
-    std::time_t dt_offsetSeconds = -1 * (dt_timeRegion.hourOffset * 3600 + dt_timeRegion.minuteOffset * 60);
+    std::time_t dt_offsetSeconds = -getRegionOffsetSecondsForLocal(dt_timeValue);
     dt_timeValue += dt_offsetSeconds;
     
     // Convert adjusted time to time point
     dt_clockPoint = std::chrono::system_clock::from_time_t(dt_timeValue);
     
-    // Add milliseconds
-    dt_clockPoint += std::chrono::milliseconds(dt_millisecond);
+    // Add the sub-second fraction
+    dt_clockPoint += std::chrono::duration_cast<std::chrono::system_clock::duration>(dt_fraction);
 }
 
 void DateTime::setRegion(const RegionTime& dt_region) {
-    dt_timeRegion = dt_region;
+    dt_regionHandle = internRegion(dt_region);
 }
 
 const DateTime::RegionTime& DateTime::getRegion() const {
-    return dt_timeRegion;
+    return regionFromHandle(dt_regionHandle);
+}
+
+DateTime::RegionHandle DateTime::getRegionHandle() const {
+    return dt_regionHandle;
+}
+
+DateTime DateTime::floorTo(TimeUnit dt_unit) const {
+    // Unit boundaries are whole milliseconds, so flooring the millisecond count is enough
+    const std::int64_t dt_milliseconds = getTimePoint<std::chrono::milliseconds>().time_since_epoch().count();
+    std::int64_t dt_bucket = 0;
+    dt_bucketInRegion<false>(&dt_milliseconds, 1, dt_unit, dt_regionHandle, &dt_bucket);
+    return DateTime(std::chrono::system_clock::time_point(std::chrono::milliseconds(dt_bucket)), dt_regionHandle);
+}
+
+DateTime DateTime::floorTo(TimeUnit dt_unit, RegionHandle dt_region) const {
+    return convertToRegion(dt_region).floorTo(dt_unit);
+}
+
+DateTime DateTime::ceilTo(TimeUnit dt_unit) const {
+    // A sub-millisecond remainder moves the search to the next millisecond
+    const auto dt_floored = getTimePoint<std::chrono::milliseconds>();
+    const std::int64_t dt_milliseconds = dt_floored.time_since_epoch().count() + (dt_floored == dt_clockPoint ? 0 : 1);
+    std::int64_t dt_bucket = 0;
+    dt_bucketInRegion<true>(&dt_milliseconds, 1, dt_unit, dt_regionHandle, &dt_bucket);
+    return DateTime(std::chrono::system_clock::time_point(std::chrono::milliseconds(dt_bucket)), dt_regionHandle);
+}
+
+DateTime DateTime::ceilTo(TimeUnit dt_unit, RegionHandle dt_region) const {
+    return convertToRegion(dt_region).ceilTo(dt_unit);
+}
+
+void DateTime::floorTo(const std::int64_t* dt_epochMilliseconds, std::size_t dt_count, TimeUnit dt_unit,
+                       RegionHandle dt_region, std::int64_t* dt_out) {
+    dt_bucketInRegion<false>(dt_epochMilliseconds, dt_count, dt_unit, dt_region, dt_out);
+}
+
+void DateTime::ceilTo(const std::int64_t* dt_epochMilliseconds, std::size_t dt_count, TimeUnit dt_unit,
+                      RegionHandle dt_region, std::int64_t* dt_out) {
+    dt_bucketInRegion<true>(dt_epochMilliseconds, dt_count, dt_unit, dt_region, dt_out);
+}
+
+std::chrono::seconds DateTime::getUtcOffset() const {
+    return std::chrono::seconds(getRegionOffsetSeconds());
+}
+
+DateTime::RegionHandle DateTime::internRegion(const RegionTime& dt_region) {
+    return DT_RegionRegistry::instance().intern(dt_region);
+}
+
+const DateTime::RegionTime& DateTime::regionFromHandle(RegionHandle dt_regionHandle) {
+    DT_RegionRegistry& dt_registry = DT_RegionRegistry::instance();
+    if (static_cast<std::uint32_t>(dt_regionHandle) >= dt_registry.size()) {
+        throw DateTimeException("Unknown region handle: " + std::to_string(static_cast<std::uint32_t>(dt_regionHandle)));
+    }
+    return dt_registry.entry(dt_regionHandle).region;
 }
 
 DateTime DateTime::convertToRegion(const RegionTime& dt_targetRegion) const {
+    return DateTime(dt_clockPoint, internRegion(dt_targetRegion));
+}
+
+DateTime DateTime::convertToRegion(RegionHandle dt_targetRegion) const {
     return DateTime(dt_clockPoint, dt_targetRegion);
 }
 
-// Thread-safe RegionAdjustedTime implementation
+std::int64_t DateTime::getRegionOffsetSeconds() const {
+    const DT_RegionRegistry::Entry& dt_entry = DT_RegionRegistry::instance().entry(dt_regionHandle);
+    if (dt_entry.region.zone) {
+        return dt_entry.region.zone->offsetAt(std::chrono::floor<std::chrono::seconds>(dt_clockPoint.time_since_epoch()).count());
+    }
+    return dt_entry.offsetSeconds;
+}
+
+std::int64_t DateTime::getRegionOffsetSecondsForLocal(std::int64_t dt_localSeconds) const {
+    const DT_RegionRegistry::Entry& dt_entry = DT_RegionRegistry::instance().entry(dt_regionHandle);
+    if (dt_entry.region.zone) {
+        return dt_entry.region.zone->offsetForLocal(dt_localSeconds);
+    }
+    return dt_entry.offsetSeconds;
+}
+
+std::optional<DateTime::RegionTime> DateTime::getRegionFromTZDB(const std::string& dt_tzName) {
+    try {
+        std::shared_ptr<const DateTimeZone> dt_zone = DateTimeZone::load(dt_tzName);
+        const std::int32_t dt_standard = dt_zone->standardOffset();
+        return RegionTime(dt_tzName, dt_standard / 3600, dt_standard % 3600 / 60, std::move(dt_zone));
+    } catch (const DateTimeException&) {
+        return std::nullopt;
+    }
+}
+
+// Lock-free RegionAdjustedTime implementation using the integer civil kernel
 std::tm DateTime::getRegionAdjustedTime() const {
-    std::time_t dt_timeValue = std::chrono::system_clock::to_time_t(dt_clockPoint);
-    std::tm dt_timeStruct = getThreadSafeTime(dt_timeValue, false); // Get based on UTC
+    // Floor to whole seconds so that instants before the epoch are decomposed correctly
+    std::int64_t dt_seconds = std::chrono::floor<std::chrono::seconds>(dt_clockPoint.time_since_epoch()).count();
     
     // Apply region time offset
-    std::time_t dt_regionOffsetValue = dt_timeRegion.hourOffset * 3600 + dt_timeRegion.minuteOffset * 60;
-    dt_timeValue += dt_regionOffsetValue;
-    dt_timeStruct = getThreadSafeTime(dt_timeValue, false);
+    dt_seconds += getRegionOffsetSeconds();
     
-    return dt_timeStruct;
+    return dt_secondsToTm(dt_seconds);
+}
+
+DateTime::Fields DateTime::fields() const {
+    const auto dt_sinceEpoch = dt_clockPoint.time_since_epoch();
+    const auto dt_utcSeconds = std::chrono::floor<std::chrono::seconds>(dt_sinceEpoch);
+    const std::int64_t dt_nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(dt_sinceEpoch - dt_utcSeconds).count();
+    const std::int64_t dt_localSeconds = dt_utcSeconds.count() + getRegionOffsetSeconds();
+    
+    Fields dt_fields{};
+    if (dt_fieldCaching.load(std::memory_order_relaxed)) {
+        DT_FieldMemo& dt_memo = dt_fieldMemo;
+        if (!dt_memo.valid || dt_memo.localSeconds != dt_localSeconds) {
+            dt_memo.fields = dt_secondsToFields(dt_localSeconds);
+            dt_memo.localSeconds = dt_localSeconds;
+            dt_memo.valid = true;
+        }
+        dt_fields = dt_memo.fields;
+    } else {
+        dt_fields = dt_secondsToFields(dt_localSeconds);
+    }
+    
+    dt_fields.nanosecond = static_cast<int>(dt_nanoseconds);
+    dt_fields.millisecond = static_cast<int>(dt_nanoseconds / 1000000);
+    return dt_fields;
+}
+
+void DateTime::setFieldCaching(bool dt_enabled) {
+    dt_fieldCaching.store(dt_enabled, std::memory_order_relaxed);
+}
+
+bool DateTime::isFieldCachingEnabled() {
+    return dt_fieldCaching.load(std::memory_order_relaxed);
 }
 
 int DateTime::getYear() const {
-    std::tm dt_timeStruct = getRegionAdjustedTime();
-    return dt_timeStruct.tm_year + 1900;
+    return fields().year;
 }
 
 int DateTime::getMonth() const {
-    std::tm dt_timeStruct = getRegionAdjustedTime();
-    return dt_timeStruct.tm_mon + 1;
+    return fields().month;
 }
 
 int DateTime::getDay() const {
-    std::tm dt_timeStruct = getRegionAdjustedTime();
-    return dt_timeStruct.tm_mday;
+    return fields().day;
 }
 
 int DateTime::getHour() const {
-    std::tm dt_timeStruct = getRegionAdjustedTime();
-    return dt_timeStruct.tm_hour;
+    return fields().hour;
 }
 
 int DateTime::getMinute() const {
-    std::tm dt_timeStruct = getRegionAdjustedTime();
-    return dt_timeStruct.tm_min;
+    return fields().minute;
 }
 
 int DateTime::getSecond() const {
-    std::tm dt_timeStruct = getRegionAdjustedTime();
-    return dt_timeStruct.tm_sec;
+    return fields().second;
 }
 
 int DateTime::getMillisecond() const {
-    // Milliseconds cannot be directly retrieved from the standard library, so calculate them
-    auto dt_duration = dt_clockPoint.time_since_epoch();
-    auto dt_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(dt_duration);
-    return static_cast<int>(dt_milliseconds.count() % 1000);
+    // Floor so that instants before the epoch still yield 0-999
+    return static_cast<int>(getFraction<std::chrono::milliseconds>().count());
+}
+
+int DateTime::getMicrosecond() const {
+    return static_cast<int>(getFraction<std::chrono::microseconds>().count());
 }
+
+int DateTime::getNanosecond() const {
+    return static_cast<int>(getFraction<std::chrono::nanoseconds>().count());
+}
+
 int DateTime::getDayOfWeek() const {
-    std::tm dt_timeStruct = getRegionAdjustedTime();
-    return dt_timeStruct.tm_wday; // 0=Sunday, 6=Saturday
+    return fields().dayOfWeek; // 0=Sunday, 6=Saturday
 }
 
 // Modified version of plusYears method
@@ -263,11 +1517,11 @@ DateTime DateTime::plusYears(int dt_years) const {
     // Add years
     dt_timeStruct.tm_year += dt_years;
     
-    // Convert to UTC-based time (using timegm instead of mktime)
-    std::time_t dt_timeValue = timegm(&dt_timeStruct);
+    // Convert to UTC-based time (using the integer civil kernel instead of mktime)
+    std::time_t dt_timeValue = static_cast<std::time_t>(dt_tmToSeconds(dt_timeStruct));
     
     // Reverse apply the region time offset to convert to UTC-based time point
-    std::time_t dt_offsetSeconds = -1 * (dt_timeRegion.hourOffset * 3600 + dt_timeRegion.minuteOffset * 60);
+    std::time_t dt_offsetSeconds = -getRegionOffsetSecondsForLocal(dt_timeValue);
     dt_timeValue += dt_offsetSeconds;
     
     // Convert adjusted time to time point
@@ -275,7 +1529,7 @@ DateTime DateTime::plusYears(int dt_years) const {
         std::chrono::system_clock::from_time_t(dt_timeValue);
     
     // Return new DateTime object (preserving region time info)
-    return DateTime(dt_newTimePoint, dt_timeRegion);
+    return DateTime(dt_newTimePoint, dt_regionHandle);
 }
 
 // Modified version of plusMonths method
@@ -309,8 +1563,7 @@ DateTime DateTime::plusMonths(int dt_months) const {
     if (dt_newMonth == 1) { // February
         dt_maxDay = 28;
         // Leap year check
-        int dt_year = dt_newYear + 1900;
-        if ((dt_year % 4 == 0 && dt_year % 100 != 0) || dt_year % 400 == 0) {
+        if (isLeapYear(dt_newYear + 1900)) {
             dt_maxDay = 29;
         }
     } else if (dt_newMonth == 3 || dt_newMonth == 5 || 
@@ -324,10 +1577,10 @@ DateTime DateTime::plusMonths(int dt_months) const {
     dt_timeStruct.tm_mday = std::min(dt_originalDay, dt_maxDay);
     
     // Convert to UTC-based time
-    std::time_t dt_timeValue = timegm(&dt_timeStruct);
+    std::time_t dt_timeValue = static_cast<std::time_t>(dt_tmToSeconds(dt_timeStruct));
     
     // Reverse apply the region time offset to convert to UTC-based time point
-    std::time_t dt_offsetSeconds = -1 * (dt_timeRegion.hourOffset * 3600 + dt_timeRegion.minuteOffset * 60);
+    std::time_t dt_offsetSeconds = -getRegionOffsetSecondsForLocal(dt_timeValue);
     dt_timeValue += dt_offsetSeconds;
     
     // Convert adjusted time to time point
@@ -335,166 +1588,418 @@ DateTime DateTime::plusMonths(int dt_months) const {
         std::chrono::system_clock::from_time_t(dt_timeValue);
     
     // Return new DateTime object
-    return DateTime(dt_newTimePoint, dt_timeRegion);
+    return DateTime(dt_newTimePoint, dt_regionHandle);
 }
 
-DateTime DateTime::plusDays(int dt_days) const {
-    std::chrono::system_clock::time_point dt_newTime = dt_clockPoint + std::chrono::hours(24 * dt_days);
-    return DateTime(dt_newTime, dt_timeRegion);
+DateTime::FormatPattern::FormatPattern(std::string_view dt_pattern) : dt_pattern(dt_pattern) {
+    const char* dt_error = compile(this->dt_pattern, [this](const FormatOp& dt_op) { dt_ops.push_back(dt_op); });
+    if (dt_error != nullptr) {
+        throw DateTimeException(std::string("Invalid format pattern: ") + dt_error);
+    }
+    
+    // Lay out patterns made only of literal text, two-digit fields (%Y being two of them) and fractions
+    for (const FormatOp& dt_op : dt_ops) {
+        const auto dt_position = static_cast<std::uint16_t>(dt_layout.size());
+        switch (dt_op.code) {
+            case FormatOpCode::Literal:
+                dt_layout.append(this->dt_pattern, dt_op.offset, dt_op.length);
+                continue;
+            case FormatOpCode::Char:
+                dt_layout += static_cast<char>(dt_op.offset);
+                continue;
+            case FormatOpCode::Year:
+                dt_layoutFields.push_back(LayoutField{dt_position, FormatOpCode::Century, 2});
+                dt_layoutFields.push_back(LayoutField{static_cast<std::uint16_t>(dt_position + 2), FormatOpCode::YearOfCentury, 2});
+                dt_layout += "0000";
+                continue;
+            case FormatOpCode::Century:
+            case FormatOpCode::YearOfCentury:
+            case FormatOpCode::Month:
+            case FormatOpCode::Day:
+            case FormatOpCode::Hour:
+            case FormatOpCode::Minute:
+            case FormatOpCode::Second:
+                dt_layoutFields.push_back(LayoutField{dt_position, dt_op.code, 2});
+                dt_layout += "00";
+                continue;
+            case FormatOpCode::Fraction:
+                dt_layoutFields.push_back(LayoutField{dt_position, dt_op.code, static_cast<std::uint8_t>(dt_op.offset)});
+                dt_layout.append(dt_op.offset, '0');
+                continue;
+            default:
+                break;
+        }
+        dt_layout.clear();
+        dt_layoutFields.clear();
+        break;
+    }
 }
 
-DateTime DateTime::plusHours(int dt_hours) const {
-    std::chrono::system_clock::time_point dt_newTime = dt_clockPoint + std::chrono::hours(dt_hours);
-    return DateTime(dt_newTime, dt_timeRegion);
+std::string DateTime::toString(const FormatPattern& dt_pattern) const {
+    // Render on the stack and allocate the result once at its final size
+    char dt_text[256];
+    const std::to_chars_result dt_rendered = formatTo(dt_text, dt_text + sizeof(dt_text), dt_pattern);
+    if (dt_rendered.ec == std::errc{}) {
+        return std::string(dt_text, dt_rendered.ptr);
+    }
+    std::string dt_result;
+    dt_result.reserve(dt_pattern.pattern().size() + 16);
+    formatTo(std::back_inserter(dt_result), dt_pattern);
+    return dt_result;
 }
 
-DateTime DateTime::plusMinutes(int dt_minutes) const {
-    std::chrono::system_clock::time_point dt_newTime = dt_clockPoint + std::chrono::minutes(dt_minutes);
-    return DateTime(dt_newTime, dt_timeRegion);
+std::string_view DateTime::formatOperation(const FormatOp& dt_op, std::string_view dt_pattern, const Fields& dt_fields,
+                                           char* dt_buffer) const {
+    switch (dt_op.code) {
+        case FormatOpCode::Literal:
+            return dt_pattern.substr(dt_op.offset, dt_op.length);
+        case FormatOpCode::RegionName: {
+            // Zone-backed regions print the abbreviation in effect (e.g. EDT), others their identifier
+            const RegionTime& dt_region = getRegion();
+            if (dt_region.zone) {
+                return dt_region.zone->localTypeAt(std::chrono::floor<std::chrono::seconds>(dt_clockPoint.time_since_epoch()).count()).abbreviation;
+            }
+            return dt_region.identifier;
+        }
+        case FormatOpCode::RegionOffset:
+            return std::string_view(dt_buffer, dt_renderOp(dt_op, dt_pattern, dt_fields, getRegionOffsetSeconds(), dt_buffer));
+        default:
+            return std::string_view(dt_buffer, dt_renderOp(dt_op, dt_pattern, dt_fields, 0, dt_buffer));
+    }
 }
 
-DateTime DateTime::plusSeconds(int dt_seconds) const {
-    std::chrono::system_clock::time_point dt_newTime = dt_clockPoint + std::chrono::seconds(dt_seconds);
-    return DateTime(dt_newTime, dt_timeRegion);
+std::to_chars_result DateTime::formatTo(char* dt_first, char* dt_last, const FormatPattern& dt_pattern) const {
+    const Fields dt_fields = fields();
+    const std::string& dt_layout = dt_pattern.layout();
+    if (!dt_layout.empty() && dt_layout.size() <= static_cast<std::size_t>(dt_last - dt_first) &&
+        dt_fields.year >= 0 && dt_fields.year <= 9999) {
+        // Fixed layout: copy the literal text once, then drop each field's digits into place
+        std::array<int, static_cast<std::size_t>(FormatOpCode::Second) + 1> dt_values{};
+        dt_values[static_cast<std::size_t>(FormatOpCode::Century)] = dt_fields.year / 100;
+        dt_values[static_cast<std::size_t>(FormatOpCode::YearOfCentury)] = dt_fields.year % 100;
+        dt_values[static_cast<std::size_t>(FormatOpCode::Month)] = dt_fields.month;
+        dt_values[static_cast<std::size_t>(FormatOpCode::Day)] = dt_fields.day;
+        dt_values[static_cast<std::size_t>(FormatOpCode::Hour)] = dt_fields.hour;
+        dt_values[static_cast<std::size_t>(FormatOpCode::Minute)] = dt_fields.minute;
+        dt_values[static_cast<std::size_t>(FormatOpCode::Second)] = dt_fields.second;
+        std::memcpy(dt_first, dt_layout.data(), dt_layout.size());
+        for (const FormatPattern::LayoutField& dt_field : dt_pattern.layoutFields()) {
+            if (dt_field.code == FormatOpCode::Fraction) {
+                dt_writeFraction(dt_first + dt_field.position, dt_fields.nanosecond, dt_field.width);
+            } else {
+                dt_write2(dt_first + dt_field.position, dt_values[static_cast<std::size_t>(dt_field.code)]);
+            }
+        }
+        return {dt_first + dt_layout.size(), std::errc{}};
+    }
+    char dt_buffer[MaxOperationSize];
+    for (const FormatOp& dt_op : dt_pattern.operations()) {
+        // Literals and fixed-width operations go straight into the output while it has room
+        const std::size_t dt_room = static_cast<std::size_t>(dt_last - dt_first);
+        if (dt_op.code == FormatOpCode::Literal && dt_op.length <= dt_room) {
+            std::memcpy(dt_first, dt_pattern.pattern().data() + dt_op.offset, dt_op.length);
+            dt_first += dt_op.length;
+            continue;
+        }
+        if (dt_op.code != FormatOpCode::Literal && dt_op.code != FormatOpCode::RegionName &&
+            dt_op.code != FormatOpCode::RegionOffset && dt_room >= MaxOperationSize) {
+            const int dt_twoDigits = dt_twoDigitField(dt_op.code, dt_fields);
+            dt_first = dt_twoDigits >= 0 ? dt_write2(dt_first, dt_twoDigits)
+                                         : dt_first + dt_renderOp(dt_op, dt_pattern.pattern(), dt_fields, 0, dt_first);
+            continue;
+        }
+        const std::string_view dt_piece = formatOperation(dt_op, dt_pattern.pattern(), dt_fields, dt_buffer);
+        if (dt_piece.size() > static_cast<std::size_t>(dt_last - dt_first)) {
+            return {dt_last, std::errc::value_too_large};
+        }
+        dt_first = std::copy(dt_piece.begin(), dt_piece.end(), dt_first);
+    }
+    return {dt_first, std::errc{}};
+}
+
+std::to_chars_result DateTime::formatTo(char* dt_first, char* dt_last, std::string_view dt_pattern) const {
+    const Fields dt_fields = fields();
+    char dt_buffer[MaxOperationSize];
+    bool dt_overflow = false;
+    const char* dt_error = FormatPattern::compile(dt_pattern, [&](const FormatOp& dt_op) {
+        if (dt_overflow) {
+            return;
+        }
+        const std::string_view dt_piece = formatOperation(dt_op, dt_pattern, dt_fields, dt_buffer);
+        if (dt_piece.size() > static_cast<std::size_t>(dt_last - dt_first)) {
+            dt_overflow = true;
+            return;
+        }
+        dt_first = std::copy(dt_piece.begin(), dt_piece.end(), dt_first);
+    });
+    if (dt_error != nullptr) {
+        return {dt_first, std::errc::invalid_argument};
+    }
+    if (dt_overflow) {
+        return {dt_last, std::errc::value_too_large};
+    }
+    return {dt_first, std::errc{}};
+}
+
+std::size_t DateTime::maxFormattedSize(const FormatPattern& dt_pattern) {
+    const std::size_t dt_maxRegionName = DT_RegionRegistry::instance().maxRegionNameLength();
+    std::size_t dt_size = 0;
+    for (const FormatOp& dt_op : dt_pattern.operations()) {
+        dt_size += dt_maxOpSize(dt_op, dt_maxRegionName);
+    }
+    return dt_size;
+}
+
+std::size_t DateTime::maxFormattedSize(std::string_view dt_pattern) {
+    const std::size_t dt_maxRegionName = DT_RegionRegistry::instance().maxRegionNameLength();
+    std::size_t dt_size = 0;
+    FormatPattern::compile(dt_pattern, [&](const FormatOp& dt_op) { dt_size += dt_maxOpSize(dt_op, dt_maxRegionName); });
+    return dt_size;
+}
+
+std::to_chars_result DateTime::formatIso8601(char* dt_first, char* dt_last, const IsoFormat& dt_options) const {
+    if (dt_options.fractionDigits < 0 || dt_options.fractionDigits > 9) {
+        return {dt_first, std::errc::invalid_argument};
+    }
+    
+    const Fields dt_fields = fields();
+    const std::int64_t dt_offset = getRegionOffsetSeconds();
+    char dt_buffer[MaxStandardFormatSize];
+    char* dt_out = dt_writeYear(dt_buffer, dt_fields.year);
+    if (!dt_options.basic) {
+        *dt_out++ = '-';
+    }
+    dt_out = dt_write2(dt_out, dt_fields.month);
+    if (!dt_options.basic) {
+        *dt_out++ = '-';
+    }
+    dt_out = dt_write2(dt_out, dt_fields.day);
+    *dt_out++ = 'T';
+    dt_out = dt_write2(dt_out, dt_fields.hour);
+    if (!dt_options.basic) {
+        *dt_out++ = ':';
+    }
+    dt_out = dt_write2(dt_out, dt_fields.minute);
+    if (!dt_options.basic) {
+        *dt_out++ = ':';
+    }
+    dt_out = dt_write2(dt_out, dt_fields.second);
+    if (dt_options.fractionDigits > 0) {
+        *dt_out++ = '.';
+        dt_out = dt_writeFraction(dt_out, dt_fields.nanosecond, dt_options.fractionDigits);
+    }
+    if (dt_offset == 0 && dt_options.utcDesignator) {
+        *dt_out++ = 'Z';
+    } else {
+        const std::int64_t dt_absolute = dt_offset < 0 ? -dt_offset : dt_offset;
+        *dt_out++ = dt_offset < 0 ? '-' : '+';
+        dt_out = dt_write2(dt_out, static_cast<int>(dt_absolute / 3600 % 100));
+        if (!dt_options.basic) {
+            *dt_out++ = ':';
+        }
+        dt_out = dt_write2(dt_out, static_cast<int>(dt_absolute / 60 % 60));
+    }
+    return dt_copyFormatted(dt_buffer, dt_out, dt_first, dt_last);
 }
 
-DateTime DateTime::plusMilliseconds(int dt_milliseconds) const {
-    std::chrono::system_clock::time_point dt_newTime = dt_clockPoint + std::chrono::milliseconds(dt_milliseconds);
-    return DateTime(dt_newTime, dt_timeRegion);
+std::to_chars_result DateTime::formatIso8601(char* dt_first, char* dt_last) const {
+    return formatIso8601(dt_first, dt_last, IsoFormat{});
 }
-bool DateTime::operator==(const DateTime& dt_other) const {
-    return dt_clockPoint == dt_other.dt_clockPoint;
+
+std::to_chars_result DateTime::formatRfc3339(char* dt_first, char* dt_last, int dt_fractionDigits) const {
+    return formatIso8601(dt_first, dt_last, IsoFormat{false, dt_fractionDigits, true});
 }
 
-bool DateTime::operator!=(const DateTime& dt_other) const {
-    return dt_clockPoint != dt_other.dt_clockPoint;
+std::to_chars_result DateTime::formatRfc1123(char* dt_first, char* dt_last) const {
+    const Fields dt_fields = fields();
+    const std::int64_t dt_offset = getRegionOffsetSeconds();
+    char dt_buffer[MaxStandardFormatSize];
+    char* dt_out = dt_writeName(dt_buffer, dt_weekdayNames[dt_fields.dayOfWeek], true);
+    *dt_out++ = ',';
+    *dt_out++ = ' ';
+    dt_out = dt_write2(dt_out, dt_fields.day);
+    *dt_out++ = ' ';
+    dt_out = dt_writeName(dt_out, dt_monthNames[dt_fields.month - 1], true);
+    *dt_out++ = ' ';
+    dt_out = dt_writeYear(dt_out, dt_fields.year);
+    *dt_out++ = ' ';
+    dt_out = dt_write2(dt_out, dt_fields.hour);
+    *dt_out++ = ':';
+    dt_out = dt_write2(dt_out, dt_fields.minute);
+    *dt_out++ = ':';
+    dt_out = dt_write2(dt_out, dt_fields.second);
+    *dt_out++ = ' ';
+    if (dt_offset == 0) {
+        std::memcpy(dt_out, "GMT", 3);
+        dt_out += 3;
+    } else {
+        const std::int64_t dt_absolute = dt_offset < 0 ? -dt_offset : dt_offset;
+        *dt_out++ = dt_offset < 0 ? '-' : '+';
+        dt_out = dt_write2(dt_out, static_cast<int>(dt_absolute / 3600 % 100));
+        dt_out = dt_write2(dt_out, static_cast<int>(dt_absolute / 60 % 60));
+    }
+    return dt_copyFormatted(dt_buffer, dt_out, dt_first, dt_last);
 }
 
-bool DateTime::operator<(const DateTime& dt_other) const {
-    return dt_clockPoint < dt_other.dt_clockPoint;
+std::string DateTime::toIso8601(const IsoFormat& dt_options) const {
+    char dt_buffer[MaxStandardFormatSize];
+    const std::to_chars_result dt_result = formatIso8601(dt_buffer, dt_buffer + sizeof(dt_buffer), dt_options);
+    if (dt_result.ec != std::errc{}) {
+        throw DateTimeException("Invalid ISO-8601 fraction digits: " + std::to_string(dt_options.fractionDigits));
+    }
+    return std::string(dt_buffer, dt_result.ptr);
 }
 
-bool DateTime::operator<=(const DateTime& dt_other) const {
-    return dt_clockPoint <= dt_other.dt_clockPoint;
+std::string DateTime::toIso8601() const {
+    return toIso8601(IsoFormat{});
 }
 
-bool DateTime::operator>(const DateTime& dt_other) const {
-    return dt_clockPoint > dt_other.dt_clockPoint;
+std::string DateTime::toRfc3339(int dt_fractionDigits) const {
+    return toIso8601(IsoFormat{false, dt_fractionDigits, true});
 }
 
-bool DateTime::operator>=(const DateTime& dt_other) const {
-    return dt_clockPoint >= dt_other.dt_clockPoint;
+std::string DateTime::toRfc1123() const {
+    char dt_buffer[MaxStandardFormatSize];
+    return std::string(dt_buffer, formatRfc1123(dt_buffer, dt_buffer + sizeof(dt_buffer)).ptr);
 }
 
 std::string DateTime::toString(const std::string& dt_format) const {
-    std::tm dt_timeStruct = getRegionAdjustedTime();
-    std::stringstream dt_stringStream;
-    dt_stringStream << std::put_time(&dt_timeStruct, dt_format.c_str());
-    return dt_stringStream.str();
+    // Reuse the compiled pattern while the same format string is used repeatedly on this thread
+    thread_local std::optional<FormatPattern> dt_cachedPattern;
+    if (!dt_cachedPattern || dt_cachedPattern->pattern() != dt_format) {
+        dt_cachedPattern.emplace(dt_format);
+    }
+    return toString(*dt_cachedPattern);
 }
 
 std::string DateTime::toStringWithRegion(const std::string& dt_format) const {
-    // Check if the format string contains %Z
-    bool dt_hasTimezoneFormat = (dt_format.find("%Z") != std::string::npos);
-    
-    // Create a temporary format without %Z (to be replaced with appropriate timezone later)
-    std::string dt_tempFormat = dt_format;
-    if (dt_hasTimezoneFormat) {
-        // Replace %Z with a temporary placeholder
-        size_t dt_pos = dt_tempFormat.find("%Z");
-        dt_tempFormat.replace(dt_pos, 2, "##TZ_PLACEHOLDER##");
+    // %Z is rendered as the region identifier
+    if (dt_format.find("%Z") != std::string::npos) {
+        return toString(dt_format);
     }
     
-    // Convert to string using the basic format
-    std::tm dt_timeStruct = getRegionAdjustedTime();
-    std::stringstream dt_stringStream;
-    dt_stringStream << std::put_time(&dt_timeStruct, dt_tempFormat.c_str());
-    std::string dt_result = dt_stringStream.str();
-    
-    // Replace placeholder with the correct timezone identifier
-    if (dt_hasTimezoneFormat) {
-        size_t dt_pos = dt_result.find("##TZ_PLACEHOLDER##");
-        if (dt_pos != std::string::npos) {
-            dt_result.replace(dt_pos, 18, dt_timeRegion.identifier);
+    // If timezone info is not included in the format, append to the end
+    return toString(dt_format) + " " + getRegion().identifier;
+}
+
+DateTime::ParsePattern::ParsePattern(std::string_view dt_pattern) : dt_pattern(dt_pattern) {
+    const char* dt_error = FormatPattern::compile(this->dt_pattern, [this](const FormatOp& dt_op) { dt_ops.push_back(dt_op); }, true);
+    if (dt_error != nullptr) {
+        throw DateTimeException(std::string("Invalid parse pattern: ") + dt_error);
+    }
+    for (const FormatOp& dt_op : dt_ops) {
+        if (dt_op.code == FormatOpCode::RegionName || dt_op.code == FormatOpCode::Strftime) {
+            throw DateTimeException("Conversion not supported for parsing in pattern: " + this->dt_pattern);
         }
-    } else {
-        // If timezone info is not included in the format, append to the end
-        dt_result += " " + dt_timeRegion.identifier;
     }
-    
-    return dt_result;
 }
 
 // DateTime parsing from string (enhanced error handling)
 std::optional<DateTime> DateTime::parse(const std::string& dt_dateString, const std::string& dt_format) {
-    std::tm dt_timeStruct{};
-    std::istringstream dt_ss(dt_dateString);
-    dt_ss >> std::get_time(&dt_timeStruct, dt_format.c_str());
+    // Reuse the compiled pattern while the same format string is used repeatedly on this thread
+    thread_local std::optional<ParsePattern> dt_cachedPattern;
+    if (!dt_cachedPattern || dt_cachedPattern->pattern() != dt_format) {
+        try {
+            dt_cachedPattern.emplace(dt_format);
+        } catch (const DateTimeException&) {
+            dt_cachedPattern.reset();
+            return std::nullopt;
+        }
+    }
     
-    if (dt_ss.fail()) {
+    ParseResult dt_result = dt_parseWithOps(dt_dateString, dt_cachedPattern->operations(), dt_cachedPattern->pattern(), true);
+    if (!dt_result) {
         return std::nullopt;
     }
+    return dt_result.value;
+}
+
+DateTime::ParseResult DateTime::parse(std::string_view dt_input, const ParsePattern& dt_pattern, ParseMode dt_mode) {
+    return dt_parseWithOps(dt_input, dt_pattern.operations(), dt_pattern.pattern(), dt_mode == ParseMode::Prefix);
+}
+
+DateTime::ParseResult DateTime::parseIso8601(std::string_view dt_input, ParseMode dt_mode) {
+    DT_ParseCursor dt_cursor{dt_input};
+    DT_ParseState dt_state;
     
-    try {
-        // Validate parsed values
-        if (!isValidDate(dt_timeStruct.tm_year + 1900, dt_timeStruct.tm_mon + 1, dt_timeStruct.tm_mday) ||
-            !isValidTime(dt_timeStruct.tm_hour, dt_timeStruct.tm_min, dt_timeStruct.tm_sec, 0)) {
-            return std::nullopt;
+    // Date: YYYY-MM-DD or YYYYMMDD
+    if (!dt_cursor.readNumber(4, 4, dt_state.year)) {
+        return dt_parseFailure(dt_cursor);
+    }
+    const bool dt_extended = !dt_cursor.atEnd() && dt_input[dt_cursor.position] == '-';
+    dt_state.datePosition = dt_cursor.position + (dt_extended ? 1 : 0);
+    if ((dt_extended && !dt_cursor.matchLiteral('-')) || !dt_cursor.readField(2, 2, 1, 12, dt_state.month) ||
+        (dt_extended && !dt_cursor.matchLiteral('-')) || !dt_cursor.readField(2, 2, 1, 31, dt_state.day)) {
+        return dt_parseFailure(dt_cursor);
+    }
+    
+    // Optional time: hh:mm:ss or hhmmss, fraction and offset
+    const bool dt_prefix = dt_mode == ParseMode::Prefix;
+    if (!dt_cursor.atEnd()) {
+        const char dt_separator = dt_input[dt_cursor.position];
+        if ((dt_separator != 'T' && dt_separator != 't' && dt_separator != ' ') ||
+            (dt_prefix && !dt_cursor.isDigitAt(dt_cursor.position + 1))) {
+            if (dt_prefix) {
+                return dt_finishParse(dt_state, dt_cursor.position);
+            }
+            dt_cursor.fail(ParseError::TrailingCharacters);
+            return dt_parseFailure(dt_cursor);
+        }
+        ++dt_cursor.position;
+        if (!dt_cursor.readField(2, 2, 0, 23, dt_state.hour) || (dt_extended && !dt_cursor.matchLiteral(':')) ||
+            !dt_cursor.readField(2, 2, 0, 59, dt_state.minute) || (dt_extended && !dt_cursor.matchLiteral(':')) ||
+            !dt_cursor.readField(2, 2, 0, 59, dt_state.second)) {
+            return dt_parseFailure(dt_cursor);
+        }
+        if (!dt_cursor.atEnd() && (dt_input[dt_cursor.position] == '.' || dt_input[dt_cursor.position] == ',')) {
+            ++dt_cursor.position;
+            if (!dt_cursor.readFraction(1, std::numeric_limits<int>::max(), dt_state.nanosecond)) {
+                return dt_parseFailure(dt_cursor);
+            }
+        }
+        const bool dt_hasOffset = !dt_cursor.atEnd() && (dt_input[dt_cursor.position] == 'Z' || dt_input[dt_cursor.position] == 'z' ||
+                                                         dt_input[dt_cursor.position] == '+' || dt_input[dt_cursor.position] == '-');
+        if ((dt_hasOffset || (!dt_prefix && !dt_cursor.atEnd())) && !dt_cursor.readOffset(dt_state.offsetSeconds)) {
+            return dt_parseFailure(dt_cursor);
+        }
+        if (!dt_prefix && !dt_cursor.atEnd()) {
+            dt_cursor.fail(ParseError::TrailingCharacters);
+            return dt_parseFailure(dt_cursor);
         }
-        
-        // Create DateTime object from valid datetime information
-        return DateTime(dt_timeStruct.tm_year + 1900, dt_timeStruct.tm_mon + 1, dt_timeStruct.tm_mday,
-                       dt_timeStruct.tm_hour, dt_timeStruct.tm_min, dt_timeStruct.tm_sec);
     }
-    catch (const DateTimeException&) {
-        return std::nullopt;
+    return dt_finishParse(dt_state, dt_cursor.position);
+}
+
+const char* DateTime::parseErrorMessage(ParseError dt_error) {
+    switch (dt_error) {
+        case ParseError::None: return "no error";
+        case ParseError::UnexpectedEnd: return "input ended before the pattern";
+        case ParseError::ExpectedDigit: return "expected a digit";
+        case ParseError::ExpectedLiteral: return "input does not match the pattern text";
+        case ParseError::UnknownName: return "unknown weekday, month or AM/PM name";
+        case ParseError::FieldOutOfRange: return "field value out of range";
+        case ParseError::InvalidDate: return "date does not exist";
+        case ParseError::TrailingCharacters: return "unexpected characters after the timestamp";
     }
+    return "unknown error";
 }
 
 // Enhanced formatting function using C++20 format
 std::string DateTime::formatString(std::string_view dt_fmt) const {
-    std::tm dt_timeStruct = getRegionAdjustedTime();
     try {
         // Use default format if empty
         if (dt_fmt.empty()) {
-            return std::format("{}", dt_timeStruct);
-        }
-        
-        // If format string starts with {: and ends with }, extract the content
-        std::string_view dt_pattern = dt_fmt;
-        if (dt_pattern.size() >= 4 && dt_pattern[0] == '{' && dt_pattern[1] == ':' && 
-            dt_pattern[dt_pattern.size()-1] == '}') {
-            // Extract %Y-%m-%d from {:%Y-%m-%d}
-            std::string extracted(dt_fmt.substr(2, dt_fmt.size() - 3));
-            
-            // Process using strftime style
-            char dt_buffer[100];
-            std::strftime(dt_buffer, sizeof(dt_buffer), extracted.c_str(), &dt_timeStruct);
-            return dt_buffer;
+            return std::format("{}", *this);
         }
         
-        // strftime style format
-        if (dt_fmt.find("%") != std::string_view::npos) {
-            char dt_buffer[100];
-            std::strftime(dt_buffer, sizeof(dt_buffer), dt_fmt.data(), &dt_timeStruct);
-            return dt_buffer;
+        // Plain strftime-style pattern
+        if (dt_fmt.find('{') == std::string_view::npos) {
+            return toString(std::string(dt_fmt));
         }
         
-        // Maintain existing processing for other formats
-        // ...other format processing...
-        
-        // Fall back to toString if failed
-        return toString(std::string(dt_fmt));
+        // Replacement fields like {:%Y-%m-%d} are handled by std::formatter<DateTime>
+        return std::vformat(dt_fmt, std::make_format_args(*this));
     } catch (const std::exception& dt_exception) {
         return "Format error: " + std::string(dt_exception.what());
     }
 }
-
-std::chrono::seconds DateTime::timeBetween(const DateTime& dt_dt1, const DateTime& dt_dt2) {
-    // Take the difference between time_points directly, cast to seconds
-    return std::chrono::duration_cast<std::chrono::seconds>(dt_dt2.dt_clockPoint - dt_dt1.dt_clockPoint);
-}
-
-std::chrono::system_clock::time_point DateTime::getSystemTime() const {
-    return dt_clockPoint;
-}
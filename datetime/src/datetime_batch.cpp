@@ -0,0 +1,381 @@
+#include "datetime_batch.hpp"
+#include "datetime_column.hpp"
+#include "datetime_simd.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+using Layout = DateTimeBatchParser::Layout;
+using Isa = DateTimeBatchParser::Isa;
+
+constexpr std::int64_t dt_millisecondsPerDay = 86400000;
+
+// Range-check the decoded fields and convert to epoch milliseconds
+inline bool dt_composeMilliseconds(int dt_year, int dt_month, int dt_day, int dt_hour, int dt_minute, int dt_second,
+                                   int dt_millisecond, std::int64_t& dt_out) {
+    if (dt_month < 1 || dt_month > 12 || dt_day < 1 || dt_day > DateTime::daysInMonth(dt_year, dt_month) ||
+        dt_hour > 23 || dt_minute > 59 || dt_second > 59) {
+        return false;
+    }
+    dt_out = DateTime::daysFromCivil(dt_year, dt_month, dt_day) * dt_millisecondsPerDay +
+             dt_hour * std::int64_t{3600000} + dt_minute * std::int64_t{60000} + dt_second * std::int64_t{1000} +
+             dt_millisecond;
+    return true;
+}
+
+// Scalar reference implementation
+template <bool WithMilliseconds>
+bool dt_parseRowScalar(const char* dt_row, std::int64_t& dt_out) {
+    bool dt_ok = true;
+    auto dt_digits = [&](int dt_position, int dt_count) {
+        int dt_value = 0;
+        for (int dt_index = 0; dt_index < dt_count; ++dt_index) {
+            const unsigned dt_digit = static_cast<unsigned char>(dt_row[dt_position + dt_index]) - unsigned{'0'};
+            dt_ok &= dt_digit <= 9;
+            dt_value = dt_value * 10 + static_cast<int>(dt_digit);
+        }
+        return dt_value;
+    };
+    const int dt_year = dt_digits(0, 4);
+    const int dt_month = dt_digits(5, 2);
+    const int dt_day = dt_digits(8, 2);
+    const int dt_hour = dt_digits(11, 2);
+    const int dt_minute = dt_digits(14, 2);
+    const int dt_second = dt_digits(17, 2);
+    const int dt_millisecond = WithMilliseconds ? dt_digits(20, 3) : 0;
+    dt_ok &= dt_row[4] == '-' && dt_row[7] == '-' && (dt_row[10] == ' ' || dt_row[10] == 'T') &&
+             dt_row[13] == ':' && dt_row[16] == ':';
+    if (WithMilliseconds) {
+        dt_ok &= dt_row[19] == '.';
+    }
+    return dt_ok && dt_composeMilliseconds(dt_year, dt_month, dt_day, dt_hour, dt_minute, dt_second, dt_millisecond, dt_out);
+}
+
+#if defined(DATETIME_HAS_X86_SIMD)
+// Each row is covered by two overlapping 16-byte blocks that never read past the row end:
+//   low  = row[0..15]       "YYYY-MM-DD HH:MM"
+//   high = row[N-16..N-1]   ending in ":SS" (N = 19) or ":SS.mmm" (N = 23)
+// Each block is checked against a separator template and a digit mask. Then the date/time digit
+// pairs are gathered with a byte shuffle and combined with one multiply-add (d0 * 10 + d1).
+template <bool WithMilliseconds>
+struct DT_SimdLayout {
+    static constexpr int highOffset = WithMilliseconds ? 7 : 3;
+    static constexpr char secondIndex = WithMilliseconds ? 10 : 14;  // Seconds digits within the high block
+};
+
+struct DT_BlockTemplates {
+    __m128i separators;     // Expected separators ('T' accepted through alternate)
+    __m128i alternate;
+    __m128i digitMask;      // 0xFF where a digit is expected
+};
+
+template <bool WithMilliseconds>
+DATETIME_TARGET("sse4.2") DT_BlockTemplates dt_lowTemplates() {
+    return {_mm_setr_epi8(0, 0, 0, 0, '-', 0, 0, '-', 0, 0, ' ', 0, 0, ':', 0, 0),
+            _mm_setr_epi8(0, 0, 0, 0, '-', 0, 0, '-', 0, 0, 'T', 0, 0, ':', 0, 0),
+            _mm_setr_epi8(-1, -1, -1, -1, 0, -1, -1, 0, -1, -1, 0, -1, -1, 0, -1, -1)};
+}
+
+template <bool WithMilliseconds>
+DATETIME_TARGET("sse4.2") DT_BlockTemplates dt_highTemplates() {
+    if (WithMilliseconds) {
+        // row[7..22] = "-DD HH:MM:SS.mmm"
+        return {_mm_setr_epi8('-', 0, 0, ' ', 0, 0, ':', 0, 0, ':', 0, 0, '.', 0, 0, 0),
+                _mm_setr_epi8('-', 0, 0, 'T', 0, 0, ':', 0, 0, ':', 0, 0, '.', 0, 0, 0),
+                _mm_setr_epi8(0, -1, -1, 0, -1, -1, 0, -1, -1, 0, -1, -1, 0, -1, -1, -1)};
+    }
+    // row[3..18] = "Y-MM-DD HH:MM:SS"
+    return {_mm_setr_epi8(0, '-', 0, 0, '-', 0, 0, ' ', 0, 0, ':', 0, 0, ':', 0, 0),
+            _mm_setr_epi8(0, '-', 0, 0, '-', 0, 0, 'T', 0, 0, ':', 0, 0, ':', 0, 0),
+            _mm_setr_epi8(-1, 0, -1, -1, 0, -1, -1, 0, -1, -1, 0, -1, -1, 0, -1, -1)};
+}
+
+// Gather Y0 Y1 Y2 Y3 M M D D h h m m from the low block and the seconds from the high block
+DATETIME_TARGET("sse4.2") inline __m128i dt_lowShuffle() {
+    return _mm_setr_epi8(0, 1, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, -1, -1, -1, -1);
+}
+
+template <bool WithMilliseconds>
+DATETIME_TARGET("sse4.2") __m128i dt_highShuffle() {
+    constexpr char dt_second = DT_SimdLayout<WithMilliseconds>::secondIndex;
+    return _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, dt_second, dt_second + 1, -1, -1);
+}
+
+// Returns 0xFF per byte that matches the template; dt_digits receives the bytes minus '0'
+DATETIME_TARGET("sse4.2") inline __m128i dt_checkBlock(__m128i dt_block, const DT_BlockTemplates& dt_templates, __m128i& dt_digits) {
+    dt_digits = _mm_sub_epi8(dt_block, _mm_set1_epi8('0'));
+    const __m128i dt_isDigit = _mm_cmpeq_epi8(_mm_min_epu8(dt_digits, _mm_set1_epi8(9)), dt_digits);
+    const __m128i dt_isSeparator = _mm_or_si128(_mm_cmpeq_epi8(dt_block, dt_templates.separators),
+                                                _mm_cmpeq_epi8(dt_block, dt_templates.alternate));
+    return _mm_or_si128(_mm_and_si128(dt_templates.digitMask, dt_isDigit),
+                        _mm_andnot_si128(dt_templates.digitMask, dt_isSeparator));
+}
+
+// Fields decoded by the multiply-add: year pairs, month, day, hour, minute, second
+inline bool dt_composeFromPairs(const std::int16_t* dt_pairs, int dt_millisecond, std::int64_t& dt_out) {
+    return dt_composeMilliseconds(dt_pairs[0] * 100 + dt_pairs[1], dt_pairs[2], dt_pairs[3], dt_pairs[4], dt_pairs[5],
+                                  dt_pairs[6], dt_millisecond, dt_out);
+}
+
+template <bool WithMilliseconds>
+DATETIME_TARGET("sse4.2") bool dt_parseRowSse(const char* dt_row, std::int64_t& dt_out) {
+    const __m128i dt_low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dt_row));
+    const __m128i dt_high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dt_row + DT_SimdLayout<WithMilliseconds>::highOffset));
+    __m128i dt_lowDigits;
+    __m128i dt_highDigits;
+    const __m128i dt_valid = _mm_and_si128(dt_checkBlock(dt_low, dt_lowTemplates<WithMilliseconds>(), dt_lowDigits),
+                                           dt_checkBlock(dt_high, dt_highTemplates<WithMilliseconds>(), dt_highDigits));
+    if (_mm_movemask_epi8(dt_valid) != 0xFFFF) {
+        return false;
+    }
+
+    const __m128i dt_gathered = _mm_or_si128(_mm_shuffle_epi8(dt_lowDigits, dt_lowShuffle()),
+                                             _mm_shuffle_epi8(dt_highDigits, dt_highShuffle<WithMilliseconds>()));
+    alignas(16) std::int16_t dt_pairs[8];
+    _mm_store_si128(reinterpret_cast<__m128i*>(dt_pairs), _mm_maddubs_epi16(dt_gathered, _mm_set1_epi16(0x010A)));
+
+    int dt_millisecond = 0;
+    if (WithMilliseconds) {
+        dt_millisecond = _mm_extract_epi8(dt_highDigits, 13) * 100 + _mm_extract_epi8(dt_highDigits, 14) * 10 +
+                         _mm_extract_epi8(dt_highDigits, 15);
+    }
+    return dt_composeFromPairs(dt_pairs, dt_millisecond, dt_out);
+}
+
+DATETIME_TARGET("avx2") inline __m256i dt_broadcast(__m128i dt_value) {
+    return _mm256_broadcastsi128_si256(dt_value);
+}
+
+DATETIME_TARGET("avx2") inline __m256i dt_loadPair(const char* dt_first, const char* dt_second) {
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(dt_first))),
+                                   _mm_loadu_si128(reinterpret_cast<const __m128i*>(dt_second)), 1);
+}
+
+DATETIME_TARGET("avx2") inline __m256i dt_checkBlockPair(__m256i dt_block, const DT_BlockTemplates& dt_templates, __m256i& dt_digits) {
+    const __m256i dt_separators = dt_broadcast(dt_templates.separators);
+    const __m256i dt_alternate = dt_broadcast(dt_templates.alternate);
+    const __m256i dt_digitMask = dt_broadcast(dt_templates.digitMask);
+    dt_digits = _mm256_sub_epi8(dt_block, _mm256_set1_epi8('0'));
+    const __m256i dt_isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(dt_digits, _mm256_set1_epi8(9)), dt_digits);
+    const __m256i dt_isSeparator = _mm256_or_si256(_mm256_cmpeq_epi8(dt_block, dt_separators),
+                                                   _mm256_cmpeq_epi8(dt_block, dt_alternate));
+    return _mm256_or_si256(_mm256_and_si256(dt_digitMask, dt_isDigit), _mm256_andnot_si256(dt_digitMask, dt_isSeparator));
+}
+
+// Two rows per iteration, one per 128-bit lane; dt_ok receives the validity of each row
+template <bool WithMilliseconds>
+DATETIME_TARGET("avx2") void dt_parseRowPairAvx2(const char* dt_row0, const char* dt_row1, std::int64_t* dt_out, bool* dt_ok) {
+    constexpr int dt_highOffset = DT_SimdLayout<WithMilliseconds>::highOffset;
+    const __m256i dt_low = dt_loadPair(dt_row0, dt_row1);
+    const __m256i dt_high = dt_loadPair(dt_row0 + dt_highOffset, dt_row1 + dt_highOffset);
+    __m256i dt_lowDigits;
+    __m256i dt_highDigits;
+    const __m256i dt_valid = _mm256_and_si256(dt_checkBlockPair(dt_low, dt_lowTemplates<WithMilliseconds>(), dt_lowDigits),
+                                              dt_checkBlockPair(dt_high, dt_highTemplates<WithMilliseconds>(), dt_highDigits));
+    const std::uint32_t dt_mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(dt_valid));
+
+    const __m256i dt_gathered = _mm256_or_si256(_mm256_shuffle_epi8(dt_lowDigits, dt_broadcast(dt_lowShuffle())),
+                                                _mm256_shuffle_epi8(dt_highDigits, dt_broadcast(dt_highShuffle<WithMilliseconds>())));
+    alignas(32) std::int16_t dt_pairs[16];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(dt_pairs), _mm256_maddubs_epi16(dt_gathered, _mm256_set1_epi16(0x010A)));
+    alignas(32) std::uint8_t dt_highBytes[32];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(dt_highBytes), dt_highDigits);
+
+    for (int dt_lane = 0; dt_lane < 2; ++dt_lane) {
+        const std::uint8_t* dt_fraction = dt_highBytes + dt_lane * 16 + 13;
+        const int dt_millisecond = WithMilliseconds ? dt_fraction[0] * 100 + dt_fraction[1] * 10 + dt_fraction[2] : 0;
+        dt_ok[dt_lane] = ((dt_mask >> (dt_lane * 16)) & 0xFFFF) == 0xFFFF &&
+                         dt_composeFromPairs(dt_pairs + dt_lane * 8, dt_millisecond, dt_out[dt_lane]);
+    }
+}
+#endif
+
+Isa dt_detectIsa() {
+#if defined(DATETIME_HAS_X86_SIMD)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return Isa::Avx2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return Isa::Sse42;
+    }
+#endif
+    return Isa::Scalar;
+}
+
+template <bool WithMilliseconds, class RowAt>
+std::size_t dt_parseRows(RowAt dt_rowAt, std::size_t dt_count, std::int64_t* dt_out,
+                         std::vector<std::size_t>* dt_malformedRows, Isa dt_isa) {
+    std::size_t dt_malformed = 0;
+    auto dt_record = [&](std::size_t dt_index, bool dt_ok) {
+        if (!dt_ok) {
+            dt_out[dt_index] = DateTimeBatchParser::InvalidTimestamp;
+            if (dt_malformedRows != nullptr) {
+                dt_malformedRows->push_back(dt_index);
+            }
+            ++dt_malformed;
+        }
+    };
+
+    std::size_t dt_index = 0;
+#if defined(DATETIME_HAS_X86_SIMD)
+    if (dt_isa == Isa::Avx2) {
+        for (; dt_index + 2 <= dt_count; dt_index += 2) {
+            bool dt_ok[2];
+            dt_parseRowPairAvx2<WithMilliseconds>(dt_rowAt(dt_index), dt_rowAt(dt_index + 1), dt_out + dt_index, dt_ok);
+            dt_record(dt_index, dt_ok[0]);
+            dt_record(dt_index + 1, dt_ok[1]);
+        }
+    }
+    if (dt_isa == Isa::Avx2 || dt_isa == Isa::Sse42) {
+        for (; dt_index < dt_count; ++dt_index) {
+            dt_record(dt_index, dt_parseRowSse<WithMilliseconds>(dt_rowAt(dt_index), dt_out[dt_index]));
+        }
+    }
+#endif
+    for (; dt_index < dt_count; ++dt_index) {
+        dt_record(dt_index, dt_parseRowScalar<WithMilliseconds>(dt_rowAt(dt_index), dt_out[dt_index]));
+    }
+    return dt_malformed;
+}
+
+template <class RowAt>
+std::size_t dt_parseLayout(RowAt dt_rowAt, std::size_t dt_count, Layout dt_layout, std::int64_t* dt_out,
+                           std::vector<std::size_t>* dt_malformedRows, Isa dt_isa) {
+    const Isa dt_resolved = dt_resolveIsa(dt_isa);
+    if (dt_layout == Layout::Milliseconds) {
+        return dt_parseRows<true>(dt_rowAt, dt_count, dt_out, dt_malformedRows, dt_resolved);
+    }
+    return dt_parseRows<false>(dt_rowAt, dt_count, dt_out, dt_malformedRows, dt_resolved);
+}
+
+// Width of the pattern's output if every operation renders a fixed number of characters, else 0.
+// %Y and %C assume years 1000-9999; rows that differ are detected while rendering.
+std::size_t dt_patternWidth(const DateTime::FormatPattern& dt_pattern) {
+    using Op = DateTime::FormatOpCode;
+    std::size_t dt_width = 0;
+    for (const DateTime::FormatOp& dt_op : dt_pattern.operations()) {
+        switch (dt_op.code) {
+            case Op::Literal:
+                dt_width += dt_op.length;
+                break;
+            case Op::Char:
+            case Op::WeekdayNumber:
+            case Op::IsoWeekdayNumber:
+                dt_width += 1;
+                break;
+            case Op::Century:
+            case Op::YearOfCentury:
+            case Op::Month:
+            case Op::Day:
+            case Op::DaySpacePadded:
+            case Op::Hour:
+            case Op::Hour12:
+            case Op::Minute:
+            case Op::Second:
+            case Op::AmPm:
+                dt_width += 2;
+                break;
+            case Op::DayOfYear:
+            case Op::WeekdayShort:
+            case Op::MonthShort:
+                dt_width += 3;
+                break;
+            case Op::Year:
+                dt_width += 4;
+                break;
+            case Op::Fraction:
+                dt_width += dt_op.offset;
+                break;
+            case Op::RegionOffset:
+                dt_width += 5;
+                break;
+            case Op::WeekdayFull:
+            case Op::MonthFull:
+            case Op::RegionName:
+            case Op::Strftime:
+                return 0;
+        }
+    }
+    return dt_width;
+}
+
+DateTime dt_fromEpochMilliseconds(std::int64_t dt_milliseconds, DateTime::RegionHandle dt_region) {
+    return DateTime(std::chrono::system_clock::time_point(std::chrono::milliseconds(dt_milliseconds)), dt_region);
+}
+
+} // namespace
+
+DateTimeBatchParser::Isa DateTimeBatchParser::supportedIsa() {
+    static const Isa dt_supported = dt_detectIsa();
+    return dt_supported;
+}
+
+std::size_t DateTimeBatchParser::parse(const char* dt_data, std::size_t dt_count, std::size_t dt_stride, Layout dt_layout,
+                                       std::int64_t* dt_out, std::vector<std::size_t>* dt_malformedRows, Isa dt_isa) {
+    return dt_parseLayout([dt_data, dt_stride](std::size_t dt_index) { return dt_data + dt_index * dt_stride; },
+                          dt_count, dt_layout, dt_out, dt_malformedRows, dt_isa);
+}
+
+std::size_t DateTimeBatchParser::parse(const char* dt_data, const std::size_t* dt_offsets, std::size_t dt_count,
+                                       Layout dt_layout, std::int64_t* dt_out, std::vector<std::size_t>* dt_malformedRows,
+                                       Isa dt_isa) {
+    return dt_parseLayout([dt_data, dt_offsets](std::size_t dt_index) { return dt_data + dt_offsets[dt_index]; },
+                          dt_count, dt_layout, dt_out, dt_malformedRows, dt_isa);
+}
+
+DateTimeBatchFormatter::DateTimeBatchFormatter(std::string_view dt_pattern)
+    : dt_pattern(dt_pattern), dt_fixedWidth(dt_patternWidth(this->dt_pattern)) {}
+
+template <class ValueAt>
+std::size_t DateTimeBatchFormatter::render(ValueAt dt_valueAt, std::size_t dt_count) {
+    dt_offsets.resize(dt_count + 1);
+    dt_offsets[0] = 0;
+    dt_used = 0;
+    std::size_t dt_row = 0;
+
+    // Fixed width: size the arena exactly once and write each row into its slot
+    if (dt_fixedWidth != 0) {
+        if (dt_arena.size() < dt_count * dt_fixedWidth) {
+            dt_arena.resize(dt_count * dt_fixedWidth);
+        }
+        for (; dt_row < dt_count; ++dt_row) {
+            char* dt_slot = dt_arena.data() + dt_used;
+            const std::to_chars_result dt_result = dt_valueAt(dt_row).formatTo(dt_slot, dt_slot + dt_fixedWidth, dt_pattern);
+            if (dt_result.ec != std::errc{} || dt_result.ptr != dt_slot + dt_fixedWidth) {
+                break;  // Year outside 1000-9999: continue with the variable-width loop
+            }
+            dt_used += dt_fixedWidth;
+            dt_offsets[dt_row + 1] = static_cast<std::int64_t>(dt_used);
+        }
+    }
+
+    // Variable width: keep room for the largest possible row and grow geometrically
+    const std::size_t dt_maxRow = DateTime::maxFormattedSize(dt_pattern);
+    for (; dt_row < dt_count; ++dt_row) {
+        if (dt_arena.size() < dt_used + dt_maxRow) {
+            dt_arena.resize(std::max(dt_arena.size() * 2, dt_used + dt_maxRow));
+        }
+        char* dt_first = dt_arena.data() + dt_used;
+        const std::to_chars_result dt_result = dt_valueAt(dt_row).formatTo(dt_first, dt_first + dt_maxRow, dt_pattern);
+        dt_used += static_cast<std::size_t>(dt_result.ptr - dt_first);
+        dt_offsets[dt_row + 1] = static_cast<std::int64_t>(dt_used);
+    }
+    return dt_count;
+}
+
+std::size_t DateTimeBatchFormatter::format(std::span<const DateTime> dt_values) {
+    return render([dt_values](std::size_t dt_row) -> const DateTime& { return dt_values[dt_row]; }, dt_values.size());
+}
+
+std::size_t DateTimeBatchFormatter::format(const std::int64_t* dt_epochMilliseconds, std::size_t dt_count,
+                                           DateTime::RegionHandle dt_region) {
+    return render([dt_epochMilliseconds, dt_region](std::size_t dt_row) {
+        return dt_fromEpochMilliseconds(dt_epochMilliseconds[dt_row], dt_region);
+    }, dt_count);
+}
+
+std::size_t DateTimeBatchFormatter::format(const DateTimeColumn& dt_column) {
+    return render([&dt_column](std::size_t dt_row) { return dt_column[dt_row]; }, dt_column.size());
+}
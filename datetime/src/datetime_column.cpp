@@ -0,0 +1,563 @@
+#include "datetime_column.hpp"
+#include "datetime_simd.hpp"
+#include "datetime_zone.hpp"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <utility>
+
+namespace {
+
+using Isa = DateTimeColumn::Isa;
+
+constexpr std::int64_t dt_millisecondsPerSecond = 1000;
+constexpr std::int64_t dt_millisecondsPerMinute = 60 * dt_millisecondsPerSecond;
+constexpr std::int64_t dt_millisecondsPerHour = 60 * dt_millisecondsPerMinute;
+constexpr std::int64_t dt_millisecondsPerDay = 24 * dt_millisecondsPerHour;
+
+std::int64_t dt_toMilliseconds(const DateTime& dt_value) {
+    return dt_value.getTimePoint<std::chrono::milliseconds>().time_since_epoch().count();
+}
+
+// UTC offset of one region for any instant; zone regions look the offset up per value
+class DT_RegionOffset {
+public:
+    explicit DT_RegionOffset(DateTime::RegionHandle dt_region)
+        : dt_zone(DateTime::regionFromHandle(dt_region).zone.get()),
+          dt_fixed(DateTime(std::chrono::system_clock::time_point{}, dt_region).getUtcOffset().count() * dt_millisecondsPerSecond) {}
+
+    bool isFixed() const { return dt_zone == nullptr; }
+
+    std::int64_t at(std::int64_t dt_epochMilliseconds) const {
+        return dt_zone == nullptr ? dt_fixed
+                                  : dt_zone->offsetAt(DateTime::floorDiv(dt_epochMilliseconds, dt_millisecondsPerSecond)) *
+                                        dt_millisecondsPerSecond;
+    }
+
+private:
+    const DateTimeZone* dt_zone;
+    std::int64_t dt_fixed;
+};
+
+// Field arrays advanced by dt_rows elements
+DateTimeColumn::FieldArrays dt_advance(const DateTimeColumn::FieldArrays& dt_out, std::size_t dt_rows) {
+    auto dt_shift = [dt_rows](std::int32_t* dt_array) { return dt_array != nullptr ? dt_array + dt_rows : nullptr; };
+    return {dt_shift(dt_out.year), dt_shift(dt_out.month), dt_shift(dt_out.day), dt_shift(dt_out.hour),
+            dt_shift(dt_out.minute), dt_shift(dt_out.second), dt_shift(dt_out.millisecond), dt_shift(dt_out.dayOfWeek)};
+}
+
+// Scalar kernels (also handle the tails of the SIMD loops)
+void dt_addScalar(std::int64_t* dt_values, std::size_t dt_begin, std::size_t dt_count, std::int64_t dt_delta) {
+    for (std::size_t dt_index = dt_begin; dt_index < dt_count; ++dt_index) {
+        dt_values[dt_index] += dt_delta;
+    }
+}
+
+template <class Visit>
+void dt_rangeScalar(const std::int64_t* dt_values, std::size_t dt_begin, std::size_t dt_count, std::int64_t dt_from,
+                    std::int64_t dt_to, Visit&& dt_visit) {
+    for (std::size_t dt_index = dt_begin; dt_index < dt_count; ++dt_index) {
+        if (dt_values[dt_index] >= dt_from && dt_values[dt_index] < dt_to) {
+            dt_visit(dt_index);
+        }
+    }
+}
+
+// Branch-free count over four independent counters (dt_rangeScalar mispredicts at every boundary)
+std::size_t dt_countScalar(const std::int64_t* dt_values, std::size_t dt_begin, std::size_t dt_count, std::int64_t dt_from,
+                           std::int64_t dt_to) {
+    // Unsigned distance from dt_from is below the range width exactly for rows in [dt_from, dt_to)
+    const std::uint64_t dt_width = dt_to > dt_from ? static_cast<std::uint64_t>(dt_to) - static_cast<std::uint64_t>(dt_from) : 0;
+    auto dt_inside = [dt_from, dt_width](std::int64_t dt_value) {
+        return static_cast<std::size_t>(static_cast<std::uint64_t>(dt_value) - static_cast<std::uint64_t>(dt_from) < dt_width);
+    };
+    std::size_t dt_matches[4] = {};
+    std::size_t dt_index = dt_begin;
+    for (; dt_index + 4 <= dt_count; dt_index += 4) {
+        for (int dt_lane = 0; dt_lane < 4; ++dt_lane) {
+            dt_matches[dt_lane] += dt_inside(dt_values[dt_index + dt_lane]);
+        }
+    }
+    for (; dt_index < dt_count; ++dt_index) {
+        dt_matches[0] += dt_inside(dt_values[dt_index]);
+    }
+    return dt_matches[0] + dt_matches[1] + dt_matches[2] + dt_matches[3];
+}
+
+template <class Better>
+void dt_extremeScalar(const std::int64_t* dt_values, std::size_t dt_begin, std::size_t dt_count, std::int64_t& dt_best,
+                      Better dt_better) {
+    // Four independent running values, so consecutive rows do not wait on each other's comparison
+    std::int64_t dt_lanes[4] = {dt_best, dt_best, dt_best, dt_best};
+    std::size_t dt_index = dt_begin;
+    for (; dt_index + 4 <= dt_count; dt_index += 4) {
+        for (int dt_lane = 0; dt_lane < 4; ++dt_lane) {
+            dt_lanes[dt_lane] = dt_better(dt_values[dt_index + dt_lane], dt_lanes[dt_lane]) ? dt_values[dt_index + dt_lane]
+                                                                                            : dt_lanes[dt_lane];
+        }
+    }
+    for (; dt_index < dt_count; ++dt_index) {
+        dt_lanes[0] = dt_better(dt_values[dt_index], dt_lanes[0]) ? dt_values[dt_index] : dt_lanes[0];
+    }
+    for (std::int64_t dt_lane : dt_lanes) {
+        dt_best = dt_better(dt_lane, dt_best) ? dt_lane : dt_best;
+    }
+}
+
+void dt_extremeScalar(const std::int64_t* dt_values, std::size_t dt_begin, std::size_t dt_count, bool dt_maximum,
+                      std::int64_t& dt_best) {
+    if (dt_maximum) {
+        dt_extremeScalar(dt_values, dt_begin, dt_count, dt_best, std::greater<std::int64_t>());
+    } else {
+        dt_extremeScalar(dt_values, dt_begin, dt_count, dt_best, std::less<std::int64_t>());
+    }
+}
+
+void dt_differenceScalar(const std::int64_t* dt_from, const std::int64_t* dt_to, std::int64_t dt_origin,
+                         std::size_t dt_begin, std::size_t dt_count, std::int64_t* dt_out) {
+    for (std::size_t dt_index = dt_begin; dt_index < dt_count; ++dt_index) {
+        dt_out[dt_index] = dt_to[dt_index] - (dt_from != nullptr ? dt_from[dt_index] : dt_origin);
+    }
+}
+
+void dt_extractScalar(const std::int64_t* dt_values, std::size_t dt_begin, std::size_t dt_count, std::int64_t dt_offset,
+                      const DateTimeColumn::FieldArrays& dt_out) {
+    for (std::size_t dt_index = dt_begin; dt_index < dt_count; ++dt_index) {
+        const std::int64_t dt_local = dt_values[dt_index] + dt_offset;
+        const std::int64_t dt_days = DateTime::floorDiv(dt_local, dt_millisecondsPerDay);
+        const std::int64_t dt_dayMilliseconds = dt_local - dt_days * dt_millisecondsPerDay;
+        const DateTime::CivilDate dt_date = DateTime::civilFromDays(dt_days);
+        auto dt_store = [dt_index](std::int32_t* dt_array, std::int64_t dt_value) {
+            if (dt_array != nullptr) {
+                dt_array[dt_index] = static_cast<std::int32_t>(dt_value);
+            }
+        };
+        dt_store(dt_out.year, dt_date.year);
+        dt_store(dt_out.month, dt_date.month);
+        dt_store(dt_out.day, dt_date.day);
+        dt_store(dt_out.hour, dt_dayMilliseconds / dt_millisecondsPerHour);
+        dt_store(dt_out.minute, dt_dayMilliseconds % dt_millisecondsPerHour / dt_millisecondsPerMinute);
+        dt_store(dt_out.second, dt_dayMilliseconds % dt_millisecondsPerMinute / dt_millisecondsPerSecond);
+        dt_store(dt_out.millisecond, dt_dayMilliseconds % dt_millisecondsPerSecond);
+        dt_store(dt_out.dayOfWeek, dt_days + 4 - DateTime::floorDiv(dt_days + 4, 7) * 7);  // 1970-01-01 was a Thursday
+    }
+}
+
+#if defined(DATETIME_HAS_X86_SIMD)
+// AVX2 kernels: four rows per 256-bit register. They return the number of rows processed;
+// the scalar kernels finish the remainder.
+DATETIME_TARGET("avx2") std::size_t dt_addAvx2(std::int64_t* dt_values, std::size_t dt_count, std::int64_t dt_delta) {
+    const __m256i dt_step = _mm256_set1_epi64x(dt_delta);
+    std::size_t dt_index = 0;
+    for (; dt_index + 4 <= dt_count; dt_index += 4) {
+        __m256i* dt_block = reinterpret_cast<__m256i*>(dt_values + dt_index);
+        _mm256_storeu_si256(dt_block, _mm256_add_epi64(_mm256_loadu_si256(dt_block), dt_step));
+    }
+    return dt_index;
+}
+
+// Bit i of the result is set when row i of the block lies in [dt_from, dt_to)
+DATETIME_TARGET("avx2") inline unsigned dt_rangeMask(const std::int64_t* dt_row, __m256i dt_from, __m256i dt_to) {
+    const __m256i dt_block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dt_row));
+    const __m256i dt_before = _mm256_cmpgt_epi64(dt_from, dt_block);
+    const __m256i dt_inside = _mm256_andnot_si256(dt_before, _mm256_cmpgt_epi64(dt_to, dt_block));
+    return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(dt_inside)));
+}
+
+template <class Visit>
+DATETIME_TARGET("avx2") std::size_t dt_rangeAvx2(const std::int64_t* dt_values, std::size_t dt_count, std::int64_t dt_from,
+                                                 std::int64_t dt_to, Visit&& dt_visit) {
+    const __m256i dt_lower = _mm256_set1_epi64x(dt_from);
+    const __m256i dt_upper = _mm256_set1_epi64x(dt_to);
+    std::size_t dt_index = 0;
+    for (; dt_index + 4 <= dt_count; dt_index += 4) {
+        for (unsigned dt_mask = dt_rangeMask(dt_values + dt_index, dt_lower, dt_upper); dt_mask != 0; dt_mask &= dt_mask - 1) {
+            dt_visit(dt_index + static_cast<std::size_t>(__builtin_ctz(dt_mask)));
+        }
+    }
+    return dt_index;
+}
+
+DATETIME_TARGET("avx2") std::size_t dt_countAvx2(const std::int64_t* dt_values, std::size_t dt_count, std::int64_t dt_from,
+                                                 std::int64_t dt_to, std::size_t& dt_matches) {
+    const __m256i dt_lower = _mm256_set1_epi64x(dt_from);
+    const __m256i dt_upper = _mm256_set1_epi64x(dt_to);
+    std::size_t dt_index = 0;
+    for (; dt_index + 4 <= dt_count; dt_index += 4) {
+        dt_matches += static_cast<std::size_t>(__builtin_popcount(dt_rangeMask(dt_values + dt_index, dt_lower, dt_upper)));
+    }
+    return dt_index;
+}
+
+DATETIME_TARGET("avx2") std::size_t dt_extremeAvx2(const std::int64_t* dt_values, std::size_t dt_count, bool dt_maximum,
+                                                   std::int64_t& dt_best) {
+    if (dt_count < 4) {
+        return 0;
+    }
+    __m256i dt_accumulator = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dt_values));
+    std::size_t dt_index = 4;
+    for (; dt_index + 4 <= dt_count; dt_index += 4) {
+        const __m256i dt_block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dt_values + dt_index));
+        // Replace lanes where the block wins (AVX2 has no 64-bit min/max)
+        const __m256i dt_wins = dt_maximum ? _mm256_cmpgt_epi64(dt_block, dt_accumulator)
+                                           : _mm256_cmpgt_epi64(dt_accumulator, dt_block);
+        dt_accumulator = _mm256_blendv_epi8(dt_accumulator, dt_block, dt_wins);
+    }
+    alignas(32) std::int64_t dt_lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(dt_lanes), dt_accumulator);
+    dt_extremeScalar(dt_lanes, 0, 4, dt_maximum, dt_best);
+    return dt_index;
+}
+
+DATETIME_TARGET("avx2") std::size_t dt_differenceAvx2(const std::int64_t* dt_from, const std::int64_t* dt_to,
+                                                      std::int64_t dt_origin, std::size_t dt_count, std::int64_t* dt_out) {
+    const __m256i dt_base = _mm256_set1_epi64x(dt_origin);
+    std::size_t dt_index = 0;
+    for (; dt_index + 4 <= dt_count; dt_index += 4) {
+        const __m256i dt_start = dt_from != nullptr
+                                     ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dt_from + dt_index))
+                                     : dt_base;
+        const __m256i dt_end = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dt_to + dt_index));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dt_out + dt_index), _mm256_sub_epi64(dt_end, dt_start));
+    }
+    return dt_index;
+}
+
+// Field extraction in double lanes: every intermediate is an integer below 2^53, so products and
+// differences are exact. For an integer x, x / d is at least 1/d away from the next integer unless
+// exact, so floor((x + 0.5) * (1 / d)) is the exact floor quotient while the rounding error of
+// the multiply stays below 0.5 / d, i.e. for |x| < 2^49. Branch-free; the month wrap-around and
+// leap carry use compare masks.
+DATETIME_TARGET("avx2") inline __m256d dt_floorDivPd(__m256d dt_value, double dt_divisor) {
+    return _mm256_floor_pd(_mm256_mul_pd(_mm256_add_pd(dt_value, _mm256_set1_pd(0.5)), _mm256_set1_pd(1.0 / dt_divisor)));
+}
+
+// dt_value - dt_quotient * dt_divisor
+DATETIME_TARGET("avx2") inline __m256d dt_remainderPd(__m256d dt_value, __m256d dt_quotient, double dt_divisor) {
+    return _mm256_sub_pd(dt_value, _mm256_mul_pd(dt_quotient, _mm256_set1_pd(dt_divisor)));
+}
+
+DATETIME_TARGET("avx2") inline void dt_storeLanes(std::int32_t* dt_array, std::size_t dt_index, __m256d dt_value) {
+    if (dt_array != nullptr) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dt_array + dt_index), _mm256_cvttpd_epi32(dt_value));
+    }
+}
+
+DATETIME_TARGET("avx2") std::size_t dt_extractAvx2(const std::int64_t* dt_values, std::size_t dt_count, std::int64_t dt_offset,
+                                                   const DateTimeColumn::FieldArrays& dt_out) {
+    // int64 -> double via the 1.5 * 2^52 bias (exact for |value| < 2^51)
+    const __m256d dt_bias = _mm256_set1_pd(6755399441055744.0);
+    const __m256i dt_limit = _mm256_set1_epi64x((std::int64_t{1} << 49) - 1);
+    const __m256i dt_negativeLimit = _mm256_set1_epi64x(-((std::int64_t{1} << 49) - 1));
+    const __m256i dt_offsetLanes = _mm256_set1_epi64x(dt_offset);
+    std::size_t dt_index = 0;
+    for (; dt_index + 4 <= dt_count; dt_index += 4) {
+        const __m256i dt_local = _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(dt_values + dt_index)),
+                                                  dt_offsetLanes);
+        const __m256i dt_outside = _mm256_or_si256(_mm256_cmpgt_epi64(dt_local, dt_limit),
+                                                   _mm256_cmpgt_epi64(dt_negativeLimit, dt_local));
+        if (!_mm256_testz_si256(dt_outside, dt_outside)) {
+            dt_extractScalar(dt_values, dt_index, dt_index + 4, dt_offset, dt_out);
+            continue;
+        }
+        const __m256d dt_milliseconds = _mm256_sub_pd(
+            _mm256_castsi256_pd(_mm256_add_epi64(dt_local, _mm256_castpd_si256(dt_bias))), dt_bias);
+
+        // Time of day
+        const __m256d dt_days = dt_floorDivPd(dt_milliseconds, static_cast<double>(dt_millisecondsPerDay));
+        const __m256d dt_dayMilliseconds = dt_remainderPd(dt_milliseconds, dt_days, static_cast<double>(dt_millisecondsPerDay));
+        const __m256d dt_hour = dt_floorDivPd(dt_dayMilliseconds, static_cast<double>(dt_millisecondsPerHour));
+        const __m256d dt_hourMilliseconds = dt_remainderPd(dt_dayMilliseconds, dt_hour, static_cast<double>(dt_millisecondsPerHour));
+        const __m256d dt_minute = dt_floorDivPd(dt_hourMilliseconds, static_cast<double>(dt_millisecondsPerMinute));
+        const __m256d dt_minuteMilliseconds = dt_remainderPd(dt_hourMilliseconds, dt_minute, static_cast<double>(dt_millisecondsPerMinute));
+        const __m256d dt_second = dt_floorDivPd(dt_minuteMilliseconds, static_cast<double>(dt_millisecondsPerSecond));
+        const __m256d dt_millisecond = dt_remainderPd(dt_minuteMilliseconds, dt_second, static_cast<double>(dt_millisecondsPerSecond));
+
+        // Weekday: 1970-01-01 was a Thursday
+        const __m256d dt_shifted = _mm256_add_pd(dt_days, _mm256_set1_pd(4.0));
+        const __m256d dt_weekday = dt_remainderPd(dt_shifted, dt_floorDivPd(dt_shifted, 7.0), 7.0);
+
+        // Civil date (Howard Hinnant's civil_from_days, as DateTime::civilFromDays)
+        const __m256d dt_shiftedDays = _mm256_add_pd(dt_days, _mm256_set1_pd(719468.0));
+        const __m256d dt_era = dt_floorDivPd(dt_shiftedDays, 146097.0);
+        const __m256d dt_dayOfEra = dt_remainderPd(dt_shiftedDays, dt_era, 146097.0);
+        const __m256d dt_yearOfEra = dt_floorDivPd(
+            _mm256_sub_pd(_mm256_add_pd(_mm256_sub_pd(dt_dayOfEra, dt_floorDivPd(dt_dayOfEra, 1460.0)),
+                                        dt_floorDivPd(dt_dayOfEra, 36524.0)),
+                          dt_floorDivPd(dt_dayOfEra, 146096.0)),
+            365.0);
+        const __m256d dt_dayOfYear = _mm256_sub_pd(
+            dt_dayOfEra, _mm256_sub_pd(_mm256_add_pd(_mm256_mul_pd(dt_yearOfEra, _mm256_set1_pd(365.0)),
+                                                     dt_floorDivPd(dt_yearOfEra, 4.0)),
+                                       dt_floorDivPd(dt_yearOfEra, 100.0)));
+        const __m256d dt_marchMonth = dt_floorDivPd(
+            _mm256_add_pd(_mm256_mul_pd(dt_dayOfYear, _mm256_set1_pd(5.0)), _mm256_set1_pd(2.0)), 153.0);
+        const __m256d dt_day = _mm256_add_pd(
+            _mm256_sub_pd(dt_dayOfYear, dt_floorDivPd(_mm256_add_pd(_mm256_mul_pd(dt_marchMonth, _mm256_set1_pd(153.0)),
+                                                                    _mm256_set1_pd(2.0)),
+                                                      5.0)),
+            _mm256_set1_pd(1.0));
+        const __m256d dt_wraps = _mm256_cmp_pd(dt_marchMonth, _mm256_set1_pd(10.0), _CMP_GE_OQ);
+        const __m256d dt_month = _mm256_sub_pd(_mm256_add_pd(dt_marchMonth, _mm256_set1_pd(3.0)),
+                                               _mm256_and_pd(dt_wraps, _mm256_set1_pd(12.0)));
+        const __m256d dt_year = _mm256_add_pd(_mm256_add_pd(dt_yearOfEra, _mm256_mul_pd(dt_era, _mm256_set1_pd(400.0))),
+                                              _mm256_and_pd(dt_wraps, _mm256_set1_pd(1.0)));
+
+        dt_storeLanes(dt_out.year, dt_index, dt_year);
+        dt_storeLanes(dt_out.month, dt_index, dt_month);
+        dt_storeLanes(dt_out.day, dt_index, dt_day);
+        dt_storeLanes(dt_out.hour, dt_index, dt_hour);
+        dt_storeLanes(dt_out.minute, dt_index, dt_minute);
+        dt_storeLanes(dt_out.second, dt_index, dt_second);
+        dt_storeLanes(dt_out.millisecond, dt_index, dt_millisecond);
+        dt_storeLanes(dt_out.dayOfWeek, dt_index, dt_weekday);
+    }
+    return dt_index;
+}
+#endif
+
+// Shared driver for both timeBetween forms; dt_from == nullptr means "from dt_origin"
+void dt_difference(Isa dt_isa, const std::int64_t* dt_from, const std::int64_t* dt_to, std::int64_t dt_origin,
+                   std::size_t dt_count, std::int64_t* dt_out) {
+    std::size_t dt_done = 0;
+#if defined(DATETIME_HAS_X86_SIMD)
+    if (dt_isa == Isa::Avx2) {
+        dt_done = dt_differenceAvx2(dt_from, dt_to, dt_origin, dt_count, dt_out);
+    }
+#endif
+    dt_differenceScalar(dt_from, dt_to, dt_origin, dt_done, dt_count, dt_out);
+}
+
+} // namespace
+
+DateTimeColumn::DateTimeColumn(DateTime::RegionHandle dt_region) : dt_region(dt_region) {}
+
+DateTimeColumn::DateTimeColumn(std::vector<std::int64_t> dt_epochMilliseconds, DateTime::RegionHandle dt_region)
+    : dt_values(std::move(dt_epochMilliseconds)), dt_region(dt_region) {}
+
+DateTimeColumn::DateTimeColumn(const std::vector<DateTime>& dt_source)
+    : dt_region(dt_source.empty() ? DateTime::RegionHandle::World : dt_source.front().getRegionHandle()) {
+    reserve(dt_source.size());
+    for (const DateTime& dt_value : dt_source) {
+        push_back(dt_value);
+    }
+}
+
+void DateTimeColumn::push_back(const DateTime& dt_value) {
+    const DateTime::RegionHandle dt_valueRegion = dt_value.getRegionHandle();
+    if (dt_rowRegions.empty() && dt_valueRegion != dt_region) {
+        // First row in another region: switch to per-row handles
+        dt_rowRegions.assign(dt_values.size(), dt_region);
+    }
+    if (!dt_rowRegions.empty()) {
+        dt_rowRegions.push_back(dt_valueRegion);
+    }
+    dt_values.push_back(dt_toMilliseconds(dt_value));
+}
+
+void DateTimeColumn::reserve(std::size_t dt_count) {
+    dt_values.reserve(dt_count);
+}
+
+void DateTimeColumn::clear() {
+    dt_values.clear();
+    dt_rowRegions.clear();
+}
+
+DateTime DateTimeColumn::operator[](std::size_t dt_row) const {
+    return DateTime(std::chrono::system_clock::time_point(std::chrono::milliseconds(dt_values[dt_row])), region(dt_row));
+}
+
+DateTime::RegionHandle DateTimeColumn::region(std::size_t dt_row) const {
+    return dt_rowRegions.empty() ? dt_region : dt_rowRegions[dt_row];
+}
+
+template <class Visit>
+void DateTimeColumn::forEachRegionRun(Visit&& dt_visit) {
+    if (dt_rowRegions.empty()) {
+        dt_visit(dt_values.data(), dt_values.size(), dt_region);
+        return;
+    }
+    // Maximal runs of consecutive rows sharing a region
+    std::size_t dt_start = 0;
+    while (dt_start < dt_values.size()) {
+        std::size_t dt_end = dt_start + 1;
+        while (dt_end < dt_values.size() && dt_rowRegions[dt_end] == dt_rowRegions[dt_start]) {
+            ++dt_end;
+        }
+        dt_visit(dt_values.data() + dt_start, dt_end - dt_start, dt_rowRegions[dt_start]);
+        dt_start = dt_end;
+    }
+}
+
+DateTimeColumn::Isa DateTimeColumn::resolvedIsa() const {
+    return dt_resolveIsa(dt_isa);
+}
+
+DateTimeColumn& DateTimeColumn::plusDays(int dt_days) {
+    return plusMilliseconds(dt_days * dt_millisecondsPerDay);
+}
+
+DateTimeColumn& DateTimeColumn::plusHours(int dt_hours) {
+    return plusMilliseconds(dt_hours * dt_millisecondsPerHour);
+}
+
+DateTimeColumn& DateTimeColumn::plusMinutes(int dt_minutes) {
+    return plusMilliseconds(dt_minutes * dt_millisecondsPerMinute);
+}
+
+DateTimeColumn& DateTimeColumn::plusSeconds(int dt_seconds) {
+    return plusMilliseconds(dt_seconds * dt_millisecondsPerSecond);
+}
+
+DateTimeColumn& DateTimeColumn::plusMilliseconds(std::int64_t dt_milliseconds) {
+    std::size_t dt_done = 0;
+#if defined(DATETIME_HAS_X86_SIMD)
+    if (resolvedIsa() == Isa::Avx2) {
+        dt_done = dt_addAvx2(dt_values.data(), dt_values.size(), dt_milliseconds);
+    }
+#endif
+    dt_addScalar(dt_values.data(), dt_done, dt_values.size(), dt_milliseconds);
+    return *this;
+}
+
+DateTimeColumn& DateTimeColumn::floorTo(DateTime::TimeUnit dt_unit) {
+    forEachRegionRun([dt_unit](std::int64_t* dt_rows, std::size_t dt_count, DateTime::RegionHandle dt_runRegion) {
+        DateTime::floorTo(dt_rows, dt_count, dt_unit, dt_runRegion, dt_rows);
+    });
+    return *this;
+}
+
+DateTimeColumn& DateTimeColumn::ceilTo(DateTime::TimeUnit dt_unit) {
+    forEachRegionRun([dt_unit](std::int64_t* dt_rows, std::size_t dt_count, DateTime::RegionHandle dt_runRegion) {
+        DateTime::ceilTo(dt_rows, dt_count, dt_unit, dt_runRegion, dt_rows);
+    });
+    return *this;
+}
+
+std::size_t DateTimeColumn::countInRange(const DateTime& dt_from, const DateTime& dt_to) const {
+    const std::int64_t dt_lower = dt_toMilliseconds(dt_from);
+    const std::int64_t dt_upper = dt_toMilliseconds(dt_to);
+    std::size_t dt_matches = 0;
+    std::size_t dt_done = 0;
+#if defined(DATETIME_HAS_X86_SIMD)
+    if (resolvedIsa() == Isa::Avx2) {
+        dt_done = dt_countAvx2(dt_values.data(), dt_values.size(), dt_lower, dt_upper, dt_matches);
+    }
+#endif
+    return dt_matches + dt_countScalar(dt_values.data(), dt_done, dt_values.size(), dt_lower, dt_upper);
+}
+
+std::vector<std::size_t> DateTimeColumn::filterRange(const DateTime& dt_from, const DateTime& dt_to) const {
+    const std::int64_t dt_lower = dt_toMilliseconds(dt_from);
+    const std::int64_t dt_upper = dt_toMilliseconds(dt_to);
+    std::vector<std::size_t> dt_rows;
+    auto dt_append = [&dt_rows](std::size_t dt_row) { dt_rows.push_back(dt_row); };
+    std::size_t dt_done = 0;
+#if defined(DATETIME_HAS_X86_SIMD)
+    if (resolvedIsa() == Isa::Avx2) {
+        dt_done = dt_rangeAvx2(dt_values.data(), dt_values.size(), dt_lower, dt_upper, dt_append);
+    }
+#endif
+    dt_rangeScalar(dt_values.data(), dt_done, dt_values.size(), dt_lower, dt_upper, dt_append);
+    return dt_rows;
+}
+
+std::optional<DateTime> DateTimeColumn::extreme(bool dt_maximum) const {
+    if (dt_values.empty()) {
+        return std::nullopt;
+    }
+    std::int64_t dt_best = dt_values.front();
+    std::size_t dt_done = 0;
+#if defined(DATETIME_HAS_X86_SIMD)
+    if (resolvedIsa() == Isa::Avx2) {
+        dt_done = dt_extremeAvx2(dt_values.data(), dt_values.size(), dt_maximum, dt_best);
+    }
+#endif
+    dt_extremeScalar(dt_values.data(), dt_done, dt_values.size(), dt_maximum, dt_best);
+    DateTime::RegionHandle dt_bestRegion = dt_region;
+    if (!dt_rowRegions.empty()) {
+        // The first row holding the value supplies the region
+        dt_bestRegion = dt_rowRegions[static_cast<std::size_t>(std::find(dt_values.begin(), dt_values.end(), dt_best) -
+                                                               dt_values.begin())];
+    }
+    return DateTime(std::chrono::system_clock::time_point(std::chrono::milliseconds(dt_best)), dt_bestRegion);
+}
+
+std::optional<DateTime> DateTimeColumn::min() const {
+    return extreme(false);
+}
+
+std::optional<DateTime> DateTimeColumn::max() const {
+    return extreme(true);
+}
+
+void DateTimeColumn::timeBetween(const DateTimeColumn& dt_from, const DateTimeColumn& dt_to, std::int64_t* dt_out) {
+    if (dt_from.size() != dt_to.size()) {
+        throw DateTimeException("DateTimeColumn::timeBetween requires columns of equal size");
+    }
+    dt_difference(dt_to.resolvedIsa(), dt_from.data(), dt_to.data(), 0, dt_to.size(), dt_out);
+}
+
+void DateTimeColumn::timeBetween(const DateTime& dt_origin, std::int64_t* dt_out) const {
+    dt_difference(resolvedIsa(), nullptr, dt_values.data(), dt_toMilliseconds(dt_origin), dt_values.size(), dt_out);
+}
+
+void DateTimeColumn::extractFields(const std::int64_t* dt_epochMilliseconds, std::size_t dt_count,
+                                   std::chrono::seconds dt_utcOffset, const FieldArrays& dt_out, Isa dt_isa) {
+    const std::int64_t dt_offset = dt_utcOffset.count() * dt_millisecondsPerSecond;
+    std::size_t dt_done = 0;
+#if defined(DATETIME_HAS_X86_SIMD)
+    if (dt_resolveIsa(dt_isa) == Isa::Avx2) {
+        dt_done = dt_extractAvx2(dt_epochMilliseconds, dt_count, dt_offset, dt_out);
+    }
+#else
+    (void)dt_isa;
+#endif
+    dt_extractScalar(dt_epochMilliseconds, dt_done, dt_count, dt_offset, dt_out);
+}
+
+void DateTimeColumn::extractFields(const std::int64_t* dt_epochMilliseconds, std::size_t dt_count,
+                                   DateTime::RegionHandle dt_region, const FieldArrays& dt_out, Isa dt_isa) {
+    const DT_RegionOffset dt_offset(dt_region);
+    if (dt_offset.isFixed()) {
+        extractFields(dt_epochMilliseconds, dt_count, std::chrono::seconds(dt_offset.at(0) / dt_millisecondsPerSecond),
+                      dt_out, dt_isa);
+        return;
+    }
+    // Zone: shift a block of rows to local time, then extract it at offset zero
+    constexpr std::size_t dt_blockRows = 256;
+    std::int64_t dt_local[dt_blockRows];
+    for (std::size_t dt_start = 0; dt_start < dt_count; dt_start += dt_blockRows) {
+        const std::size_t dt_rows = std::min(dt_blockRows, dt_count - dt_start);
+        for (std::size_t dt_index = 0; dt_index < dt_rows; ++dt_index) {
+            const std::int64_t dt_value = dt_epochMilliseconds[dt_start + dt_index];
+            dt_local[dt_index] = dt_value + dt_offset.at(dt_value);
+        }
+        extractFields(dt_local, dt_rows, std::chrono::seconds(0), dt_advance(dt_out, dt_start), dt_isa);
+    }
+}
+
+void DateTimeColumn::extractFields(const FieldArrays& dt_out) const {
+    if (dt_rowRegions.empty()) {
+        extractFields(dt_values.data(), dt_values.size(), dt_region, dt_out, dt_isa);
+        return;
+    }
+    // Per-row regions: shift a block of rows to local time, then extract it at offset zero
+    constexpr std::size_t dt_blockRows = 256;
+    std::int64_t dt_local[dt_blockRows];
+    DateTime::RegionHandle dt_cachedRegion = dt_rowRegions.front();
+    DT_RegionOffset dt_cachedOffset(dt_cachedRegion);
+    for (std::size_t dt_start = 0; dt_start < dt_values.size(); dt_start += dt_blockRows) {
+        const std::size_t dt_rows = std::min(dt_blockRows, dt_values.size() - dt_start);
+        for (std::size_t dt_index = 0; dt_index < dt_rows; ++dt_index) {
+            if (dt_rowRegions[dt_start + dt_index] != dt_cachedRegion) {
+                dt_cachedRegion = dt_rowRegions[dt_start + dt_index];
+                dt_cachedOffset = DT_RegionOffset(dt_cachedRegion);
+            }
+            const std::int64_t dt_value = dt_values[dt_start + dt_index];
+            dt_local[dt_index] = dt_value + dt_cachedOffset.at(dt_value);
+        }
+        extractFields(dt_local, dt_rows, std::chrono::seconds(0), dt_advance(dt_out, dt_start), dt_isa);
+    }
+}
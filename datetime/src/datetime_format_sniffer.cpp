@@ -0,0 +1,165 @@
+#include "datetime_format_sniffer.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr std::size_t dt_syslogYearLength = 5;   // "YYYY " prepended to syslog timestamps
+constexpr std::size_t dt_syslogMaxLength = 32;   // Syslog timestamps are 15 characters
+
+DateTime::ParseResult dt_failure(DateTime::ParseError dt_error, std::size_t dt_position) {
+    return {DateTime(std::chrono::system_clock::time_point{}), dt_error, dt_position};
+}
+
+// Leading run of digits as epoch seconds or milliseconds
+DateTime::ParseResult dt_parseEpoch(std::string_view dt_line, bool dt_milliseconds) {
+    std::size_t dt_length = 0;
+    std::int64_t dt_value = 0;
+    while (dt_length < dt_line.size() && dt_length < 15 && dt_line[dt_length] >= '0' && dt_line[dt_length] <= '9') {
+        dt_value = dt_value * 10 + (dt_line[dt_length] - '0');
+        ++dt_length;
+    }
+    if (dt_length == 0) {
+        return dt_failure(dt_line.empty() ? DateTime::ParseError::UnexpectedEnd : DateTime::ParseError::ExpectedDigit, 0);
+    }
+    const bool dt_fits = dt_milliseconds ? (dt_length >= 12 && dt_length <= 14) : (dt_length >= 9 && dt_length <= 11);
+    if (!dt_fits) {
+        return dt_failure(DateTime::ParseError::FieldOutOfRange, 0);
+    }
+    if (dt_length < dt_line.size() && dt_line[dt_length] >= '0' && dt_line[dt_length] <= '9') {
+        return dt_failure(DateTime::ParseError::FieldOutOfRange, 0);
+    }
+    const auto dt_sinceEpoch = dt_milliseconds ? std::chrono::milliseconds(dt_value)
+                                               : std::chrono::milliseconds(std::chrono::seconds(dt_value));
+    return {DateTime(std::chrono::system_clock::time_point(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(dt_sinceEpoch))),
+            DateTime::ParseError::None, dt_length};
+}
+
+} // namespace
+
+DateTimeFormatSniffer::DateTimeFormatSniffer(std::size_t dt_samples, int dt_syslogYear)
+    : dt_samples(std::max<std::size_t>(dt_samples, 1)),
+      dt_syslogYear(dt_syslogYear != 0 ? dt_syslogYear : DateTime::now(DateTime::ClockSource::Coarse).getYear()) {
+    // Built-in candidates in tie-break order
+    dt_candidates.push_back(Candidate{Format::Iso8601, std::nullopt, 0, 0});
+    dt_candidates.push_back(Candidate{Format::Rfc1123, DateTime::ParsePattern("%a, %d %b %Y %H:%M:%S GMT"), 0, 0});
+    dt_candidates.push_back(Candidate{Format::Apache, DateTime::ParsePattern("%d/%b/%Y:%H:%M:%S %z"), 0, 0});
+    dt_candidates.push_back(Candidate{Format::Syslog, DateTime::ParsePattern("%Y %b %e %H:%M:%S"), 0, 0});
+    dt_candidates.push_back(Candidate{Format::EpochSeconds, std::nullopt, 0, 0});
+    dt_candidates.push_back(Candidate{Format::EpochMilliseconds, std::nullopt, 0, 0});
+}
+
+void DateTimeFormatSniffer::addPattern(std::string_view dt_pattern) {
+    dt_candidates.push_back(Candidate{Format::Custom, DateTime::ParsePattern(dt_pattern), dt_customCount++, 0});
+}
+
+std::size_t DateTimeFormatSniffer::customPatternIndex() const {
+    return dt_locked ? dt_candidates[dt_lockedCandidate].customIndex : 0;
+}
+
+DateTime::ParseResult DateTimeFormatSniffer::tryCandidate(const Candidate& dt_candidate, std::string_view dt_line) const {
+    switch (dt_candidate.format) {
+        case Format::Iso8601:
+            return DateTime::parseIso8601(dt_line, DateTime::ParseMode::Prefix);
+        case Format::EpochSeconds:
+            return dt_parseEpoch(dt_line, false);
+        case Format::EpochMilliseconds:
+            return dt_parseEpoch(dt_line, true);
+        case Format::Syslog: {
+            // Supply the missing year in a stack buffer ahead of the line
+            char dt_buffer[dt_syslogYearLength + dt_syslogMaxLength];
+            const std::size_t dt_length = std::min(dt_line.size(), dt_syslogMaxLength);
+            const int dt_year = std::clamp(dt_syslogYear, 1900, 9999);
+            dt_buffer[0] = static_cast<char>('0' + dt_year / 1000);
+            dt_buffer[1] = static_cast<char>('0' + dt_year / 100 % 10);
+            dt_buffer[2] = static_cast<char>('0' + dt_year / 10 % 10);
+            dt_buffer[3] = static_cast<char>('0' + dt_year % 10);
+            dt_buffer[4] = ' ';
+            std::memcpy(dt_buffer + dt_syslogYearLength, dt_line.data(), dt_length);
+            DateTime::ParseResult dt_result = DateTime::parse(std::string_view(dt_buffer, dt_syslogYearLength + dt_length),
+                                                              *dt_candidate.pattern, DateTime::ParseMode::Prefix);
+            dt_result.position = dt_result.position >= dt_syslogYearLength ? dt_result.position - dt_syslogYearLength : 0;
+            return dt_result;
+        }
+        case Format::Rfc1123:
+        case Format::Apache:
+        case Format::Custom:
+            return DateTime::parse(dt_line, *dt_candidate.pattern, DateTime::ParseMode::Prefix);
+        case Format::Unknown:
+            break;
+    }
+    return dt_failure(DateTime::ParseError::ExpectedLiteral, 0);
+}
+
+DateTime::ParseResult DateTimeFormatSniffer::parse(std::string_view dt_line) {
+    // Fast path: the locked format
+    if (dt_locked) {
+        DateTime::ParseResult dt_result = tryCandidate(dt_candidates[dt_lockedCandidate], dt_line);
+        if (dt_result) {
+            ++dt_statistics.hits;
+            return dt_result;
+        }
+        ++dt_statistics.misses;
+        dt_locked = false;
+        dt_samplesSeen = 0;
+        for (Candidate& dt_candidate : dt_candidates) {
+            dt_candidate.votes = 0;
+        }
+    }
+
+    // Detection: every candidate votes on the line, the first match is returned
+    std::optional<DateTime::ParseResult> dt_first;
+    DateTime::ParseResult dt_bestFailure = dt_failure(DateTime::ParseError::ExpectedLiteral, 0);
+    for (Candidate& dt_candidate : dt_candidates) {
+        DateTime::ParseResult dt_result = tryCandidate(dt_candidate, dt_line);
+        if (dt_result) {
+            ++dt_candidate.votes;
+            if (!dt_first) {
+                dt_first = dt_result;
+            }
+        } else if (dt_result.position > dt_bestFailure.position) {
+            dt_bestFailure = dt_result;
+        }
+    }
+    if (!dt_first) {
+        ++dt_statistics.failures;
+        return dt_bestFailure;
+    }
+
+    if (++dt_samplesSeen >= dt_samples) {
+        std::size_t dt_winner = 0;
+        for (std::size_t dt_index = 1; dt_index < dt_candidates.size(); ++dt_index) {
+            if (dt_candidates[dt_index].votes > dt_candidates[dt_winner].votes) {
+                dt_winner = dt_index;
+            }
+        }
+        dt_locked = true;
+        dt_lockedCandidate = dt_winner;
+        ++dt_statistics.detections;
+    }
+    return *dt_first;
+}
+
+void DateTimeFormatSniffer::reset() {
+    dt_locked = false;
+    dt_samplesSeen = 0;
+    dt_statistics = Statistics{};
+    for (Candidate& dt_candidate : dt_candidates) {
+        dt_candidate.votes = 0;
+    }
+}
+
+const char* DateTimeFormatSniffer::formatName(Format dt_format) {
+    switch (dt_format) {
+        case Format::Unknown: return "unknown";
+        case Format::Iso8601: return "ISO-8601";
+        case Format::Rfc1123: return "RFC 1123";
+        case Format::Apache: return "Apache";
+        case Format::Syslog: return "syslog";
+        case Format::EpochSeconds: return "epoch seconds";
+        case Format::EpochMilliseconds: return "epoch milliseconds";
+        case Format::Custom: return "custom";
+    }
+    return "unknown";
+}
@@ -0,0 +1,232 @@
+#include "datetime_parallel.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr std::uint64_t dt_packRange(std::uint64_t dt_next, std::uint64_t dt_end) {
+    return (dt_end << 32) | dt_next;
+}
+
+} // namespace
+
+DateTimeParallelExecutor::DateTimeParallelExecutor(std::size_t dt_threadCount, std::size_t dt_chunkRows)
+    : dt_chunkRows(std::max<std::size_t>(dt_chunkRows, 1)) {
+    if (dt_threadCount == 0) {
+        dt_threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    dt_scratch.resize(dt_threadCount);
+    dt_ranges = std::make_unique<ChunkRange[]>(dt_threadCount);
+    dt_threads.reserve(dt_threadCount - 1);
+    for (std::size_t dt_worker = 1; dt_worker < dt_threadCount; ++dt_worker) {
+        dt_threads.emplace_back(&DateTimeParallelExecutor::workerLoop, this, dt_worker);
+    }
+}
+
+DateTimeParallelExecutor::~DateTimeParallelExecutor() {
+    dt_stopping.store(true, std::memory_order_relaxed);
+    dt_generation.fetch_add(1, std::memory_order_release);
+    dt_generation.notify_all();
+    for (std::thread& dt_thread : dt_threads) {
+        dt_thread.join();
+    }
+}
+
+bool DateTimeParallelExecutor::takeChunk(std::size_t dt_worker, std::size_t& dt_chunk) {
+    // Own range first (front), then steal from the back of the others
+    std::atomic<std::uint64_t>& dt_own = dt_ranges[dt_worker].range;
+    std::uint64_t dt_range = dt_own.load(std::memory_order_acquire);
+    while ((dt_range & 0xFFFFFFFFu) < (dt_range >> 32)) {
+        if (dt_own.compare_exchange_weak(dt_range, dt_range + 1, std::memory_order_acq_rel)) {
+            dt_chunk = static_cast<std::size_t>(dt_range & 0xFFFFFFFFu);
+            return true;
+        }
+    }
+    const std::size_t dt_workers = dt_scratch.size();
+    for (std::size_t dt_step = 1; dt_step < dt_workers; ++dt_step) {
+        std::atomic<std::uint64_t>& dt_victim = dt_ranges[(dt_worker + dt_step) % dt_workers].range;
+        dt_range = dt_victim.load(std::memory_order_acquire);
+        while ((dt_range & 0xFFFFFFFFu) < (dt_range >> 32)) {
+            const std::uint64_t dt_end = (dt_range >> 32) - 1;
+            if (dt_victim.compare_exchange_weak(dt_range, dt_packRange(dt_range & 0xFFFFFFFFu, dt_end),
+                                                std::memory_order_acq_rel)) {
+                dt_chunk = static_cast<std::size_t>(dt_end);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void DateTimeParallelExecutor::runWorker(std::size_t dt_worker) {
+    std::size_t dt_chunk = 0;
+    while (takeChunk(dt_worker, dt_chunk)) {
+        const std::size_t dt_begin = dt_chunk * dt_chunkRows;
+        const std::size_t dt_end = std::min(dt_begin + dt_chunkRows, dt_count);
+        try {
+            (*dt_task)(dt_begin, dt_end, dt_chunk, dt_scratch[dt_worker]);
+        } catch (...) {
+            std::lock_guard<std::mutex> dt_lock(dt_errorMutex);
+            if (!dt_error) {
+                dt_error = std::current_exception();
+            }
+        }
+    }
+}
+
+void DateTimeParallelExecutor::workerLoop(std::size_t dt_worker) {
+    std::uint64_t dt_seen = 0;
+    for (;;) {
+        // Sleep until the next batch (or shutdown) bumps the generation
+        dt_generation.wait(dt_seen, std::memory_order_acquire);
+        dt_seen = dt_generation.load(std::memory_order_acquire);
+        if (dt_stopping.load(std::memory_order_relaxed)) {
+            return;
+        }
+        runWorker(dt_worker);
+        if (dt_active.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            dt_active.notify_one();
+        }
+    }
+}
+
+void DateTimeParallelExecutor::forEachChunk(std::size_t dt_rows, const ChunkTask& dt_chunkTask) {
+    std::lock_guard<std::mutex> dt_batchLock(dt_batchMutex);
+    runChunksLocked(dt_rows, dt_chunkTask);
+}
+
+void DateTimeParallelExecutor::runChunksLocked(std::size_t dt_rows, const ChunkTask& dt_chunkTask) {
+    if (dt_rows == 0) {
+        return;
+    }
+    const std::size_t dt_chunks = (dt_rows + dt_chunkRows - 1) / dt_chunkRows;
+    const std::size_t dt_workers = dt_scratch.size();
+
+    // Small batches and single-threaded executors run inline
+    if (dt_chunks == 1 || dt_workers == 1) {
+        for (std::size_t dt_chunk = 0; dt_chunk < dt_chunks; ++dt_chunk) {
+            const std::size_t dt_begin = dt_chunk * dt_chunkRows;
+            dt_chunkTask(dt_begin, std::min(dt_begin + dt_chunkRows, dt_rows), dt_chunk, dt_scratch[0]);
+        }
+        return;
+    }
+
+    // Contiguous initial ranges keep neighbouring chunks on one core
+    for (std::size_t dt_worker = 0; dt_worker < dt_workers; ++dt_worker) {
+        dt_ranges[dt_worker].range.store(dt_packRange(dt_chunks * dt_worker / dt_workers, dt_chunks * (dt_worker + 1) / dt_workers),
+                                         std::memory_order_relaxed);
+    }
+    dt_task = &dt_chunkTask;
+    dt_count = dt_rows;
+    dt_error = nullptr;
+    dt_active.store(dt_workers - 1, std::memory_order_relaxed);
+    dt_generation.fetch_add(1, std::memory_order_release);
+    dt_generation.notify_all();
+    runWorker(0);
+
+    // Wait for the helpers; their decrements make the chunk outputs visible here
+    for (std::size_t dt_remaining; (dt_remaining = dt_active.load(std::memory_order_acquire)) != 0;) {
+        dt_active.wait(dt_remaining, std::memory_order_acquire);
+    }
+    dt_task = nullptr;
+    if (dt_error) {
+        std::rethrow_exception(dt_error);
+    }
+}
+
+std::size_t DateTimeParallelExecutor::parse(const char* dt_data, std::size_t dt_rows, std::size_t dt_stride,
+                                            DateTimeBatchParser::Layout dt_layout, std::int64_t* dt_out,
+                                            std::vector<std::size_t>* dt_malformedRows) {
+    // Malformed rows are collected per chunk and merged in chunk order
+    std::vector<std::vector<std::size_t>> dt_chunkMalformed((dt_rows + dt_chunkRows - 1) / dt_chunkRows);
+    std::atomic<std::size_t> dt_malformed{0};
+    forEachChunk(dt_rows, [&](std::size_t dt_begin, std::size_t dt_end, std::size_t dt_chunk, Scratch& dt_local) {
+        dt_local.rows.clear();
+        const std::size_t dt_bad = DateTimeBatchParser::parse(dt_data + dt_begin * dt_stride, dt_end - dt_begin, dt_stride,
+                                                              dt_layout, dt_out + dt_begin,
+                                                              dt_malformedRows != nullptr ? &dt_local.rows : nullptr);
+        if (dt_bad != 0) {
+            dt_malformed.fetch_add(dt_bad, std::memory_order_relaxed);
+            for (std::size_t dt_row : dt_local.rows) {
+                dt_chunkMalformed[dt_chunk].push_back(dt_begin + dt_row);
+            }
+        }
+    });
+    if (dt_malformedRows != nullptr) {
+        for (const std::vector<std::size_t>& dt_rowsOfChunk : dt_chunkMalformed) {
+            dt_malformedRows->insert(dt_malformedRows->end(), dt_rowsOfChunk.begin(), dt_rowsOfChunk.end());
+        }
+    }
+    return dt_malformed.load();
+}
+
+void DateTimeParallelExecutor::format(std::span<const DateTime> dt_values, const DateTime::FormatPattern& dt_pattern,
+                                      std::string& dt_arena, std::vector<std::int64_t>& dt_offsets) {
+    const std::size_t dt_rows = dt_values.size();
+    const std::size_t dt_chunks = (dt_rows + dt_chunkRows - 1) / dt_chunkRows;
+    const std::size_t dt_maxRow = DateTime::maxFormattedSize(dt_pattern);
+    dt_offsets.assign(dt_rows + 1, 0);
+
+    // Where a chunk's text was rendered: worker scratch buffer and range within it
+    struct ChunkText {
+        const Scratch* scratch;
+        std::size_t begin;
+        std::size_t size;
+    };
+    std::vector<ChunkText> dt_chunkText(dt_chunks);
+
+    // Both passes run under one batch lock, so the scratch text survives until pass 2
+    std::lock_guard<std::mutex> dt_batchLock(dt_batchMutex);
+    for (Scratch& dt_local : dt_scratch) {
+        dt_local.text.clear();
+    }
+
+    // Pass 1: each chunk renders after the earlier chunks in its worker's scratch buffer and
+    // records row ends relative to the chunk in dt_offsets
+    runChunksLocked(dt_rows, [&](std::size_t dt_begin, std::size_t dt_end, std::size_t dt_chunk, Scratch& dt_local) {
+        const std::size_t dt_start = dt_local.text.size();
+        dt_local.text.resize(dt_start + (dt_end - dt_begin) * dt_maxRow);
+        char* dt_first = dt_local.text.data() + dt_start;
+        char* dt_out = dt_first;
+        for (std::size_t dt_row = dt_begin; dt_row < dt_end; ++dt_row) {
+            dt_out = dt_values[dt_row].formatTo(dt_out, dt_out + dt_maxRow, dt_pattern).ptr;
+            dt_offsets[dt_row + 1] = dt_out - dt_first;
+        }
+        dt_local.text.resize(dt_start + static_cast<std::size_t>(dt_out - dt_first));
+        dt_chunkText[dt_chunk] = ChunkText{&dt_local, dt_start, static_cast<std::size_t>(dt_out - dt_first)};
+    });
+
+    // Chunk starts, then pass 2 copies each chunk from scratch straight into the arena and rebases the offsets
+    std::vector<std::int64_t> dt_chunkStart(dt_chunks + 1, 0);
+    for (std::size_t dt_chunk = 0; dt_chunk < dt_chunks; ++dt_chunk) {
+        dt_chunkStart[dt_chunk + 1] = dt_chunkStart[dt_chunk] + static_cast<std::int64_t>(dt_chunkText[dt_chunk].size);
+    }
+    dt_arena.resize(static_cast<std::size_t>(dt_chunkStart[dt_chunks]));
+    runChunksLocked(dt_rows, [&](std::size_t dt_begin, std::size_t dt_end, std::size_t dt_chunk, Scratch&) {
+        const ChunkText& dt_text = dt_chunkText[dt_chunk];
+        std::memcpy(dt_arena.data() + dt_chunkStart[dt_chunk], dt_text.scratch->text.data() + dt_text.begin, dt_text.size);
+        for (std::size_t dt_row = dt_begin; dt_row < dt_end; ++dt_row) {
+            dt_offsets[dt_row + 1] += dt_chunkStart[dt_chunk];
+        }
+    });
+}
+
+void DateTimeParallelExecutor::convertToRegion(std::span<const DateTime> dt_values, DateTime::RegionHandle dt_target,
+                                               DateTime* dt_out) {
+    forEachChunk(dt_values.size(), [&](std::size_t dt_begin, std::size_t dt_end, std::size_t, Scratch&) {
+        for (std::size_t dt_row = dt_begin; dt_row < dt_end; ++dt_row) {
+            dt_out[dt_row] = dt_values[dt_row].convertToRegion(dt_target);
+        }
+    });
+}
+
+void DateTimeParallelExecutor::extractFields(const std::int64_t* dt_epochMilliseconds, std::size_t dt_rows,
+                                             std::chrono::seconds dt_utcOffset, const DateTimeColumn::FieldArrays& dt_out) {
+    forEachChunk(dt_rows, [&](std::size_t dt_begin, std::size_t dt_end, std::size_t, Scratch&) {
+        auto dt_shift = [dt_begin](std::int32_t* dt_array) { return dt_array != nullptr ? dt_array + dt_begin : nullptr; };
+        const DateTimeColumn::FieldArrays dt_chunkOut{dt_shift(dt_out.year), dt_shift(dt_out.month), dt_shift(dt_out.day),
+                                                      dt_shift(dt_out.hour), dt_shift(dt_out.minute), dt_shift(dt_out.second),
+                                                      dt_shift(dt_out.millisecond), dt_shift(dt_out.dayOfWeek)};
+        DateTimeColumn::extractFields(dt_epochMilliseconds + dt_begin, dt_end - dt_begin, dt_utcOffset, dt_chunkOut);
+    });
+}
@@ -0,0 +1,249 @@
+#include "datetime_posix_rule.hpp"
+#include <algorithm>
+
+namespace {
+
+constexpr std::int64_t dt_secondsPerDay = 86400;
+
+// Transition instants are cached relative to January 1 (UTC) of their year. With day 0-365,
+// times of -167h..167h and offsets of up to 25h they fall in [-192h, 366d + 192h), which fits
+// 25 bits after this bias.
+constexpr std::int64_t dt_relativeBias = 192 * 3600;
+constexpr int dt_relativeBits = 25;
+constexpr std::uint64_t dt_relativeMask = (std::uint64_t{1} << dt_relativeBits) - 1;
+constexpr std::uint64_t dt_validBit = std::uint64_t{1} << 63;
+constexpr int dt_tagShift = 2 * dt_relativeBits;
+constexpr std::uint64_t dt_tagMask = 0x1FFF;  // 13 bits: with 16 slots, years are identified modulo 2^17
+constexpr std::int64_t dt_cachedYearLimit = 65536;
+
+// Keeps the calendar arithmetic within int years (about +-10^9 years around the epoch)
+constexpr std::int64_t dt_instantLimit = std::int64_t{30000000} * 365 * dt_secondsPerDay;
+
+std::int64_t dt_yearOf(std::int64_t dt_localSeconds) {
+    const std::int64_t dt_clamped = std::clamp(dt_localSeconds, -dt_instantLimit, dt_instantLimit);
+    return DateTime::civilFromDays(DateTime::floorDiv(dt_clamped, dt_secondsPerDay)).year;
+}
+
+// Recursive-descent reader over the rule string
+class DT_RuleReader {
+public:
+    explicit DT_RuleReader(std::string_view dt_text) : dt_text(dt_text) {}
+
+    bool atEnd() const { return dt_position >= dt_text.size(); }
+    char peek() const { return atEnd() ? '\0' : dt_text[dt_position]; }
+
+    bool accept(char dt_char) {
+        if (peek() == dt_char) {
+            ++dt_position;
+            return true;
+        }
+        return false;
+    }
+
+    [[noreturn]] void fail(const char* dt_reason) const {
+        throw DateTimeException("Invalid POSIX TZ rule \"" + std::string(dt_text) + "\": " + dt_reason);
+    }
+
+    // Abbreviation: three or more letters, or <...> with letters, digits, '+' and '-'
+    std::string readName() {
+        const std::size_t dt_start = dt_position;
+        if (accept('<')) {
+            while (!atEnd() && peek() != '>') {
+                const char dt_char = peek();
+                if (!std::isalnum(static_cast<unsigned char>(dt_char)) && dt_char != '+' && dt_char != '-') {
+                    fail("invalid character in quoted name");
+                }
+                ++dt_position;
+            }
+            if (!accept('>') || dt_position - dt_start < 5) {
+                fail("quoted name needs at least three characters and a closing '>'");
+            }
+            return std::string(dt_text.substr(dt_start + 1, dt_position - dt_start - 2));
+        }
+        while (std::isalpha(static_cast<unsigned char>(peek()))) {
+            ++dt_position;
+        }
+        if (dt_position - dt_start < 3) {
+            fail("name needs at least three letters");
+        }
+        return std::string(dt_text.substr(dt_start, dt_position - dt_start));
+    }
+
+    bool atNumber() const {
+        const char dt_char = peek();
+        return dt_char == '+' || dt_char == '-' || std::isdigit(static_cast<unsigned char>(dt_char));
+    }
+
+    int readInteger(int dt_max) {
+        if (!std::isdigit(static_cast<unsigned char>(peek()))) {
+            fail("expected a number");
+        }
+        int dt_value = 0;
+        while (std::isdigit(static_cast<unsigned char>(peek()))) {
+            dt_value = dt_value * 10 + (dt_text[dt_position++] - '0');
+            if (dt_value > dt_max) {
+                fail("number out of range");
+            }
+        }
+        return dt_value;
+    }
+
+    // [+-]hh[:mm[:ss]] in seconds, hours up to dt_maxHours
+    std::int32_t readDuration(int dt_maxHours) {
+        const bool dt_negative = accept('-');
+        if (!dt_negative) {
+            accept('+');
+        }
+        std::int32_t dt_seconds = readInteger(dt_maxHours) * 3600;
+        if (accept(':')) {
+            dt_seconds += readInteger(59) * 60;
+            if (accept(':')) {
+                dt_seconds += readInteger(59);
+            }
+        }
+        return dt_negative ? -dt_seconds : dt_seconds;
+    }
+
+private:
+    std::string_view dt_text;
+    std::size_t dt_position = 0;
+};
+
+} // namespace
+
+DateTimePosixRule::DateTimePosixRule(std::string_view dt_rule) : dt_text(dt_rule) {
+    DT_RuleReader dt_reader(dt_rule);
+    dt_standardName = dt_reader.readName();
+    if (!dt_reader.atNumber()) {
+        dt_reader.fail("missing standard offset");
+    }
+    // POSIX offsets are hours west of UTC
+    dt_standardOffset = -dt_reader.readDuration(24);
+    dt_dstOffset = dt_standardOffset;
+
+    if (!dt_reader.atEnd()) {
+        dt_dstName = dt_reader.readName();
+        dt_dstOffset = dt_reader.atNumber() ? -dt_reader.readDuration(24) : dt_standardOffset + 3600;
+
+        // Without dates, the US rules (as glibc assumes)
+        dt_start = DateRule{DateRule::Kind::MonthWeekDay, 0, 2, 3, 7200};
+        dt_end = DateRule{DateRule::Kind::MonthWeekDay, 0, 1, 11, 7200};
+        for (DateRule* dt_date : {&dt_start, &dt_end}) {
+            if (dt_reader.atEnd() && dt_date == &dt_start) {
+                break;
+            }
+            if (!dt_reader.accept(',')) {
+                dt_reader.fail("expected ',' before a transition date");
+            }
+            if (dt_reader.accept('M')) {
+                dt_date->kind = DateRule::Kind::MonthWeekDay;
+                dt_date->month = dt_reader.readInteger(12);
+                if (dt_date->month < 1 || !dt_reader.accept('.')) {
+                    dt_reader.fail("invalid Mm.w.d month");
+                }
+                dt_date->week = dt_reader.readInteger(5);
+                if (dt_date->week < 1 || !dt_reader.accept('.')) {
+                    dt_reader.fail("invalid Mm.w.d week");
+                }
+                dt_date->day = dt_reader.readInteger(6);
+            } else if (dt_reader.accept('J')) {
+                dt_date->kind = DateRule::Kind::JulianNoLeap;
+                dt_date->day = dt_reader.readInteger(365);
+                if (dt_date->day < 1) {
+                    dt_reader.fail("Jn day must be 1-365");
+                }
+            } else {
+                dt_date->kind = DateRule::Kind::JulianZero;
+                dt_date->day = dt_reader.readInteger(365);
+            }
+            dt_date->time = dt_reader.accept('/') ? dt_reader.readDuration(167) : 7200;
+        }
+    }
+    if (!dt_reader.atEnd()) {
+        dt_reader.fail("unexpected trailing characters");
+    }
+}
+
+std::int64_t DateTimePosixRule::dayOfYear(const DateRule& dt_date, std::int64_t dt_year) {
+    switch (dt_date.kind) {
+        case DateRule::Kind::JulianNoLeap:
+            return dt_date.day - 1 + (DateTime::isLeapYear(dt_year) && dt_date.day >= 60 ? 1 : 0);
+        case DateRule::Kind::JulianZero:
+            return dt_date.day;
+        case DateRule::Kind::MonthWeekDay:
+            break;
+    }
+    // First dt_date.day weekday of the month, then whole weeks on; week 5 means the last one
+    const std::int64_t dt_monthStart = DateTime::daysFromCivil(dt_year, dt_date.month, 1);
+    const std::int64_t dt_firstWeekday = (dt_monthStart + 4) - DateTime::floorDiv(dt_monthStart + 4, 7) * 7;  // 1970-01-01 was a Thursday
+    std::int64_t dt_day = dt_monthStart + (dt_date.day - dt_firstWeekday + 7) % 7 + (dt_date.week - 1) * 7;
+    const std::int64_t dt_monthEnd = dt_monthStart + DateTime::daysInMonth(dt_year, dt_date.month);
+    while (dt_day >= dt_monthEnd) {
+        dt_day -= 7;
+    }
+    return dt_day - DateTime::daysFromCivil(dt_year, 1, 1);
+}
+
+DateTimePosixRule::YearTransitions DateTimePosixRule::computeTransitions(std::int64_t dt_year) const {
+    const std::int64_t dt_yearStart = DateTime::daysFromCivil(dt_year, 1, 1) * dt_secondsPerDay;
+    // The start happens on standard time, the end on daylight time
+    return YearTransitions{dt_yearStart + dayOfYear(dt_start, dt_year) * dt_secondsPerDay + dt_start.time - dt_standardOffset,
+                           dt_yearStart + dayOfYear(dt_end, dt_year) * dt_secondsPerDay + dt_end.time - dt_dstOffset};
+}
+
+DateTimePosixRule::YearTransitions DateTimePosixRule::transitionsFor(std::int64_t dt_year) const {
+    if (dt_year < -dt_cachedYearLimit || dt_year >= dt_cachedYearLimit) {
+        return computeTransitions(dt_year);
+    }
+    const std::uint64_t dt_tag = (static_cast<std::uint64_t>(dt_year) >> 4) & dt_tagMask;
+    std::atomic<std::uint64_t>& dt_slot = dt_cache[static_cast<std::uint64_t>(dt_year) & (dt_cacheSlots - 1)];
+    const std::int64_t dt_yearStart = DateTime::daysFromCivil(dt_year, 1, 1) * dt_secondsPerDay;
+
+    // A slot is one self-contained word, so a relaxed load sees either a complete entry or a miss
+    const std::uint64_t dt_entry = dt_slot.load(std::memory_order_relaxed);
+    if ((dt_entry & dt_validBit) != 0 && ((dt_entry >> dt_tagShift) & dt_tagMask) == dt_tag) {
+        return YearTransitions{
+            dt_yearStart + static_cast<std::int64_t>((dt_entry >> dt_relativeBits) & dt_relativeMask) - dt_relativeBias,
+            dt_yearStart + static_cast<std::int64_t>(dt_entry & dt_relativeMask) - dt_relativeBias};
+    }
+
+    const YearTransitions dt_transitions = computeTransitions(dt_year);
+    const std::int64_t dt_start = dt_transitions.dstStart - dt_yearStart + dt_relativeBias;
+    const std::int64_t dt_end = dt_transitions.dstEnd - dt_yearStart + dt_relativeBias;
+    if (dt_start >= 0 && static_cast<std::uint64_t>(dt_start) <= dt_relativeMask && dt_end >= 0 &&
+        static_cast<std::uint64_t>(dt_end) <= dt_relativeMask) {
+        // Racing writers store equal words for the same year; a different year just evicts
+        dt_slot.store(dt_validBit | (dt_tag << dt_tagShift) | (static_cast<std::uint64_t>(dt_start) << dt_relativeBits) |
+                          static_cast<std::uint64_t>(dt_end),
+                      std::memory_order_relaxed);
+    }
+    return dt_transitions;
+}
+
+bool DateTimePosixRule::isDstAt(std::int64_t dt_utcSeconds) const {
+    if (!hasDst()) {
+        return false;
+    }
+    const YearTransitions dt_transitions = transitionsFor(dt_yearOf(dt_utcSeconds + dt_standardOffset));
+    if (dt_transitions.dstStart <= dt_transitions.dstEnd) {
+        return dt_utcSeconds >= dt_transitions.dstStart && dt_utcSeconds < dt_transitions.dstEnd;
+    }
+    // Southern hemisphere: DST spans the turn of the year
+    return dt_utcSeconds < dt_transitions.dstEnd || dt_utcSeconds >= dt_transitions.dstStart;
+}
+
+std::int32_t DateTimePosixRule::offsetAt(std::int64_t dt_utcSeconds) const {
+    return isDstAt(dt_utcSeconds) ? dt_dstOffset : dt_standardOffset;
+}
+
+std::int32_t DateTimePosixRule::offsetForLocal(std::int64_t dt_localSeconds) const {
+    const std::int32_t dt_before = offsetAt(dt_localSeconds - dt_secondsPerDay);
+    if (offsetAt(dt_localSeconds - dt_before) == dt_before) {
+        return dt_before;
+    }
+    const std::int32_t dt_after = offsetAt(dt_localSeconds + dt_secondsPerDay);
+    if (offsetAt(dt_localSeconds - dt_after) == dt_after) {
+        return dt_after;
+    }
+    return dt_before;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+// Internal to the library: x86 SIMD dispatch shared by the batch parser and the column kernels
+
+#include "datetime_batch.hpp"
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define DATETIME_HAS_X86_SIMD 1
+#define DATETIME_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+// Resolve Auto and clamp the request to what the CPU supports
+inline DateTimeBatchParser::Isa dt_resolveIsa(DateTimeBatchParser::Isa dt_requested) {
+    using Isa = DateTimeBatchParser::Isa;
+    const Isa dt_supported = DateTimeBatchParser::supportedIsa();
+    if (dt_requested == Isa::Auto || static_cast<int>(dt_requested) > static_cast<int>(dt_supported)) {
+        return dt_supported;
+    }
+    return dt_requested;
+}
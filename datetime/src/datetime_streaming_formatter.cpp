@@ -0,0 +1,117 @@
+#include "datetime_streaming_formatter.hpp"
+#include <cstring>
+
+namespace {
+
+constexpr std::int64_t dt_secondsPerDay = 86400;
+constexpr std::int64_t dt_nanosecondsPerSecond = 1000000000;
+
+} // namespace
+
+DateTimeStreamingFormatter::DateTimeStreamingFormatter(std::string_view dt_pattern) : dt_pattern(dt_pattern) {
+    using Op = DateTime::FormatOpCode;
+    dt_slots.reserve(this->dt_pattern.operations().size());
+    for (const DateTime::FormatOp& dt_op : this->dt_pattern.operations()) {
+        Level dt_level = Level::Day;
+        switch (dt_op.code) {
+            case Op::Literal:
+            case Op::Char:
+            case Op::RegionName:
+            case Op::RegionOffset:
+                dt_level = Level::Constant;
+                break;
+            case Op::Hour:
+            case Op::Hour12:
+            case Op::AmPm:
+                dt_level = Level::Hour;
+                break;
+            case Op::Minute:
+                dt_level = Level::Minute;
+                break;
+            case Op::Second:
+                dt_level = Level::Second;
+                break;
+            case Op::Fraction:
+                dt_level = Level::Fraction;
+                break;
+            case Op::Strftime:
+                // strftime has no sub-second conversions
+                dt_level = Level::Second;
+                dt_hasStrftime = true;
+                break;
+            default:
+                break;
+        }
+        dt_slots.push_back(Slot{0, dt_level});
+    }
+}
+
+void DateTimeStreamingFormatter::renderAll(const DateTime& dt_value) {
+    dt_fields = dt_value.fields();
+    dt_text.clear();
+    char dt_buffer[DateTime::MaxOperationSize];
+    const std::vector<DateTime::FormatOp>& dt_ops = dt_pattern.operations();
+    for (std::size_t dt_index = 0; dt_index < dt_ops.size(); ++dt_index) {
+        dt_slots[dt_index].position = static_cast<std::uint32_t>(dt_text.size());
+        const std::string_view dt_piece = dt_value.formatOperation(dt_ops[dt_index], dt_pattern.pattern(), dt_fields, dt_buffer);
+        dt_text.append(dt_piece.data(), dt_piece.size());
+    }
+}
+
+std::string_view DateTimeStreamingFormatter::format(const DateTime& dt_value) {
+    const std::int64_t dt_sinceEpoch =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(dt_value.getSystemTime().time_since_epoch()).count();
+    const std::int64_t dt_utcSeconds = DateTime::floorDiv(dt_sinceEpoch, dt_nanosecondsPerSecond);
+    const std::int64_t dt_nanos = dt_sinceEpoch - dt_utcSeconds * dt_nanosecondsPerSecond;
+    const std::int64_t dt_offset = dt_value.getUtcOffset().count();
+    const std::int64_t dt_local = dt_utcSeconds + dt_offset;
+    
+    const bool dt_sameDay = dt_valid && dt_value.getRegionHandle() == dt_region && dt_offset == dt_offsetSeconds &&
+                            DateTime::floorDiv(dt_local, dt_secondsPerDay) == DateTime::floorDiv(dt_localSeconds, dt_secondsPerDay);
+    if (dt_sameDay && dt_local == dt_localSeconds && dt_nanos == dt_nanosecond) {
+        return dt_text;
+    }
+    
+    // Finest unit that did not change decides which fields are patched
+    Level dt_changed = Level::Day;
+    if (dt_sameDay) {
+        const std::int64_t dt_newOfDay = dt_local - DateTime::floorDiv(dt_local, dt_secondsPerDay) * dt_secondsPerDay;
+        const std::int64_t dt_oldOfDay = dt_localSeconds - DateTime::floorDiv(dt_localSeconds, dt_secondsPerDay) * dt_secondsPerDay;
+        if (dt_newOfDay / 3600 != dt_oldOfDay / 3600) {
+            dt_changed = Level::Hour;
+        } else if (dt_newOfDay / 60 != dt_oldOfDay / 60) {
+            dt_changed = Level::Minute;
+        } else if (dt_newOfDay != dt_oldOfDay) {
+            dt_changed = Level::Second;
+        } else {
+            dt_changed = Level::Fraction;
+        }
+        dt_fields.hour = static_cast<int>(dt_newOfDay / 3600);
+        dt_fields.minute = static_cast<int>(dt_newOfDay / 60 % 60);
+        dt_fields.second = static_cast<int>(dt_newOfDay % 60);
+        dt_fields.nanosecond = static_cast<int>(dt_nanos);
+        dt_fields.millisecond = static_cast<int>(dt_nanos / 1000000);
+    }
+    
+    dt_valid = true;
+    dt_region = dt_value.getRegionHandle();
+    dt_offsetSeconds = dt_offset;
+    dt_localSeconds = dt_local;
+    dt_nanosecond = dt_nanos;
+    
+    if (dt_changed == Level::Day || (dt_hasStrftime && dt_changed <= Level::Second)) {
+        renderAll(dt_value);
+        return dt_text;
+    }
+    
+    // Patch fixed-width fields in place
+    char dt_buffer[DateTime::MaxOperationSize];
+    const std::vector<DateTime::FormatOp>& dt_ops = dt_pattern.operations();
+    for (std::size_t dt_index = 0; dt_index < dt_ops.size(); ++dt_index) {
+        if (dt_slots[dt_index].level >= dt_changed) {
+            const std::string_view dt_piece = dt_value.formatOperation(dt_ops[dt_index], dt_pattern.pattern(), dt_fields, dt_buffer);
+            std::memcpy(&dt_text[dt_slots[dt_index].position], dt_piece.data(), dt_piece.size());
+        }
+    }
+    return dt_text;
+}
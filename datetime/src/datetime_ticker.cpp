@@ -0,0 +1,190 @@
+#include "datetime_ticker.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+std::int64_t dt_toNanoseconds(const DateTime& dt_time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(dt_time.getSystemTime().time_since_epoch()).count();
+}
+
+DateTime dt_fromNanoseconds(std::int64_t dt_nanoseconds) {
+    return DateTime(std::chrono::system_clock::time_point(
+                        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(dt_nanoseconds))),
+                    DateTime::RegionHandle::World);
+}
+
+} // namespace
+
+DateTimeTicker::Format::Format(const std::string& dt_pattern, DateTime::RegionHandle dt_region)
+    : pattern(dt_pattern),
+      region(dt_region),
+      capacity(DateTime::maxFormattedSize(pattern)),
+      words((capacity + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t)),
+      text(std::make_unique<std::atomic<std::uint64_t>[]>(words * dt_ringSize)) {}
+
+DateTimeTicker::DateTimeTicker(std::chrono::milliseconds dt_interval, DateTime::ClockSource dt_source)
+    : dt_interval(dt_interval), dt_source(dt_source) {}
+
+DateTimeTicker::~DateTimeTicker() {
+    stop();
+}
+
+DateTimeTicker::FormatId DateTimeTicker::addFormat(const std::string& dt_pattern, const DateTime::RegionTime& dt_region) {
+    std::lock_guard<std::mutex> dt_lock(dt_mutex);
+    if (dt_renderedCount >= dt_maxFormats) {
+        throw DateTimeException("Too many ticker formats, cannot add: " + dt_pattern);
+    }
+    auto dt_format = std::make_unique<Format>(dt_pattern, DateTime::internRegion(dt_region));
+    dt_buffer.resize(std::max(dt_buffer.size(), dt_format->words * sizeof(std::uint64_t)));
+
+    const FormatId dt_id = dt_renderedCount;
+    dt_formats[dt_id] = std::move(dt_format);
+    ++dt_renderedCount;
+
+    // Publish right away so the new format is readable without waiting for a tick, and only
+    // then make it visible to readers
+    publishLocked();
+    dt_formatCount.store(dt_renderedCount, std::memory_order_release);
+    return dt_id;
+}
+
+void DateTimeTicker::start() {
+    std::lock_guard<std::mutex> dt_lock(dt_mutex);
+    if (dt_running) {
+        return;
+    }
+    publishLocked();
+    dt_running = true;
+    dt_thread = std::thread(&DateTimeTicker::run, this);
+}
+
+void DateTimeTicker::stop() {
+    {
+        std::lock_guard<std::mutex> dt_lock(dt_mutex);
+        if (!dt_running) {
+            return;
+        }
+        dt_running = false;
+    }
+    dt_wakeup.notify_all();
+    if (dt_thread.joinable()) {
+        dt_thread.join();
+    }
+}
+
+bool DateTimeTicker::isRunning() const {
+    std::lock_guard<std::mutex> dt_lock(dt_mutex);
+    return dt_running;
+}
+
+DateTimeTicker::Tick DateTimeTicker::tick() const noexcept {
+    for (;;) {
+        const std::uint64_t dt_published = dt_latest.load(std::memory_order_acquire);
+        if (dt_published == 0) {
+            return Tick{DateTime(std::chrono::system_clock::time_point{}, DateTime::RegionHandle::World), 0};
+        }
+        const Slot& dt_slot = dt_slots[dt_published % dt_ringSize];
+        if (dt_slot.sequence.load(std::memory_order_acquire) != dt_published) {
+            continue;
+        }
+        const std::int64_t dt_nanoseconds = dt_slot.nanoseconds.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (dt_slot.sequence.load(std::memory_order_relaxed) == dt_published) {
+            return Tick{dt_fromNanoseconds(dt_nanoseconds), dt_published};
+        }
+    }
+}
+
+DateTime DateTimeTicker::now() const {
+    const Tick dt_tick = tick();
+    return dt_tick.sequence != 0 ? dt_tick.time : DateTime::now(dt_source);
+}
+
+std::to_chars_result DateTimeTicker::text(FormatId dt_format, char* dt_first, char* dt_last, Tick* dt_tick) const noexcept {
+    if (dt_format >= dt_formatCount.load(std::memory_order_acquire)) {
+        return {dt_first, std::errc::invalid_argument};
+    }
+    const Format& dt_state = *dt_formats[dt_format];
+    const std::size_t dt_room = static_cast<std::size_t>(dt_last - dt_first);
+
+    // Seqlock read: copy the slot, then check that it still holds the same publication
+    for (;;) {
+        const std::uint64_t dt_published = dt_latest.load(std::memory_order_acquire);
+        const std::size_t dt_index = dt_published % dt_ringSize;
+        const Slot& dt_slot = dt_slots[dt_index];
+        if (dt_slot.sequence.load(std::memory_order_acquire) != dt_published) {
+            continue;
+        }
+        const std::int64_t dt_nanoseconds = dt_slot.nanoseconds.load(std::memory_order_relaxed);
+        const std::size_t dt_length = dt_state.length[dt_index].load(std::memory_order_relaxed);
+        const bool dt_fits = dt_length <= dt_room;
+        if (dt_fits) {
+            const std::atomic<std::uint64_t>* dt_words = &dt_state.text[dt_index * dt_state.words];
+            for (std::size_t dt_offset = 0; dt_offset < dt_length; dt_offset += sizeof(std::uint64_t)) {
+                const std::uint64_t dt_word = dt_words[dt_offset / sizeof(std::uint64_t)].load(std::memory_order_relaxed);
+                std::memcpy(dt_first + dt_offset, &dt_word, std::min(sizeof(std::uint64_t), dt_length - dt_offset));
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (dt_slot.sequence.load(std::memory_order_relaxed) != dt_published) {
+            continue;
+        }
+        if (dt_tick != nullptr) {
+            *dt_tick = Tick{dt_fromNanoseconds(dt_nanoseconds), dt_published};
+        }
+        if (!dt_fits) {
+            return {dt_last, std::errc::value_too_large};
+        }
+        return {dt_first + dt_length, std::errc{}};
+    }
+}
+
+std::size_t DateTimeTicker::maxTextSize(FormatId dt_format) const noexcept {
+    return dt_format < dt_formatCount.load(std::memory_order_acquire) ? dt_formats[dt_format]->capacity : 0;
+}
+
+DateTimeTicker& DateTimeTicker::global() {
+    static DateTimeTicker dt_ticker;
+    return dt_ticker;
+}
+
+void DateTimeTicker::publishLocked() {
+    const std::uint64_t dt_published = ++dt_sequence;
+    const std::size_t dt_index = dt_published % dt_ringSize;
+    Slot& dt_slot = dt_slots[dt_index];
+
+    // Mark the slot as being rewritten before touching its data
+    dt_slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const DateTime dt_time = DateTime::now(dt_source);
+    dt_slot.nanoseconds.store(dt_toNanoseconds(dt_time), std::memory_order_relaxed);
+    for (std::size_t dt_id = 0; dt_id < dt_renderedCount; ++dt_id) {
+        Format& dt_format = *dt_formats[dt_id];
+        const DateTime dt_local = dt_time.convertToRegion(dt_format.region);
+        const std::to_chars_result dt_result = dt_local.formatTo(dt_buffer.data(), dt_buffer.data() + dt_format.capacity, dt_format.pattern);
+        const std::size_t dt_length = dt_result.ec == std::errc{} ? static_cast<std::size_t>(dt_result.ptr - dt_buffer.data()) : 0;
+        std::atomic<std::uint64_t>* dt_words = &dt_format.text[dt_index * dt_format.words];
+        for (std::size_t dt_offset = 0; dt_offset < dt_length; dt_offset += sizeof(std::uint64_t)) {
+            std::uint64_t dt_word = 0;
+            std::memcpy(&dt_word, dt_buffer.data() + dt_offset, std::min(sizeof(std::uint64_t), dt_length - dt_offset));
+            dt_words[dt_offset / sizeof(std::uint64_t)].store(dt_word, std::memory_order_relaxed);
+        }
+        dt_format.length[dt_index].store(dt_length, std::memory_order_relaxed);
+    }
+
+    dt_slot.sequence.store(dt_published, std::memory_order_release);
+    dt_latest.store(dt_published, std::memory_order_release);
+}
+
+void DateTimeTicker::run() {
+    std::unique_lock<std::mutex> dt_lock(dt_mutex);
+    while (dt_running) {
+        dt_wakeup.wait_for(dt_lock, dt_interval, [this]() { return !dt_running; });
+        if (!dt_running) {
+            break;
+        }
+        publishLocked();
+    }
+}
@@ -0,0 +1,613 @@
+#include "datetime_zone.hpp"
+#include "datetime_posix_rule.hpp"
+#include "datetime_zone_registry.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DATETIME_HAS_MMAP 1
+#endif
+
+namespace {
+
+constexpr std::size_t dt_headerSize = 44;
+constexpr std::size_t dt_typeSize = 6;
+
+std::uint32_t dt_readBigEndian32(const unsigned char* dt_bytes) {
+    return (std::uint32_t{dt_bytes[0]} << 24) | (std::uint32_t{dt_bytes[1]} << 16) |
+           (std::uint32_t{dt_bytes[2]} << 8) | std::uint32_t{dt_bytes[3]};
+}
+
+std::uint64_t dt_readBigEndian64(const unsigned char* dt_bytes) {
+    return (std::uint64_t{dt_readBigEndian32(dt_bytes)} << 32) | dt_readBigEndian32(dt_bytes + 4);
+}
+
+[[noreturn]] void dt_throwMalformed(const std::string& dt_name, const char* dt_reason) {
+    throw DateTimeException("Malformed TZif data for " + dt_name + ": " + dt_reason);
+}
+
+// Directory zones are read from
+struct DT_ZoneDirectory {
+    std::mutex mutex;
+    std::string directory;
+    bool directorySet = false;
+
+    static DT_ZoneDirectory& instance() {
+        static DT_ZoneDirectory dt_directory;
+        return dt_directory;
+    }
+
+    std::string resolvedDirectory() const {
+        if (directorySet) {
+            return directory;
+        }
+        const char* dt_environment = std::getenv("TZDIR");
+        return dt_environment != nullptr && *dt_environment != '\0' ? dt_environment : "/usr/share/zoneinfo";
+    }
+};
+
+// Index window in years, packed as (first << 32 | last) so both change together
+std::atomic<std::uint64_t> dt_indexYears{(std::uint64_t{1970} << 32) | 2100};
+
+// Zone compiled into the library (DATETIME_EMBED_ZONES)
+struct DT_EmbeddedZone {
+    std::string_view name;
+    std::span<const unsigned char> data;
+};
+
+#if defined(DATETIME_HAS_EMBEDDED_ZONES)
+#include "datetime_embedded_zones.inc"
+#else
+constexpr std::array<DT_EmbeddedZone, 0> dt_embeddedZones{};
+#endif
+
+constexpr std::uint32_t dt_nameHash(std::string_view dt_name, std::uint32_t dt_seed) {
+    // FNV-1a with a seeded basis and a final avalanche so that seeds give independent hashes
+    std::uint32_t dt_hash = 2166136261u ^ (dt_seed * 0x9E3779B9u);
+    for (char dt_char : dt_name) {
+        dt_hash = (dt_hash ^ static_cast<unsigned char>(dt_char)) * 16777619u;
+    }
+    dt_hash ^= dt_hash >> 16;
+    dt_hash *= 0x7FEB352Du;
+    return dt_hash ^ (dt_hash >> 15);
+}
+
+// Perfect hash over the embedded names, built at compile time (hash and displace):
+// names are grouped into buckets by a first hash, and each bucket gets a seed under which all of
+// its names land in free slots. A lookup is two hashes and one name comparison.
+template <std::size_t Count>
+struct DT_PerfectHash {
+    static constexpr std::size_t dt_buckets = Count / 4 + 1;
+    static constexpr std::size_t dt_slots = std::bit_ceil(Count * 2 + 1);
+
+    std::array<std::uint32_t, dt_buckets> seeds{};
+    std::array<std::uint16_t, dt_slots> slots{};  // Zone index + 1, 0 marks an empty slot
+
+    constexpr explicit DT_PerfectHash(const std::array<DT_EmbeddedZone, Count>& dt_zones) {
+        // Largest buckets first, while the table is emptiest
+        std::array<std::size_t, dt_buckets> dt_order{};
+        std::array<std::size_t, dt_buckets> dt_sizes{};
+        for (std::size_t dt_bucket = 0; dt_bucket < dt_buckets; ++dt_bucket) {
+            dt_order[dt_bucket] = dt_bucket;
+        }
+        for (const DT_EmbeddedZone& dt_zone : dt_zones) {
+            ++dt_sizes[dt_nameHash(dt_zone.name, 0) % dt_buckets];
+        }
+        std::sort(dt_order.begin(), dt_order.end(),
+                  [&dt_sizes](std::size_t dt_left, std::size_t dt_right) { return dt_sizes[dt_left] > dt_sizes[dt_right]; });
+
+        for (std::size_t dt_bucket : dt_order) {
+            for (std::uint32_t dt_seed = 1;; ++dt_seed) {
+                if (dt_seed > 1000000) {
+                    throw DateTimeException("Duplicate embedded time zone name");  // Compile error in constant evaluation
+                }
+                std::array<std::uint16_t, dt_slots> dt_trial = slots;
+                bool dt_placed = true;
+                for (std::size_t dt_index = 0; dt_index < Count && dt_placed; ++dt_index) {
+                    if (dt_nameHash(dt_zones[dt_index].name, 0) % dt_buckets != dt_bucket) {
+                        continue;
+                    }
+                    std::uint16_t& dt_slot = dt_trial[dt_nameHash(dt_zones[dt_index].name, dt_seed) & (dt_slots - 1)];
+                    dt_placed = dt_slot == 0;
+                    dt_slot = static_cast<std::uint16_t>(dt_index + 1);
+                }
+                if (dt_placed) {
+                    seeds[dt_bucket] = dt_seed;
+                    slots = dt_trial;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Index into the zone table, or -1
+    constexpr std::ptrdiff_t find(const std::array<DT_EmbeddedZone, Count>& dt_zones, std::string_view dt_name) const {
+        if constexpr (Count == 0) {
+            return -1;
+        } else {
+            const std::uint32_t dt_seed = seeds[dt_nameHash(dt_name, 0) % dt_buckets];
+            const std::uint16_t dt_slot = slots[dt_nameHash(dt_name, dt_seed) & (dt_slots - 1)];
+            return dt_slot != 0 && dt_zones[dt_slot - 1].name == dt_name ? dt_slot - 1 : -1;
+        }
+    }
+};
+
+constexpr DT_PerfectHash<dt_embeddedZones.size()> dt_embeddedIndex(dt_embeddedZones);
+
+// Zone names are relative paths below the zoneinfo directory
+bool dt_isValidZoneName(std::string_view dt_name) {
+    return !dt_name.empty() && dt_name.front() != '/' && dt_name.find("..") == std::string_view::npos &&
+           dt_name.find('\0') == std::string_view::npos;
+}
+
+} // namespace
+
+DateTimeZone::DateTimeZone(std::string_view dt_name, const unsigned char* dt_data, std::size_t dt_size)
+    : dt_name(dt_name), dt_data(dt_data), dt_size(dt_size) {}
+
+DateTimeZone::~DateTimeZone() {
+#if defined(DATETIME_HAS_MMAP)
+    if (dt_mapping != nullptr) {
+        munmap(dt_mapping, dt_size);
+    }
+#endif
+}
+
+std::shared_ptr<const DateTimeZone> DateTimeZone::load(std::string_view dt_name) {
+    return DateTimeZoneRegistry::instance().get(dt_name);
+}
+
+std::shared_ptr<const DateTimeZone> DateTimeZone::read(std::string_view dt_name) {
+    try {
+        return readTzif(dt_name);
+    } catch (const DateTimeException& dt_fileError) {
+        if (!dt_isValidZoneName(dt_name)) {
+            throw;
+        }
+        // Not a zone file: accept a POSIX TZ string, otherwise report the file error
+        try {
+            return fromPosixRule(dt_name);
+        } catch (const DateTimeException&) {
+            throw dt_fileError;
+        }
+    }
+}
+
+std::shared_ptr<const DateTimeZone> DateTimeZone::readTzif(std::string_view dt_name) {
+    if (!dt_isValidZoneName(dt_name)) {
+        throw DateTimeException("Invalid time zone name: " + std::string(dt_name));
+    }
+    // Embedded zones need no I/O
+    const std::ptrdiff_t dt_embedded = dt_embeddedIndex.find(dt_embeddedZones, dt_name);
+    if (dt_embedded >= 0) {
+        return fromMemory(dt_name, dt_embeddedZones[dt_embedded].data);
+    }
+    return fromFile(zoneInfoDirectory() + "/" + std::string(dt_name), dt_name);
+}
+
+bool DateTimeZone::sameData(const DateTimeZone& dt_other) const {
+    return this == &dt_other || (dt_name == dt_other.dt_name && dt_size == dt_other.dt_size &&
+                                 std::memcmp(dt_data, dt_other.dt_data, dt_size) == 0);
+}
+
+bool DateTimeZone::isEmbedded(std::string_view dt_name) {
+    return dt_embeddedIndex.find(dt_embeddedZones, dt_name) >= 0;
+}
+
+std::vector<std::string_view> DateTimeZone::embeddedZoneNames() {
+    std::vector<std::string_view> dt_names;
+    dt_names.reserve(dt_embeddedZones.size());
+    for (const DT_EmbeddedZone& dt_zone : dt_embeddedZones) {
+        dt_names.push_back(dt_zone.name);
+    }
+    return dt_names;
+}
+
+std::shared_ptr<const DateTimeZone> DateTimeZone::fromFile(const std::string& dt_path, std::string_view dt_name) {
+#if defined(DATETIME_HAS_MMAP)
+    const int dt_file = open(dt_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (dt_file < 0) {
+        throw DateTimeException("Cannot open time zone file: " + dt_path);
+    }
+    struct stat dt_status{};
+    if (fstat(dt_file, &dt_status) != 0 || !S_ISREG(dt_status.st_mode) || dt_status.st_size <= 0) {
+        close(dt_file);
+        throw DateTimeException("Not a time zone file: " + dt_path);
+    }
+    const std::size_t dt_length = static_cast<std::size_t>(dt_status.st_size);
+    void* dt_mapped = mmap(nullptr, dt_length, PROT_READ, MAP_PRIVATE, dt_file, 0);
+    close(dt_file);
+    if (dt_mapped == MAP_FAILED) {
+        throw DateTimeException("Cannot map time zone file: " + dt_path);
+    }
+    // The zone owns the mapping from here on, also if parsing throws
+    std::shared_ptr<DateTimeZone> dt_zone(new DateTimeZone(dt_name, static_cast<const unsigned char*>(dt_mapped), dt_length));
+    dt_zone->dt_mapping = dt_mapped;
+#else
+    std::ifstream dt_stream(dt_path, std::ios::binary);
+    if (!dt_stream) {
+        throw DateTimeException("Cannot open time zone file: " + dt_path);
+    }
+    std::vector<unsigned char> dt_bytes((std::istreambuf_iterator<char>(dt_stream)), std::istreambuf_iterator<char>());
+    std::shared_ptr<DateTimeZone> dt_zone(new DateTimeZone(dt_name, nullptr, dt_bytes.size()));
+    dt_zone->dt_ownedData = std::move(dt_bytes);
+    dt_zone->dt_data = dt_zone->dt_ownedData.data();
+#endif
+    dt_zone->parse();
+    return dt_zone;
+}
+
+std::shared_ptr<const DateTimeZone> DateTimeZone::fromMemory(std::string_view dt_name, std::span<const unsigned char> dt_data) {
+    std::shared_ptr<DateTimeZone> dt_zone(new DateTimeZone(dt_name, dt_data.data(), dt_data.size()));
+    dt_zone->parse();
+    return dt_zone;
+}
+
+std::shared_ptr<const DateTimeZone> DateTimeZone::fromPosixRule(std::string_view dt_rule) {
+    const DateTimePosixRule dt_parsed(dt_rule);
+
+    // Minimal version 2 TZif: empty version 1 block, no transitions, the rule's types and footer
+    auto dt_appendBigEndian32 = [](std::vector<unsigned char>& dt_bytes, std::uint32_t dt_value) {
+        for (int dt_shift = 24; dt_shift >= 0; dt_shift -= 8) {
+            dt_bytes.push_back(static_cast<unsigned char>(dt_value >> dt_shift));
+        }
+    };
+    auto dt_appendHeader = [&](std::vector<unsigned char>& dt_bytes, std::uint32_t dt_types, std::uint32_t dt_chars) {
+        dt_bytes.insert(dt_bytes.end(), {'T', 'Z', 'i', 'f', '2'});
+        dt_bytes.resize(dt_bytes.size() + 15 + 16, 0);  // Reserved, then isutcnt, isstdcnt, leapcnt, timecnt
+        dt_appendBigEndian32(dt_bytes, dt_types);
+        dt_appendBigEndian32(dt_bytes, dt_chars);
+    };
+    const std::string& dt_standardName = dt_parsed.standardName();
+    const std::string& dt_dstName = dt_parsed.dstName();
+    const std::uint32_t dt_typeCount = dt_parsed.hasDst() ? 2 : 1;
+    const std::uint32_t dt_chars = static_cast<std::uint32_t>(dt_standardName.size() + 1 + (dt_parsed.hasDst() ? dt_dstName.size() + 1 : 0));
+
+    std::vector<unsigned char> dt_bytes;
+    dt_appendHeader(dt_bytes, 0, 0);
+    dt_appendHeader(dt_bytes, dt_typeCount, dt_chars);
+    dt_appendBigEndian32(dt_bytes, static_cast<std::uint32_t>(dt_parsed.standardOffset()));
+    dt_bytes.insert(dt_bytes.end(), {0, 0});
+    if (dt_parsed.hasDst()) {
+        dt_appendBigEndian32(dt_bytes, static_cast<std::uint32_t>(dt_parsed.dstOffset()));
+        dt_bytes.insert(dt_bytes.end(), {1, static_cast<unsigned char>(dt_standardName.size() + 1)});
+    }
+    for (const std::string* dt_abbreviation : {&dt_standardName, &dt_dstName}) {
+        if (!dt_abbreviation->empty()) {
+            dt_bytes.insert(dt_bytes.end(), dt_abbreviation->begin(), dt_abbreviation->end());
+            dt_bytes.push_back(0);
+        }
+    }
+    dt_bytes.push_back('\n');
+    dt_bytes.insert(dt_bytes.end(), dt_rule.begin(), dt_rule.end());
+    dt_bytes.push_back('\n');
+
+    std::shared_ptr<DateTimeZone> dt_zone(new DateTimeZone(dt_rule, nullptr, dt_bytes.size()));
+    dt_zone->dt_ownedData = std::move(dt_bytes);
+    dt_zone->dt_data = dt_zone->dt_ownedData.data();
+    dt_zone->parse();
+    return dt_zone;
+}
+
+std::string DateTimeZone::zoneInfoDirectory() {
+    DT_ZoneDirectory& dt_directory = DT_ZoneDirectory::instance();
+    std::lock_guard<std::mutex> dt_lock(dt_directory.mutex);
+    return dt_directory.resolvedDirectory();
+}
+
+void DateTimeZone::setZoneInfoDirectory(const std::string& dt_directory) {
+    {
+        DT_ZoneDirectory& dt_zoneDirectory = DT_ZoneDirectory::instance();
+        std::lock_guard<std::mutex> dt_lock(dt_zoneDirectory.mutex);
+        dt_zoneDirectory.directory = dt_directory;
+        dt_zoneDirectory.directorySet = true;
+    }
+    // Zones already handed out stay valid; registered ones are read again from the new directory
+    DateTimeZoneRegistry::instance().reload();
+}
+
+void DateTimeZone::setIndexYears(int dt_firstYear, int dt_lastYear) {
+    dt_indexYears.store((static_cast<std::uint64_t>(static_cast<std::uint32_t>(dt_firstYear)) << 32) |
+                            static_cast<std::uint32_t>(dt_lastYear),
+                        std::memory_order_relaxed);
+}
+
+std::pair<int, int> DateTimeZone::indexYears() {
+    const std::uint64_t dt_years = dt_indexYears.load(std::memory_order_relaxed);
+    return {static_cast<std::int32_t>(dt_years >> 32), static_cast<std::int32_t>(dt_years & 0xFFFFFFFFu)};
+}
+
+void DateTimeZone::parse() {
+    if (dt_size < dt_headerSize || std::memcmp(dt_data, "TZif", 4) != 0) {
+        dt_throwMalformed(dt_name, "missing TZif header");
+    }
+    dt_version = static_cast<char>(dt_data[4]);
+
+    // Header counts: isutcnt, isstdcnt, leapcnt, timecnt, typecnt, charcnt
+    auto dt_blockSize = [](const unsigned char* dt_header, std::size_t dt_timeBytes) {
+        const std::size_t dt_isUtc = dt_readBigEndian32(dt_header + 20);
+        const std::size_t dt_isStd = dt_readBigEndian32(dt_header + 24);
+        const std::size_t dt_leap = dt_readBigEndian32(dt_header + 28);
+        const std::size_t dt_times = dt_readBigEndian32(dt_header + 32);
+        const std::size_t dt_types = dt_readBigEndian32(dt_header + 36);
+        const std::size_t dt_chars = dt_readBigEndian32(dt_header + 40);
+        return dt_times * (dt_timeBytes + 1) + dt_types * dt_typeSize + dt_chars + dt_leap * (dt_timeBytes + 4) + dt_isStd + dt_isUtc;
+    };
+
+    // Version 2+ files repeat the data with 64-bit times after the version 1 block
+    const unsigned char* dt_header = dt_data;
+    dt_timeSize = 4;
+    std::size_t dt_end = dt_headerSize + dt_blockSize(dt_header, 4);
+    if (dt_version != 0) {
+        if (dt_end + dt_headerSize > dt_size || std::memcmp(dt_data + dt_end, "TZif", 4) != 0) {
+            dt_throwMalformed(dt_name, "missing version 2 header");
+        }
+        dt_header = dt_data + dt_end;
+        dt_timeSize = 8;
+        dt_end += dt_headerSize + dt_blockSize(dt_header, 8);
+    }
+    if (dt_end > dt_size) {
+        dt_throwMalformed(dt_name, "truncated data block");
+    }
+
+    dt_transitionCount = dt_readBigEndian32(dt_header + 32);
+    dt_typeCount = dt_readBigEndian32(dt_header + 36);
+    dt_abbreviationSize = dt_readBigEndian32(dt_header + 40);
+    if (dt_typeCount == 0 || dt_abbreviationSize == 0) {
+        dt_throwMalformed(dt_name, "no local time types");
+    }
+    dt_transitionTimes = dt_header + dt_headerSize;
+    dt_transitionTypes = dt_transitionTimes + dt_transitionCount * dt_timeSize;
+    dt_types = dt_transitionTypes + dt_transitionCount;
+    dt_abbreviations = reinterpret_cast<const char*>(dt_types + dt_typeCount * dt_typeSize);
+
+    for (std::size_t dt_index = 0; dt_index < dt_transitionCount; ++dt_index) {
+        if (dt_transitionTypes[dt_index] >= dt_typeCount) {
+            dt_throwMalformed(dt_name, "transition type out of range");
+        }
+        if (dt_index > 0 && transitionTime(dt_index) <= transitionTime(dt_index - 1)) {
+            dt_throwMalformed(dt_name, "transitions out of order");
+        }
+    }
+    for (std::size_t dt_index = 0; dt_index < dt_typeCount; ++dt_index) {
+        const unsigned char* dt_type = dt_types + dt_index * dt_typeSize;
+        if (dt_type[4] > 1 || dt_type[5] >= dt_abbreviationSize) {
+            dt_throwMalformed(dt_name, "invalid local time type");
+        }
+    }
+
+    // Footer: "\n<POSIX TZ string>\n"
+    if (dt_version != 0 && dt_end < dt_size && dt_data[dt_end] == '\n') {
+        const char* dt_footerStart = reinterpret_cast<const char*>(dt_data + dt_end + 1);
+        const void* dt_newline = std::memchr(dt_footerStart, '\n', dt_size - dt_end - 1);
+        if (dt_newline != nullptr) {
+            dt_footer = std::string_view(dt_footerStart, static_cast<const char*>(dt_newline) - dt_footerStart);
+        }
+    }
+    if (!dt_footer.empty()) {
+        // An unusable footer leaves the last transition's type in effect, as for version 1 data
+        try {
+            dt_rule = std::make_unique<const DateTimePosixRule>(dt_footer);
+            dt_ruleStart = dt_transitionCount > 0 ? transitionTime(dt_transitionCount - 1) : std::numeric_limits<std::int64_t>::min();
+        } catch (const DateTimeException&) {
+            dt_rule.reset();
+        }
+    }
+
+    // Standard offset: the latest transition into standard time, else the first such type
+    dt_standardOffset = localType(0).utcOffset;
+    bool dt_found = false;
+    for (std::size_t dt_index = dt_transitionCount; dt_index > 0 && !dt_found; --dt_index) {
+        const LocalType dt_type = localType(dt_transitionTypes[dt_index - 1]);
+        if (!dt_type.isDst) {
+            dt_standardOffset = dt_type.utcOffset;
+            dt_found = true;
+        }
+    }
+    for (std::size_t dt_index = 0; dt_index < dt_typeCount && !dt_found; ++dt_index) {
+        const LocalType dt_type = localType(dt_index);
+        if (!dt_type.isDst) {
+            dt_standardOffset = dt_type.utcOffset;
+            dt_found = true;
+        }
+    }
+    buildIndex();
+}
+
+void DateTimeZone::buildIndex() {
+    const auto [dt_firstYear, dt_lastYear] = indexYears();
+    if (dt_lastYear <= dt_firstYear) {
+        return;
+    }
+    constexpr std::int64_t dt_bucketSeconds = std::int64_t{1} << dt_bucketShift;
+    constexpr std::int64_t dt_never = std::numeric_limits<std::int64_t>::max();
+    dt_indexStart = DateTime::daysFromCivil(dt_firstYear, 1, 1) * 86400;
+    const std::int64_t dt_indexEnd = DateTime::daysFromCivil(dt_lastYear, 1, 1) * 86400;
+    dt_index.resize(static_cast<std::size_t>((dt_indexEnd - dt_indexStart + dt_bucketSeconds - 1) >> dt_bucketShift));
+    // The last bucket may reach past the window
+    const std::int64_t dt_coveredEnd = dt_indexStart + (static_cast<std::int64_t>(dt_index.size()) << dt_bucketShift);
+
+    // Transitions inside the window: the TZif table, then those of the footer rule
+    struct DT_Change {
+        std::int64_t time;
+        std::int32_t offset;
+        std::uint8_t type;
+    };
+    std::vector<DT_Change> dt_changes;
+    for (std::size_t dt_next = 0; dt_next < dt_transitionCount; ++dt_next) {
+        const std::int64_t dt_time = transitionTime(dt_next);
+        if (dt_time >= dt_indexStart && dt_time < dt_coveredEnd && (dt_rule == nullptr || dt_time < dt_ruleStart)) {
+            dt_changes.push_back(DT_Change{dt_time, localType(dt_transitionTypes[dt_next]).utcOffset, dt_transitionTypes[dt_next]});
+        }
+    }
+    if (dt_rule != nullptr && dt_ruleStart < dt_coveredEnd) {
+        // Types past dt_ruleStart are never read (localTypeAt asks the rule), only the offsets
+        const std::int64_t dt_from = std::max(dt_ruleStart, dt_indexStart);
+        const std::uint8_t dt_lastType = static_cast<std::uint8_t>(searchTypeIndexAt(dt_from));
+        std::vector<std::int64_t> dt_times{dt_from};
+        if (dt_rule->hasDst()) {
+            const std::int64_t dt_firstRuleYear = DateTime::civilFromDays(dt_from / 86400).year - 1;
+            for (std::int64_t dt_year = dt_firstRuleYear; dt_year <= dt_lastYear + 1; ++dt_year) {
+                const DateTimePosixRule::YearTransitions dt_yearTransitions = dt_rule->transitionsFor(dt_year);
+                for (std::int64_t dt_time : {dt_yearTransitions.dstStart, dt_yearTransitions.dstEnd}) {
+                    if (dt_time > dt_from && dt_time < dt_coveredEnd) {
+                        dt_times.push_back(dt_time);
+                    }
+                }
+            }
+            std::sort(dt_times.begin(), dt_times.end());
+        }
+        std::int32_t dt_previous = dt_from > dt_indexStart ? searchOffsetAt(dt_from - 1) : searchOffsetAt(dt_from);
+        for (std::int64_t dt_time : dt_times) {
+            const std::int32_t dt_offset = dt_rule->offsetAt(dt_time);
+            if (dt_offset != dt_previous) {
+                dt_changes.push_back(DT_Change{dt_time, dt_offset, dt_lastType});
+                dt_previous = dt_offset;
+            }
+        }
+    }
+
+    // Walk buckets and changes together; dt_next is the first change at or after the bucket
+    std::size_t dt_next = 0;
+    for (std::size_t dt_bucket = 0; dt_bucket < dt_index.size(); ++dt_bucket) {
+        const std::int64_t dt_start = dt_indexStart + static_cast<std::int64_t>(dt_bucket) * dt_bucketSeconds;
+        IndexBucket& dt_entry = dt_index[dt_bucket];
+        dt_entry = IndexBucket{dt_never, dt_never, {}, {}, false};
+        std::uint8_t dt_type = static_cast<std::uint8_t>(searchTypeIndexAt(dt_start));
+        std::int32_t dt_offset = searchOffsetAt(dt_start);
+        for (int dt_slot = 0; dt_slot < 3; ++dt_slot) {
+            dt_entry.type[dt_slot] = dt_type;
+            dt_entry.offset[dt_slot] = dt_offset;
+            if (dt_slot < 2 && dt_next < dt_changes.size() && dt_changes[dt_next].time < dt_start + dt_bucketSeconds) {
+                (dt_slot == 0 ? dt_entry.first : dt_entry.second) = dt_changes[dt_next].time;
+                dt_type = dt_changes[dt_next].type;
+                dt_offset = dt_changes[dt_next++].offset;
+            }
+        }
+        while (dt_next < dt_changes.size() && dt_changes[dt_next].time < dt_start + dt_bucketSeconds) {
+            dt_entry.overflow = true;
+            ++dt_next;
+        }
+    }
+}
+
+std::int64_t DateTimeZone::transitionTime(std::size_t dt_index) const {
+    const unsigned char* dt_bytes = dt_transitionTimes + dt_index * dt_timeSize;
+    return dt_timeSize == 8 ? static_cast<std::int64_t>(dt_readBigEndian64(dt_bytes))
+                            : static_cast<std::int32_t>(dt_readBigEndian32(dt_bytes));
+}
+
+DateTimeZone::Transition DateTimeZone::transition(std::size_t dt_index) const {
+    if (dt_index >= dt_transitionCount) {
+        throw DateTimeException("Transition index out of range: " + std::to_string(dt_index));
+    }
+    return Transition{transitionTime(dt_index), localType(dt_transitionTypes[dt_index])};
+}
+
+DateTimeZone::LocalType DateTimeZone::localType(std::size_t dt_index) const {
+    if (dt_index >= dt_typeCount) {
+        throw DateTimeException("Local time type index out of range: " + std::to_string(dt_index));
+    }
+    const unsigned char* dt_type = dt_types + dt_index * dt_typeSize;
+    const char* dt_abbreviation = dt_abbreviations + dt_type[5];
+    const std::size_t dt_limit = dt_abbreviationSize - dt_type[5];
+    const void* dt_terminator = std::memchr(dt_abbreviation, '\0', dt_limit);
+    const std::size_t dt_length = dt_terminator != nullptr ? static_cast<const char*>(dt_terminator) - dt_abbreviation : dt_limit;
+    return LocalType{static_cast<std::int32_t>(dt_readBigEndian32(dt_type)), dt_type[4] != 0,
+                     std::string_view(dt_abbreviation, dt_length)};
+}
+
+const DateTimeZone::IndexBucket* DateTimeZone::bucketAt(std::int64_t dt_utcSeconds) const {
+    if (dt_utcSeconds < dt_indexStart) {
+        return nullptr;
+    }
+    const std::uint64_t dt_bucket = (static_cast<std::uint64_t>(dt_utcSeconds) - static_cast<std::uint64_t>(dt_indexStart)) >> dt_bucketShift;
+    if (dt_bucket >= dt_index.size() || dt_index[dt_bucket].overflow) {
+        return nullptr;
+    }
+    return &dt_index[dt_bucket];
+}
+
+std::size_t DateTimeZone::typeIndexAt(std::int64_t dt_utcSeconds) const {
+    if (const IndexBucket* dt_entry = bucketAt(dt_utcSeconds)) {
+        return dt_entry->type[(dt_utcSeconds >= dt_entry->first) + (dt_utcSeconds >= dt_entry->second)];
+    }
+    return searchTypeIndexAt(dt_utcSeconds);
+}
+
+std::size_t DateTimeZone::searchTypeIndexAt(std::int64_t dt_utcSeconds) const {
+    // Type 0 applies before the first transition
+    if (dt_transitionCount == 0 || dt_utcSeconds < transitionTime(0)) {
+        return 0;
+    }
+    // Last transition at or before the instant
+    std::size_t dt_low = 0;
+    std::size_t dt_high = dt_transitionCount;
+    while (dt_high - dt_low > 1) {
+        const std::size_t dt_middle = dt_low + (dt_high - dt_low) / 2;
+        if (transitionTime(dt_middle) <= dt_utcSeconds) {
+            dt_low = dt_middle;
+        } else {
+            dt_high = dt_middle;
+        }
+    }
+    return dt_transitionTypes[dt_low];
+}
+
+DateTimeZone::LocalType DateTimeZone::localTypeAt(std::int64_t dt_utcSeconds) const {
+    if (dt_rule != nullptr && dt_utcSeconds >= dt_ruleStart) {
+        const bool dt_isDst = dt_rule->isDstAt(dt_utcSeconds);
+        return LocalType{dt_isDst ? dt_rule->dstOffset() : dt_rule->standardOffset(), dt_isDst,
+                         dt_isDst ? dt_rule->dstName() : dt_rule->standardName()};
+    }
+    return localType(typeIndexAt(dt_utcSeconds));
+}
+
+std::size_t DateTimeZone::maxAbbreviationLength() const {
+    std::size_t dt_length = 0;
+    for (std::size_t dt_index = 0; dt_index < dt_typeCount; ++dt_index) {
+        dt_length = std::max(dt_length, localType(dt_index).abbreviation.size());
+    }
+    if (dt_rule != nullptr) {
+        dt_length = std::max({dt_length, dt_rule->standardName().size(), dt_rule->dstName().size()});
+    }
+    return dt_length;
+}
+
+std::int32_t DateTimeZone::offsetAt(std::int64_t dt_utcSeconds) const {
+    if (const IndexBucket* dt_entry = bucketAt(dt_utcSeconds)) {
+        return dt_entry->offset[(dt_utcSeconds >= dt_entry->first) + (dt_utcSeconds >= dt_entry->second)];
+    }
+    return searchOffsetAt(dt_utcSeconds);
+}
+
+std::int32_t DateTimeZone::searchOffsetAt(std::int64_t dt_utcSeconds) const {
+    if (dt_rule != nullptr && dt_utcSeconds >= dt_ruleStart) {
+        return dt_rule->offsetAt(dt_utcSeconds);
+    }
+    return static_cast<std::int32_t>(dt_readBigEndian32(dt_types + searchTypeIndexAt(dt_utcSeconds) * dt_typeSize));
+}
+
+std::int32_t DateTimeZone::offsetForLocal(std::int64_t dt_localSeconds) const {
+    // Offsets in effect a day either side; real zones never transition twice within that window
+    const std::int32_t dt_before = offsetAt(dt_localSeconds - 86400);
+    if (offsetAt(dt_localSeconds - dt_before) == dt_before) {
+        return dt_before;
+    }
+    const std::int32_t dt_after = offsetAt(dt_localSeconds + 86400);
+    if (offsetAt(dt_localSeconds - dt_after) == dt_after) {
+        return dt_after;
+    }
+    return dt_before;
+}
@@ -0,0 +1,275 @@
+#include "datetime_zone_registry.hpp"
+#include <cstring>
+#include <utility>
+
+DateTimeZoneRegistry& DateTimeZoneRegistry::instance() {
+    // Never destroyed: zones handed out (and interned in regions) stay valid until the process exits
+    static DateTimeZoneRegistry* dt_registry = new DateTimeZoneRegistry();
+    return *dt_registry;
+}
+
+std::size_t DateTimeZoneRegistry::hashName(std::string_view dt_name) {
+    // Eight bytes per multiply: byte-wise FNV-1a was a serial chain of one multiply per character,
+    // which dominated lookups of names like "America/New_York"
+    constexpr std::uint64_t dt_multiplier = 0x9E3779B97F4A7C15ull;
+    std::uint64_t dt_hash = dt_name.size() * dt_multiplier;
+    std::size_t dt_position = 0;
+    for (; dt_position + 8 <= dt_name.size(); dt_position += 8) {
+        std::uint64_t dt_word;
+        std::memcpy(&dt_word, dt_name.data() + dt_position, 8);
+        dt_hash = (dt_hash ^ dt_word) * dt_multiplier;
+        dt_hash ^= dt_hash >> 29;
+    }
+    if (dt_position < dt_name.size()) {
+        // The last eight bytes (overlapping the loop) when there are that many, else byte by byte
+        std::uint64_t dt_word = 0;
+        if (dt_name.size() >= 8) {
+            std::memcpy(&dt_word, dt_name.data() + dt_name.size() - 8, 8);
+        } else {
+            for (unsigned char dt_char : dt_name) {
+                dt_word = dt_word << 8 | dt_char;
+            }
+        }
+        dt_hash = (dt_hash ^ dt_word) * dt_multiplier;
+    }
+    dt_hash ^= dt_hash >> 32;
+    return static_cast<std::size_t>(dt_hash * dt_multiplier ^ (dt_hash >> 29));
+}
+
+std::shared_ptr<const DateTimeZone> DateTimeZoneRegistry::borrowed(const DateTimeZone* dt_zone) {
+    // Aliasing constructor with an empty owner: no control block, so copies touch no counter
+    return std::shared_ptr<const DateTimeZone>(std::shared_ptr<const DateTimeZone>(), dt_zone);
+}
+
+DateTimeZoneRegistry::Entry* DateTimeZoneRegistry::lookup(std::string_view dt_name, std::size_t dt_hash) const {
+    for (std::size_t dt_slot = dt_hash & dt_indexMask;; dt_slot = (dt_slot + 1) & dt_indexMask) {
+        const std::uint32_t dt_value = dt_index[dt_slot].load(std::memory_order_acquire);
+        if (dt_value == 0) {
+            return nullptr;
+        }
+        Entry* dt_entry = dt_entries[dt_value - 1].load(std::memory_order_acquire);
+        if (dt_entry->name == dt_name) {
+            return dt_entry;
+        }
+    }
+}
+
+DateTimeZoneRegistry::Entry* DateTimeZoneRegistry::insertLocked(std::string_view dt_name, std::size_t dt_hash, Entry* dt_target,
+                                                                bool dt_isRegistered) {
+    if (!dt_isRegistered) {
+        if (dt_missCount >= dt_maxMisses) {
+            return nullptr;
+        }
+        ++dt_missCount;
+    } else if (dt_registered.load(std::memory_order_relaxed) >= dt_maxNames) {
+        throw DateTimeException("Zone registry is full, cannot register: " + std::string(dt_name));
+    }
+    const std::uint32_t dt_count = dt_size.load(std::memory_order_relaxed);
+    dt_ownedEntries.push_back(std::make_unique<Entry>());
+    Entry* dt_entry = dt_ownedEntries.back().get();
+    dt_entry->name = std::string(dt_name);
+    dt_entry->target.store(dt_target, std::memory_order_relaxed);
+    dt_entry->registered.store(dt_isRegistered, std::memory_order_relaxed);
+    dt_entries[dt_count].store(dt_entry, std::memory_order_release);
+
+    // Publish in the index after the entry itself is visible
+    for (std::size_t dt_slot = dt_hash & dt_indexMask;; dt_slot = (dt_slot + 1) & dt_indexMask) {
+        if (dt_index[dt_slot].load(std::memory_order_relaxed) == 0) {
+            dt_index[dt_slot].store(dt_count + 1, std::memory_order_release);
+            break;
+        }
+    }
+    dt_size.store(dt_count + 1, std::memory_order_release);
+    if (dt_isRegistered) {
+        dt_registered.fetch_add(1, std::memory_order_release);
+    }
+    return dt_entry;
+}
+
+void DateTimeZoneRegistry::registerLocked(Entry& dt_entry) {
+    if (!dt_entry.registered.load(std::memory_order_relaxed)) {
+        if (dt_registered.load(std::memory_order_relaxed) >= dt_maxNames) {
+            throw DateTimeException("Zone registry is full, cannot register: " + dt_entry.name);
+        }
+        dt_entry.miss.store(Miss::None, std::memory_order_release);
+        dt_entry.registered.store(true, std::memory_order_release);
+        dt_registered.fetch_add(1, std::memory_order_release);
+    }
+}
+
+void DateTimeZoneRegistry::publishLocked(Entry& dt_entry, std::shared_ptr<const DateTimeZone> dt_zone) {
+    registerLocked(dt_entry);
+    dt_ownedZones.push_back(std::move(dt_zone));
+    dt_entry.zone.store(dt_ownedZones.back().get(), std::memory_order_release);
+}
+
+void DateTimeZoneRegistry::recordMiss(std::string_view dt_name, std::size_t dt_hash, Miss dt_miss, std::uint64_t dt_sinceGeneration) {
+    std::lock_guard<std::mutex> dt_lock(dt_writeMutex);
+    if (dt_generation.load(std::memory_order_relaxed) != dt_sinceGeneration) {
+        return;  // A reload ran meanwhile, so the name may load now
+    }
+    Entry* dt_entry = lookup(dt_name, dt_hash);
+    if (dt_entry == nullptr) {
+        dt_entry = insertLocked(dt_name, dt_hash, nullptr, false);
+    }
+    if (dt_entry != nullptr && dt_entry->zone.load(std::memory_order_relaxed) == nullptr) {
+        dt_entry->miss.store(dt_miss, std::memory_order_release);
+    }
+}
+
+std::shared_ptr<const DateTimeZone> DateTimeZoneRegistry::resolve(std::string_view dt_name, std::string* dt_error) {
+    const std::size_t dt_hash = hashName(dt_name);
+
+    // Lock-free path for loaded zones and remembered misses
+    const Entry* dt_entry = lookup(dt_name, dt_hash);
+    if (dt_entry != nullptr) {
+        if (const Entry* dt_target = dt_entry->target.load(std::memory_order_acquire)) {
+            dt_entry = dt_target;
+        }
+        if (const DateTimeZone* dt_zone = dt_entry->zone.load(std::memory_order_acquire)) {
+            return borrowed(dt_zone);
+        }
+        switch (dt_entry->miss.load(std::memory_order_acquire)) {
+            case Miss::None:
+                break;
+            case Miss::PosixRule:
+                return DateTimeZone::fromPosixRule(dt_entry->name);
+            case Miss::Unknown:
+                if (dt_error != nullptr) {
+                    *dt_error = "Unknown time zone: " + dt_entry->name;
+                }
+                return nullptr;
+        }
+    }
+
+    // First use: read without holding the lock. Registered names (alias targets) accept a POSIX
+    // TZ string; any other POSIX string is handed out without registering it.
+    const std::uint64_t dt_startGeneration = dt_generation.load(std::memory_order_acquire);
+    const std::string dt_zoneName = dt_entry != nullptr ? dt_entry->name : std::string(dt_name);
+    const std::size_t dt_zoneHash = hashName(dt_zoneName);
+    const bool dt_isRegistered = dt_entry != nullptr && dt_entry->registered.load(std::memory_order_acquire);
+    std::shared_ptr<const DateTimeZone> dt_zone;
+    try {
+        dt_zone = dt_isRegistered ? DateTimeZone::read(dt_zoneName) : DateTimeZone::readTzif(dt_zoneName);
+    } catch (const DateTimeException& dt_fileError) {
+        if (!dt_isRegistered) {
+            try {
+                std::shared_ptr<const DateTimeZone> dt_rule = DateTimeZone::fromPosixRule(dt_zoneName);
+                recordMiss(dt_zoneName, dt_zoneHash, Miss::PosixRule, dt_startGeneration);
+                return dt_rule;
+            } catch (const DateTimeException&) {
+            }
+        }
+        recordMiss(dt_zoneName, dt_zoneHash, Miss::Unknown, dt_startGeneration);
+        if (dt_error != nullptr) {
+            *dt_error = dt_fileError.what();
+        }
+        return nullptr;
+    }
+
+    // Publish unless another thread won the race
+    std::lock_guard<std::mutex> dt_lock(dt_writeMutex);
+    Entry* dt_target = lookup(dt_zoneName, dt_zoneHash);
+    if (dt_target == nullptr) {
+        dt_target = insertLocked(dt_zoneName, dt_zoneHash, nullptr, true);
+    }
+    if (dt_target->zone.load(std::memory_order_relaxed) == nullptr) {
+        publishLocked(*dt_target, std::move(dt_zone));
+    }
+    return borrowed(dt_target->zone.load(std::memory_order_relaxed));
+}
+
+std::shared_ptr<const DateTimeZone> DateTimeZoneRegistry::find(std::string_view dt_name) {
+    try {
+        return resolve(dt_name, nullptr);
+    } catch (const DateTimeException&) {
+        return nullptr;  // Registry full
+    }
+}
+
+std::shared_ptr<const DateTimeZone> DateTimeZoneRegistry::get(std::string_view dt_name) {
+    std::string dt_error;
+    std::shared_ptr<const DateTimeZone> dt_zone = resolve(dt_name, &dt_error);
+    if (dt_zone == nullptr) {
+        throw DateTimeException(dt_error);
+    }
+    return dt_zone;
+}
+
+void DateTimeZoneRegistry::addAlias(std::string_view dt_alias, std::string_view dt_target) {
+    std::lock_guard<std::mutex> dt_lock(dt_writeMutex);
+    Entry* dt_targetEntry = lookup(dt_target, hashName(dt_target));
+    if (dt_targetEntry == nullptr) {
+        dt_targetEntry = insertLocked(dt_target, hashName(dt_target), nullptr, true);
+    } else if (Entry* dt_aliased = dt_targetEntry->target.load(std::memory_order_relaxed)) {
+        dt_targetEntry = dt_aliased;  // Aliases of aliases point at the zone itself
+    } else {
+        registerLocked(*dt_targetEntry);  // A remembered miss is loaded again, now accepting POSIX strings
+    }
+
+    const std::size_t dt_hash = hashName(dt_alias);
+    if (Entry* dt_existing = lookup(dt_alias, dt_hash)) {
+        if (dt_existing->target.load(std::memory_order_relaxed) == dt_targetEntry) {
+            return;
+        }
+        if (dt_existing->registered.load(std::memory_order_relaxed)) {
+            throw DateTimeException("Time zone name is already registered: " + std::string(dt_alias));
+        }
+        // The name only recorded a failed lookup
+        dt_existing->target.store(dt_targetEntry, std::memory_order_release);
+        registerLocked(*dt_existing);
+        return;
+    }
+    insertLocked(dt_alias, dt_hash, dt_targetEntry, true);
+}
+
+std::size_t DateTimeZoneRegistry::reload() {
+    std::lock_guard<std::mutex> dt_reloadLock(dt_reloadMutex);
+    std::vector<Entry*> dt_loaded;
+    {
+        std::lock_guard<std::mutex> dt_lock(dt_writeMutex);
+        for (const std::unique_ptr<Entry>& dt_entry : dt_ownedEntries) {
+            if (dt_entry->zone.load(std::memory_order_relaxed) != nullptr) {
+                dt_loaded.push_back(dt_entry.get());
+            }
+        }
+    }
+
+    // File I/O happens outside the lock; each zone is swapped in as soon as it is read. Unchanged
+    // data keeps the current zone, so regions interned from it stay valid and nothing is retained.
+    std::size_t dt_replaced = 0;
+    for (Entry* dt_entry : dt_loaded) {
+        std::shared_ptr<const DateTimeZone> dt_zone;
+        try {
+            dt_zone = DateTimeZone::read(dt_entry->name);
+        } catch (const DateTimeException&) {
+            continue;
+        }
+        if (dt_zone->sameData(*dt_entry->zone.load(std::memory_order_acquire))) {
+            continue;
+        }
+        std::lock_guard<std::mutex> dt_lock(dt_writeMutex);
+        publishLocked(*dt_entry, std::move(dt_zone));
+        ++dt_replaced;
+    }
+
+    // Remembered misses are tried again; lookups that started before this point record none
+    std::lock_guard<std::mutex> dt_lock(dt_writeMutex);
+    for (const std::unique_ptr<Entry>& dt_entry : dt_ownedEntries) {
+        dt_entry->miss.store(Miss::None, std::memory_order_release);
+    }
+    dt_generation.fetch_add(1, std::memory_order_release);
+    return dt_replaced;
+}
+
+std::vector<std::string> DateTimeZoneRegistry::names() const {
+    std::lock_guard<std::mutex> dt_lock(dt_writeMutex);
+    std::vector<std::string> dt_names;
+    dt_names.reserve(dt_ownedEntries.size());
+    for (const std::unique_ptr<Entry>& dt_entry : dt_ownedEntries) {
+        if (dt_entry->registered.load(std::memory_order_relaxed)) {
+            dt_names.push_back(dt_entry->name);
+        }
+    }
+    return dt_names;
+}
@@ -0,0 +1,105 @@
+#include "datetime.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Count heap allocations so allocation-free paths can be verified. Replacing the global
+// allocation functions affects the whole program, so these tests have their own executable
+// and every replaceable form is overridden consistently.
+namespace {
+
+std::atomic<std::size_t> allocationCount{0};
+
+void* countedAllocate(std::size_t size, std::size_t alignment) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) {
+        size = 1;
+    }
+    if (alignment <= alignof(std::max_align_t)) {
+        return std::malloc(size);
+    }
+    // aligned_alloc requires a multiple of the alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+void* countedAllocateOrThrow(std::size_t size, std::size_t alignment) {
+    if (void* memory = countedAllocate(size, alignment)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    return countedAllocateOrThrow(size, alignof(std::max_align_t));
+}
+void* operator new[](std::size_t size) {
+    return countedAllocateOrThrow(size, alignof(std::max_align_t));
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return countedAllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return countedAllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size, alignof(std::max_align_t));
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size, alignof(std::max_align_t));
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { std::free(memory); }
+
+TEST(AllocationTest, FormatToDoesNotAllocate) {
+    DateTime dt(2023, 10, 15, 14, 30, 45, 0, DateTime::EasternTime);
+    const DateTime::FormatPattern pattern("%a %b %d %Y %H:%M:%S.%f %z %Z");
+    char buffer[128];
+    std::size_t total = 0;
+
+    const std::size_t before = allocationCount.load();
+    for (int i = 0; i < 100; ++i) {
+        DateTime shifted = dt.plusSeconds(i);
+        total += shifted.formatTo(buffer, buffer + sizeof(buffer), pattern).ptr - buffer;
+        total += shifted.formatTo(buffer, buffer + sizeof(buffer), "%F %T %Z").ptr - buffer;
+        total += DateTime::maxFormattedSize("%F %T %Z");
+    }
+    EXPECT_EQ(allocationCount.load(), before);
+    EXPECT_GT(total, 0u);
+}
+
+TEST(AllocationTest, CountsEveryAllocationForm) {
+    struct alignas(64) Aligned {
+        char bytes[64];
+    };
+    const std::size_t before = allocationCount.load();
+    // volatile keeps the compiler from eliding the new/delete pairs
+    int* volatile single = new int(1);
+    delete single;
+    int* volatile array = new int[4];
+    delete[] array;
+    Aligned* volatile aligned = new Aligned;
+    delete aligned;
+    int* volatile nothrow = new (std::nothrow) int(2);
+    delete nothrow;
+    EXPECT_EQ(allocationCount.load(), before + 4);
+}
@@ -0,0 +1,61 @@
+#include "datetime.hpp"
+#include "datetime_batch.hpp"
+#include "datetime_column.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+TEST(BatchFormatTest, FixedWidthRowsMatchToString) {
+    DateTimeBatchFormatter formatter("%Y-%m-%dT%H:%M:%S.%3f%z");
+    EXPECT_EQ(formatter.fixedWidth(), 28u);
+
+    std::vector<DateTime> values;
+    DateTime dt(1969, 12, 31, 23, 0, 0, 5);
+    for (int i = 0; i < 100; ++i) {
+        values.push_back(dt.plusMilliseconds(i * 3600001).convertToRegion(i % 2 ? DateTime::JapanTime : DateTime::WorldTime));
+    }
+    ASSERT_EQ(formatter.format(values), values.size());
+    ASSERT_EQ(formatter.size(), values.size());
+    ASSERT_EQ(formatter.offsets().size(), values.size() + 1);
+    EXPECT_EQ(formatter.arena().size(), values.size() * 28);
+
+    std::string expected;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const std::string text = values[i].toString("%Y-%m-%dT%H:%M:%S.%3f%z");
+        EXPECT_EQ(formatter[i], text);
+        EXPECT_EQ(formatter.offsets()[i], static_cast<std::int64_t>(expected.size()));
+        expected += text;
+    }
+    EXPECT_EQ(formatter.arena(), expected);
+
+    // Buffers are reused; a smaller batch replaces the previous one
+    ASSERT_EQ(formatter.format(std::span<const DateTime>(values.data(), 2)), 2u);
+    EXPECT_EQ(formatter.arena(), values[0].toString("%Y-%m-%dT%H:%M:%S.%3f%z") +
+                                 values[1].toString("%Y-%m-%dT%H:%M:%S.%3f%z"));
+    EXPECT_EQ(formatter.format(std::span<const DateTime>()), 0u);
+    EXPECT_TRUE(formatter.arena().empty());
+}
+
+TEST(BatchFormatTest, VariableWidthAndEpochArrays) {
+    DateTimeBatchFormatter formatter("%A, %d %B %Y %H:%M %Z");
+    EXPECT_EQ(formatter.fixedWidth(), 0u);
+
+    const DateTime::RegionHandle jst = DateTime::internRegion(DateTime::JapanTime);
+    std::vector<std::int64_t> epoch;
+    for (int i = 0; i < 500; ++i) {
+        epoch.push_back(1709294400000LL + i * 86400000LL * 3 + i);
+    }
+    ASSERT_EQ(formatter.format(epoch.data(), epoch.size(), jst), epoch.size());
+    for (std::size_t i = 0; i < epoch.size(); ++i) {
+        const DateTime dt(std::chrono::system_clock::time_point(std::chrono::milliseconds(epoch[i])), jst);
+        ASSERT_EQ(formatter[i], dt.toString("%A, %d %B %Y %H:%M %Z")) << "row " << i;
+    }
+
+    // Columns format each row in its own region
+    const DateTime utc(2024, 3, 1, 20, 0, 0);
+    DateTimeColumn column(std::vector<DateTime>{utc, utc.convertToRegion(DateTime::JapanTime)});
+    DateTimeBatchFormatter dates("%F %H");
+    ASSERT_EQ(dates.format(column), 2u);
+    EXPECT_EQ(dates.arena(), "2024-03-01 202024-03-02 05");
+}
@@ -0,0 +1,89 @@
+#include "datetime.hpp"
+#include "datetime_batch.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace {
+
+const DateTimeBatchParser::Isa allIsas[] = {
+    DateTimeBatchParser::Isa::Scalar,
+    DateTimeBatchParser::Isa::Sse42,
+    DateTimeBatchParser::Isa::Avx2,
+};
+
+std::int64_t epochMilliseconds(const DateTime& dt) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(dt.getSystemTime().time_since_epoch()).count();
+}
+
+} // namespace
+
+TEST(BatchParseTest, StridedRowsMatchScalarReference) {
+    // Rows of 24 bytes: 23 characters plus a delimiter
+    std::vector<DateTime> expected;
+    std::string column;
+    DateTime dt(1969, 12, 31, 23, 59, 58, 7);
+    for (int i = 0; i < 101; ++i) {
+        dt = dt.plusMilliseconds(987654321LL + i);
+        expected.push_back(dt);
+        column += dt.toString("%Y-%m-%d %H:%M:%S.%3f");
+        column += ',';
+    }
+
+    for (auto isa : allIsas) {
+        std::vector<std::int64_t> values(expected.size());
+        std::vector<std::size_t> malformed;
+        EXPECT_EQ(DateTimeBatchParser::parse(column.data(), expected.size(), 24, DateTimeBatchParser::Layout::Milliseconds,
+                                             values.data(), &malformed, isa), 0u);
+        EXPECT_TRUE(malformed.empty());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(values[i], epochMilliseconds(expected[i])) << "row " << i << " isa " << static_cast<int>(isa);
+        }
+    }
+}
+
+TEST(BatchParseTest, MalformedRowsAreReported) {
+    const std::vector<std::string> rows = {
+        "2024-03-01 12:00:00",
+        "2024-03-01T23:59:59",
+        "2024-02-30 12:00:00",   // Day does not exist
+        "2024-03-01 24:00:00",   // Hour out of range
+        "2024/03/01 12:00:00",   // Separator
+        "2024-03-01 12:0a:00",   // Digit
+        "2023-02-28 00:00:00",
+        "2024-13-01 00:00:00",   // Month out of range
+        "2199-12-31 23:59:59",
+    };
+    std::string column;
+    for (const std::string& row : rows) {
+        column += row;
+    }
+
+    for (auto isa : allIsas) {
+        std::vector<std::int64_t> values(rows.size());
+        std::vector<std::size_t> malformed;
+        EXPECT_EQ(DateTimeBatchParser::parse(column.data(), rows.size(), 19, DateTimeBatchParser::Layout::Seconds,
+                                             values.data(), &malformed, isa), 5u);
+        EXPECT_EQ(malformed, (std::vector<std::size_t>{2, 3, 4, 5, 7}));
+        EXPECT_EQ(values[0], epochMilliseconds(DateTime(2024, 3, 1, 12, 0, 0)));
+        EXPECT_EQ(values[1], epochMilliseconds(DateTime(2024, 3, 1, 23, 59, 59)));
+        EXPECT_EQ(values[2], DateTimeBatchParser::InvalidTimestamp);
+        EXPECT_EQ(values[6], epochMilliseconds(DateTime(2023, 2, 28)));
+        EXPECT_EQ(values[8], epochMilliseconds(DateTime(2199, 12, 31, 23, 59, 59)));
+    }
+}
+
+TEST(BatchParseTest, OffsetRows) {
+    const std::string buffer = "id=1 2024-03-01 12:00:00.250|id=22 2024-03-02 00:00:00.001|x 2024-03-0x 00:00:00.000";
+    const std::size_t offsets[] = {5, 35, 62};
+    for (auto isa : allIsas) {
+        std::int64_t values[3];
+        std::vector<std::size_t> malformed;
+        EXPECT_EQ(DateTimeBatchParser::parse(buffer.data(), offsets, 3, DateTimeBatchParser::Layout::Milliseconds,
+                                             values, &malformed, isa), 1u);
+        EXPECT_EQ(values[0], epochMilliseconds(DateTime(2024, 3, 1, 12, 0, 0, 250)));
+        EXPECT_EQ(values[1], epochMilliseconds(DateTime(2024, 3, 2, 0, 0, 0, 1)));
+        EXPECT_EQ(malformed, std::vector<std::size_t>{2});
+    }
+}
@@ -0,0 +1,178 @@
+#include "datetime.hpp"
+#include "datetime_column.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace {
+
+const DateTimeColumn::Isa allIsas[] = {
+    DateTimeColumn::Isa::Scalar,
+    DateTimeColumn::Isa::Avx2,
+};
+
+// 37 rows: not a multiple of the SIMD width, unsorted, spanning the epoch
+std::vector<DateTime> sampleValues() {
+    std::vector<DateTime> values;
+    DateTime dt(1969, 12, 31, 12, 0, 0);
+    for (int i = 0; i < 37; ++i) {
+        values.push_back(dt.plusMilliseconds(((i * 7919) % 37) * 3600123));
+    }
+    return values;
+}
+
+} // namespace
+
+TEST(ColumnTest, StoresMillisecondsAndRegions) {
+    DateTimeColumn column;
+    EXPECT_TRUE(column.empty());
+    EXPECT_FALSE(column.min().has_value());
+
+    column.push_back(DateTime(2024, 3, 1, 12, 0, 0, 123).plusMicroseconds(456));
+    EXPECT_EQ(column.size(), 1u);
+    EXPECT_EQ(column.data()[0], 1709294400123);
+    EXPECT_EQ(column[0], DateTime(2024, 3, 1, 12, 0, 0, 123));   // Floored to milliseconds
+    EXPECT_FALSE(column.hasRowRegions());
+
+    // A row in another region switches the column to per-row handles
+    const DateTime jst = DateTime(2024, 3, 1, 12, 0, 0).convertToRegion(DateTime::JapanTime);
+    column.push_back(jst);
+    EXPECT_TRUE(column.hasRowRegions());
+    EXPECT_EQ(column.region(0), DateTime::RegionHandle::World);
+    EXPECT_EQ(column.region(1), jst.getRegionHandle());
+    EXPECT_EQ(column[1].getHour(), 21);
+
+    DateTimeColumn adopted(std::vector<std::int64_t>{0, 86400000}, jst.getRegionHandle());
+    EXPECT_EQ(adopted[1].getDay(), 2);
+    EXPECT_EQ(adopted[1].getHour(), 9);
+}
+
+TEST(ColumnTest, KernelsMatchRowByRow) {
+    const std::vector<DateTime> values = sampleValues();
+    const DateTime from(1970, 1, 1, 0, 0, 0);
+    const DateTime to(1970, 1, 2, 0, 0, 0);
+
+    std::vector<std::size_t> expectedRows;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (values[i] >= from && values[i] < to) {
+            expectedRows.push_back(i);
+        }
+    }
+    ASSERT_FALSE(expectedRows.empty());
+
+    for (auto isa : allIsas) {
+        DateTimeColumn column(values);
+        column.setIsa(isa);
+        EXPECT_EQ(column.filterRange(from, to), expectedRows);
+        EXPECT_EQ(column.countInRange(from, to), expectedRows.size());
+        EXPECT_EQ(column.countInRange(to, from), 0u);  // Empty range
+        EXPECT_EQ(*column.min(), *std::min_element(values.begin(), values.end()));
+        EXPECT_EQ(*column.max(), *std::max_element(values.begin(), values.end()));
+
+        std::vector<std::int64_t> sinceOrigin(values.size());
+        column.timeBetween(from, sinceOrigin.data());
+
+        DateTimeColumn shifted(values);
+        shifted.setIsa(isa);
+        shifted.plusDays(2).plusHours(-3).plusMinutes(4).plusSeconds(-5).plusMilliseconds(6);
+        std::vector<std::int64_t> deltas(values.size());
+        DateTimeColumn::timeBetween(column, shifted, deltas.data());
+
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            const DateTime expected = values[i].plusDays(2).plusHours(-3).plusMinutes(4).plusSeconds(-5).plusMilliseconds(6);
+            EXPECT_EQ(shifted[i], expected) << "row " << i;
+            EXPECT_EQ(deltas[i], ((2 * 24 - 3) * 60 + 4) * 60000 - 5000 + 6);
+            EXPECT_EQ(sinceOrigin[i], (values[i].getTimePoint<std::chrono::milliseconds>() -
+                                       from.getTimePoint<std::chrono::milliseconds>()).count());
+        }
+    }
+
+    DateTimeColumn shorter(std::vector<std::int64_t>{1, 2});
+    std::vector<std::int64_t> out(2);
+    EXPECT_THROW(DateTimeColumn::timeBetween(shorter, DateTimeColumn(values), out.data()), DateTimeException);
+}
+
+TEST(ColumnTest, ExtremesKeepRowRegion) {
+    const DateTime jst = DateTime(2024, 3, 1, 0, 0, 0).convertToRegion(DateTime::JapanTime);
+    DateTimeColumn column(std::vector<DateTime>{DateTime(2024, 3, 2, 0, 0, 0), jst, DateTime(2024, 3, 3, 0, 0, 0),
+                                                DateTime(2024, 3, 4, 0, 0, 0), DateTime(2024, 3, 5, 0, 0, 0)});
+    ASSERT_TRUE(column.hasRowRegions());
+    EXPECT_EQ(column.min()->getRegionHandle(), jst.getRegionHandle());
+    EXPECT_EQ(column.max()->getRegionHandle(), DateTime::RegionHandle::World);
+}
+
+TEST(ColumnTest, ExtractFieldsMatchesDateTimeFields) {
+    // Leap days, century boundaries, pre-epoch instants and an uneven row count
+    std::vector<std::int64_t> values;
+    const DateTime anchors[] = {DateTime(1970, 1, 1, 0, 0, 0), DateTime(1969, 12, 31, 23, 59, 59, 999),
+                                DateTime(1904, 2, 28, 12, 0, 0), DateTime(1900, 3, 1, 0, 0, 0),
+                                DateTime(2000, 2, 29, 23, 59, 59, 1), DateTime(2100, 12, 31, 8, 30, 0)};
+    for (const DateTime& anchor : anchors) {
+        for (int i = -20; i <= 20; ++i) {
+            values.push_back(anchor.plusMilliseconds(i * 3599999).getTimePoint<std::chrono::milliseconds>()
+                                 .time_since_epoch().count());
+        }
+    }
+    const DateTime::RegionHandle regions[] = {DateTime::RegionHandle::World,
+                                              DateTime::internRegion(DateTime::JapanTime),
+                                              DateTime::internRegion(DateTime::RegionTime("NST", -3, -30))};
+
+    for (auto region : regions) {
+        for (auto isa : allIsas) {
+            std::vector<std::int32_t> year(values.size()), month(values.size()), day(values.size()), hour(values.size()),
+                minute(values.size()), second(values.size()), millisecond(values.size()), weekday(values.size());
+            DateTimeColumn::FieldArrays out{year.data(), month.data(), day.data(), hour.data(), minute.data(),
+                                            second.data(), millisecond.data(), weekday.data()};
+            DateTimeColumn::extractFields(values.data(), values.size(), region, out, isa);
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                const DateTime dt(std::chrono::system_clock::time_point(std::chrono::milliseconds(values[i])), region);
+                const DateTime::Fields fields = dt.fields();
+                ASSERT_EQ(year[i], fields.year) << "row " << i;
+                ASSERT_EQ(month[i], fields.month) << "row " << i;
+                ASSERT_EQ(day[i], fields.day) << "row " << i;
+                ASSERT_EQ(hour[i], fields.hour) << "row " << i;
+                ASSERT_EQ(minute[i], fields.minute) << "row " << i;
+                ASSERT_EQ(second[i], fields.second) << "row " << i;
+                ASSERT_EQ(millisecond[i], fields.millisecond) << "row " << i;
+                ASSERT_EQ(weekday[i], fields.dayOfWeek) << "row " << i;
+            }
+        }
+    }
+}
+
+TEST(ColumnTest, ExtractFieldsSimdMatchesScalarFarFromEpoch) {
+    // Beyond the range of DateTime itself; includes values past the SIMD range
+    std::vector<std::int64_t> values;
+    for (std::int64_t i = -500; i < 500; ++i) {
+        values.push_back(i * 1125899906842ll + i * 977);
+    }
+    values.push_back((std::int64_t{1} << 49) + 5);
+    values.push_back(-(std::int64_t{1} << 49) - 5);
+
+    std::vector<std::int32_t> scalarYear(values.size()), scalarDay(values.size()), simdYear(values.size()),
+        simdDay(values.size());
+    DateTimeColumn::FieldArrays scalarOut;
+    scalarOut.year = scalarYear.data();
+    scalarOut.day = scalarDay.data();
+    DateTimeColumn::FieldArrays simdOut;
+    simdOut.year = simdYear.data();
+    simdOut.day = simdDay.data();
+    DateTimeColumn::extractFields(values.data(), values.size(), std::chrono::seconds(0), scalarOut, DateTimeColumn::Isa::Scalar);
+    DateTimeColumn::extractFields(values.data(), values.size(), std::chrono::seconds(0), simdOut, DateTimeColumn::Isa::Avx2);
+    EXPECT_EQ(simdYear, scalarYear);
+    EXPECT_EQ(simdDay, scalarDay);
+    EXPECT_EQ(scalarYear[500], 1970);
+}
+
+TEST(ColumnTest, ExtractFieldsUsesRowRegions) {
+    const DateTime utc(2024, 3, 1, 20, 0, 0);
+    DateTimeColumn column(std::vector<DateTime>{utc, utc.convertToRegion(DateTime::JapanTime), utc});
+    std::vector<std::int32_t> day(3), hour(3);
+    DateTimeColumn::FieldArrays out;
+    out.day = day.data();
+    out.hour = hour.data();
+    column.extractFields(out);
+    EXPECT_EQ(day, (std::vector<std::int32_t>{1, 2, 1}));
+    EXPECT_EQ(hour, (std::vector<std::int32_t>{20, 5, 20}));
+}
@@ -0,0 +1,67 @@
+#include "datetime.hpp"
+#include <gtest/gtest.h>
+#include <type_traits>
+
+using namespace datetime_literals;
+
+namespace {
+
+// Fixed timestamps folded at compile time
+constexpr DateTime unixEpoch(1970, 1, 1);
+constexpr DateTime cutover = 2024_y/3/1;
+constexpr DateTime cutoverNoon = cutover.plusHours(12);
+
+// True when DateTime(Y, M, D) is a valid constant expression
+template <int Y, int M, int D>
+constexpr bool isConstantDate = requires { typename std::integral_constant<bool, (DateTime(Y, M, D), true)>; };
+
+} // namespace
+
+// Compile-time checks
+static_assert(DateTime::isValidDate(2024, 2, 29));
+static_assert(!DateTime::isValidDate(2023, 2, 29));
+static_assert(DateTime::isValidTime(23, 59, 59, 999));
+static_assert(!DateTime::isValidTime(24, 0, 0, 0));
+static_assert(DateTime::daysFromCivil(1970, 1, 1) == 0);
+static_assert(DateTime::daysFromCivil(2000, 3, 1) == 11017);
+static_assert(DateTime::civilFromDays(11017).month == 3);
+static_assert(unixEpoch.getSystemTime().time_since_epoch().count() == 0);
+static_assert(cutover == DateTime(2024, 3, 1));
+static_assert(cutoverNoon > cutover);
+static_assert(DateTime::timeBetween(cutover, cutoverNoon).count() == 12 * 3600);
+static_assert(cutover.plusDays(-1) == DateTime(2024, 2, 29));
+static_assert(DateTime(2023, 12, 31, 23, 59, 59, 999).plusMilliseconds(1) == 2024_y/1/1);
+static_assert(isConstantDate<2024, 2, 29>);
+static_assert(!isConstantDate<2023, 2, 29>);  // Rejected at compile time
+static_assert(!isConstantDate<2023, 13, 1>);
+
+TEST(ConstexprTest, ConstantTimestampsMatchRuntime) {
+    EXPECT_EQ(cutover.getYear(), 2024);
+    EXPECT_EQ(cutover.getMonth(), 3);
+    EXPECT_EQ(cutover.getDay(), 1);
+    EXPECT_EQ(cutoverNoon.getHour(), 12);
+    EXPECT_EQ(cutover.toString(), "2024-03-01 00:00:00");
+    
+    // Same instant as the region constructor in UTC
+    EXPECT_EQ(cutover, DateTime(2024, 3, 1, 0, 0, 0, 0, DateTime::WorldTime));
+}
+
+TEST(ConstexprTest, CivilKernelRoundTrip) {
+    for (std::int64_t days = -800000; days <= 800000; days += 37) {
+        DateTime::CivilDate date = DateTime::civilFromDays(days);
+        ASSERT_EQ(DateTime::daysFromCivil(date.year, date.month, date.day), days);
+    }
+    // Out-of-range months and days are normalized
+    EXPECT_EQ(DateTime::daysFromCivil(2023, 14, 1), DateTime::daysFromCivil(2024, 2, 1));
+    EXPECT_EQ(DateTime::daysFromCivil(2023, 2, 30), DateTime::daysFromCivil(2023, 3, 2));
+    EXPECT_EQ(DateTime::daysInMonth(2024, 2), 29);
+    EXPECT_EQ(DateTime::daysInMonth(2100, 2), 28);
+}
+
+TEST(ConstexprTest, InvalidRuntimeDatesThrow) {
+    int month = 2;
+    int day = 30;
+    EXPECT_THROW(DateTime(2023, month, day), DateTimeException);
+    EXPECT_THROW(DateTime(2023, 1, 1, 24, 0, 0), DateTimeException);
+    EXPECT_THROW(DateTime(2023, 4, 31, 0, 0, 0, 0, DateTime::JapanTime), DateTimeException);
+}
@@ -48,6 +48,36 @@ TEST(DateTimeTest, CurrentTime) {
     EXPECT_EQ(utcToJst.getHour(), jstNow->getHour());
 }
 
+// Value-returning current time from each clock source
+TEST(DateTimeTest, NowClockSources) {
+    using Source = DateTime::ClockSource;
+    for (Source source : {Source::Precise, Source::Coarse, Source::Tsc}) {
+        DateTime reference = DateTime::now();
+        DateTime now = DateTime::now(source);
+        
+        // Coarse clocks lag by up to a scheduler tick; allow generous slack either way
+        auto difference = std::chrono::abs(now.getSystemTime() - reference.getSystemTime());
+        EXPECT_LT(difference, std::chrono::milliseconds(100));
+        EXPECT_EQ(now.getRegion().identifier, "UTC");
+    }
+    
+    // Successive readings do not go backwards
+    DateTime first = DateTime::now(Source::Tsc);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_TRUE(first < DateTime::now(Source::Tsc));
+    
+    // Stays in step with the system clock past a resynchronization
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+    auto drift = std::chrono::abs(DateTime::now(Source::Tsc).getSystemTime() - DateTime::now().getSystemTime());
+    EXPECT_LT(drift, std::chrono::milliseconds(5));
+    
+    // Region variants
+    DateTime jstNow = DateTime::now(DateTime::JapanTime);
+    EXPECT_EQ(jstNow.getRegion().identifier, "JST");
+    DateTime handleNow = DateTime::now(jstNow.getRegionHandle(), Source::Coarse);
+    EXPECT_EQ(handleNow.getRegionHandle(), jstNow.getRegionHandle());
+}
+
 // Date/time setter test
 TEST(DateTimeTest, SetDateTime) {
     DateTime dt;
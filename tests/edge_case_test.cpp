@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 #include <chrono>
 #include <thread>
+#include <ctime>
 
 // Leap year special case tests
 TEST(EdgeCaseTest, LeapYearTests) {
@@ -114,6 +115,29 @@ TEST(EdgeCaseTest, MillisecondEdgeCases) {
     EXPECT_EQ(dt5.getMillisecond(), 500);
 }
 
+// Civil calendar decomposition must match the C library across eras and leap years
+TEST(EdgeCaseTest, CivilDecompositionMatchesGmtime) {
+    // Step by a little over 3 days from 1901 to 2199, crossing many month ends
+    for (std::time_t t = -2145916800; t < 7258118400; t += 3 * 86400 + 3601) {
+        std::tm expected{};
+        gmtime_r(&t, &expected);
+        
+        DateTime dt(std::chrono::system_clock::from_time_t(t));
+        ASSERT_EQ(dt.getYear(), expected.tm_year + 1900) << t;
+        ASSERT_EQ(dt.getMonth(), expected.tm_mon + 1) << t;
+        ASSERT_EQ(dt.getDay(), expected.tm_mday) << t;
+        ASSERT_EQ(dt.getHour(), expected.tm_hour) << t;
+        ASSERT_EQ(dt.getMinute(), expected.tm_min) << t;
+        ASSERT_EQ(dt.getSecond(), expected.tm_sec) << t;
+        ASSERT_EQ(dt.getDayOfWeek(), expected.tm_wday) << t;
+    }
+    
+    // Round trip through the field constructor
+    DateTime before1970(1965, 7, 4, 6, 7, 8);
+    EXPECT_EQ(before1970.toString(), "1965-07-04 06:07:08");
+    EXPECT_EQ(before1970.getDayOfWeek(), 0);  // July 4, 1965 was a Sunday
+}
+
 // // Tests with extremely large or small values
 // TEST(EdgeCaseTest, ExtremeValuesTest) {
 //     // Far future date
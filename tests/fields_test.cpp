@@ -0,0 +1,91 @@
+#include "datetime.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(FieldsTest, SinglePassDecomposition) {
+    DateTime dt(2024, 3, 1, 12, 34, 56, 789);
+    DateTime::Fields f = dt.fields();
+    
+    EXPECT_EQ(f.year, 2024);
+    EXPECT_EQ(f.month, 3);
+    EXPECT_EQ(f.day, 1);
+    EXPECT_EQ(f.hour, 12);
+    EXPECT_EQ(f.minute, 34);
+    EXPECT_EQ(f.second, 56);
+    EXPECT_EQ(f.millisecond, 789);
+    EXPECT_EQ(f.dayOfWeek, 5);   // March 1, 2024 was a Friday
+    EXPECT_EQ(f.dayOfYear, 61);  // 31 + 29 + 1 (leap year)
+}
+
+TEST(FieldsTest, MatchesIndividualGetters) {
+    DateTime dt(2023, 12, 31, 23, 59, 59, 999, DateTime::JapanTime);
+    for (int i = 0; i < 500; ++i) {
+        DateTime shifted = dt.plusMinutes(i * 97);
+        DateTime::Fields f = shifted.fields();
+        EXPECT_EQ(f.year, shifted.getYear());
+        EXPECT_EQ(f.month, shifted.getMonth());
+        EXPECT_EQ(f.day, shifted.getDay());
+        EXPECT_EQ(f.hour, shifted.getHour());
+        EXPECT_EQ(f.minute, shifted.getMinute());
+        EXPECT_EQ(f.second, shifted.getSecond());
+        EXPECT_EQ(f.millisecond, shifted.getMillisecond());
+        EXPECT_EQ(f.dayOfWeek, shifted.getDayOfWeek());
+    }
+}
+
+TEST(FieldsTest, RegionAndDayOfYear) {
+    // UTC 2022-12-31 20:00 is JST 2023-01-01 05:00
+    DateTime utc(2022, 12, 31, 20, 0, 0);
+    DateTime::Fields utcFields = utc.fields();
+    DateTime::Fields jstFields = utc.convertToRegion(DateTime::JapanTime).fields();
+    
+    EXPECT_EQ(utcFields.dayOfYear, 365);
+    EXPECT_EQ(jstFields.year, 2023);
+    EXPECT_EQ(jstFields.dayOfYear, 1);
+    EXPECT_EQ(jstFields.hour, 5);
+}
+
+TEST(FieldsTest, BeforeEpochMilliseconds) {
+    // 1969-12-31 23:59:59.250
+    DateTime dt(std::chrono::system_clock::time_point(std::chrono::milliseconds(-750)));
+    DateTime::Fields f = dt.fields();
+    EXPECT_EQ(f.year, 1969);
+    EXPECT_EQ(f.second, 59);
+    EXPECT_EQ(f.millisecond, 250);
+    EXPECT_EQ(dt.getMillisecond(), 250);
+}
+
+TEST(FieldsTest, CachedDecomposition) {
+    DateTime::setFieldCaching(true);
+    EXPECT_TRUE(DateTime::isFieldCachingEnabled());
+    
+    DateTime a(2023, 6, 15, 10, 20, 30, 100);
+    DateTime b(2023, 6, 15, 10, 20, 30, 900);  // Same second, different millisecond
+    DateTime c(2023, 6, 15, 10, 20, 30, 100, DateTime::JapanTime);
+    
+    EXPECT_EQ(a.getHour(), 10);
+    EXPECT_EQ(a.getMinute(), 20);
+    EXPECT_EQ(b.fields().millisecond, 900);
+    EXPECT_EQ(c.getHour(), 10);
+    EXPECT_EQ(c.convertToRegion(DateTime::WorldTime).getHour(), 1);
+    EXPECT_EQ(a.getDay(), 15);
+    
+    // Each thread keeps its own memo
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < 1000; ++i) {
+                DateTime dt = DateTime(2023, 1, 1).plusHours(t * 1000 + i);
+                DateTime::Fields f = dt.fields();
+                EXPECT_EQ(f.hour, (t * 1000 + i) % 24);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    DateTime::setFieldCaching(false);
+    EXPECT_FALSE(DateTime::isFieldCachingEnabled());
+}
@@ -0,0 +1,216 @@
+#include "datetime.hpp"
+#include <gtest/gtest.h>
+#include <ctime>
+#include <iterator>
+#include <string_view>
+
+namespace {
+
+// Reference rendering through strftime on the same broken-down time
+std::string strftimeReference(const DateTime& dt, const char* format) {
+    const DateTime::Fields fields = dt.fields();
+    std::tm timeStruct{};
+    timeStruct.tm_year = fields.year - 1900;
+    timeStruct.tm_mon = fields.month - 1;
+    timeStruct.tm_mday = fields.day;
+    timeStruct.tm_hour = fields.hour;
+    timeStruct.tm_min = fields.minute;
+    timeStruct.tm_sec = fields.second;
+    timeStruct.tm_wday = fields.dayOfWeek;
+    timeStruct.tm_yday = fields.dayOfYear - 1;
+    char buffer[256];
+    std::size_t length = std::strftime(buffer, sizeof(buffer), format, &timeStruct);
+    return std::string(buffer, length);
+}
+
+// Pattern compiles (strict mode) at compile time
+constexpr bool compilesStrict(std::string_view pattern) {
+    return DateTime::FormatPattern::compile(pattern, [](const DateTime::FormatOp&) {}, true) == nullptr;
+}
+
+static_assert(compilesStrict("%Y-%m-%dT%H:%M:%S.%6f%z"));
+static_assert(compilesStrict("%F %T %r %D %R %%"));
+static_assert(!compilesStrict("%Y-%"));
+static_assert(!compilesStrict("%Q"));
+
+} // namespace
+
+TEST(FormatPatternTest, MatchesStrftime) {
+    const DateTime samples[] = {
+        DateTime(2023, 10, 15, 14, 30, 45),
+        DateTime(1900, 1, 1, 0, 0, 0),
+        DateTime(2024, 2, 29, 12, 0, 1),
+        DateTime(2000, 12, 31, 23, 59, 59),
+        DateTime(1999, 7, 4, 9, 5, 3),
+    };
+    const char* specifiers[] = {
+        "%Y", "%C", "%y", "%m", "%d", "%e", "%H", "%I", "%M", "%S", "%j", "%w", "%u",
+        "%a", "%A", "%b", "%h", "%B", "%p", "%F", "%T", "%R", "%D", "%r", "%%", "%n", "%t",
+        "%c", "%U", "%W", "%G", "%V", "%x", "%X",
+    };
+
+    for (const DateTime& dt : samples) {
+        for (const char* specifier : specifiers) {
+            EXPECT_EQ(dt.toString(DateTime::FormatPattern(specifier)), strftimeReference(dt, specifier))
+                << "specifier " << specifier << " for " << dt.toString();
+        }
+    }
+}
+
+TEST(FormatPatternTest, LiteralsAndFractions) {
+    DateTime dt(2023, 10, 15, 14, 30, 45, std::chrono::nanoseconds(123456789));
+
+    EXPECT_EQ(dt.toString(DateTime::FormatPattern("Date: %Y/%m/%d at %H.%M")), "Date: 2023/10/15 at 14.30");
+    EXPECT_EQ(dt.toString(DateTime::FormatPattern("%S.%f")), "45.123");
+    EXPECT_EQ(dt.toString(DateTime::FormatPattern("%S.%1f|%6f|%9f")), "45.1|123456|123456789");
+    EXPECT_EQ(dt.toString(DateTime::FormatPattern("100%% %Y")), "100% 2023");
+    EXPECT_EQ(dt.toString(DateTime::FormatPattern("no conversions")), "no conversions");
+    EXPECT_EQ(dt.toString(DateTime::FormatPattern("")), "");
+
+    // Lenient mode keeps a trailing '%' as a literal
+    EXPECT_EQ(dt.toString(DateTime::FormatPattern("%H%")), "14%");
+
+    // Adjacent literal characters are coalesced into one operation
+    DateTime::FormatPattern pattern("%Y--%m");
+    ASSERT_EQ(pattern.operations().size(), 3u);
+    EXPECT_EQ(pattern.operations()[1].code, DateTime::FormatOpCode::Literal);
+    EXPECT_EQ(pattern.operations()[1].length, 2);
+}
+
+TEST(FormatPatternTest, FixedLayout) {
+    const DateTime::FormatPattern pattern("%F %T (%C|%y)");
+    EXPECT_EQ(pattern.layout(), "0000-00-00 00:00:00 (00|00)");
+    ASSERT_EQ(pattern.layoutFields().size(), 9u);
+    EXPECT_EQ(pattern.layoutFields()[0].code, DateTime::FormatOpCode::Century);
+    EXPECT_EQ(pattern.layoutFields()[1].position, 2);
+    EXPECT_EQ(DateTime(2023, 10, 5, 4, 3, 2).toString(pattern), "2023-10-05 04:03:02 (20|23)");
+    EXPECT_EQ(DateTime(1999, 7, 4, 9, 5, 3, 0, DateTime::JapanTime).toString(pattern), "1999-07-04 09:05:03 (19|99)");
+
+    // Too small buffers still report an error
+    char buffer[8];
+    EXPECT_EQ(DateTime(2023, 10, 5, 4, 3, 2).formatTo(buffer, buffer + sizeof(buffer), pattern).ec, std::errc::value_too_large);
+
+    // Fractions keep the layout
+    const DateTime::FormatPattern fractions("%T.%3f|%9f|%1f");
+    EXPECT_EQ(fractions.layout(), "00:00:00.000|000000000|0");
+    EXPECT_EQ(fractions.layoutFields().back().width, 1);
+    EXPECT_EQ(DateTime(2023, 10, 5, 4, 3, 2, std::chrono::nanoseconds(123456789)).toString(fractions),
+              "04:03:02.123|123456789|1");
+    EXPECT_EQ(DateTime(2023, 10, 5, 4, 3, 2, std::chrono::nanoseconds(7000)).toString(fractions), "04:03:02.000|000007000|0");
+
+    // Other conversions leave the pattern without a layout
+    EXPECT_TRUE(DateTime::FormatPattern("%T %z").layout().empty());
+    EXPECT_TRUE(DateTime::FormatPattern("%e").layout().empty());
+    EXPECT_TRUE(DateTime::FormatPattern("").layout().empty());
+}
+
+TEST(FormatPatternTest, RegionConversions) {
+    DateTime jst(2023, 10, 15, 21, 0, 0, 0, DateTime::JapanTime);
+    DateTime est(2023, 10, 15, 7, 0, 0, 0, DateTime::EasternTime);
+
+    EXPECT_EQ(jst.toString(DateTime::FormatPattern("%H:%M %Z %z")), "21:00 JST +0900");
+    EXPECT_EQ(est.toString(DateTime::FormatPattern("%H:%M %Z %z")), "07:00 EST -0500");
+    EXPECT_EQ(DateTime(2023, 10, 15, 12, 0, 0).toString("%z"), "+0000");
+
+    // toString(string) goes through the same compiled path
+    EXPECT_EQ(jst.toString("%F %T %Z"), "2023-10-15 21:00:00 JST");
+    EXPECT_EQ(jst.toStringWithRegion("%F %Z"), "2023-10-15 JST");
+    EXPECT_EQ(jst.toStringWithRegion("%F"), "2023-10-15 JST");
+}
+
+TEST(FormatPatternTest, CachedPatternSwitching) {
+    DateTime dt(2023, 10, 15, 14, 30, 45);
+
+    // Alternating formats must not reuse a stale compiled pattern
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(dt.toString("%Y"), "2023");
+        EXPECT_EQ(dt.toString("%H:%M"), "14:30");
+    }
+}
+
+TEST(FormatPatternTest, FormatToBuffer) {
+    DateTime dt(2023, 10, 15, 14, 30, 45, std::chrono::microseconds(123456), DateTime::JapanTime);
+    const DateTime::FormatPattern pattern("%F %T.%6f %Z");
+    char buffer[64];
+
+    auto result = dt.formatTo(buffer, buffer + sizeof(buffer), pattern);
+    ASSERT_EQ(result.ec, std::errc{});
+    EXPECT_EQ(std::string_view(buffer, result.ptr - buffer), "2023-10-15 14:30:45.123456 JST");
+
+    result = dt.formatTo(buffer, buffer + sizeof(buffer), "%Y/%m/%d %z");
+    ASSERT_EQ(result.ec, std::errc{});
+    EXPECT_EQ(std::string_view(buffer, result.ptr - buffer), "2023/10/15 +0900");
+
+    // Too small buffers report an error instead of truncating silently
+    result = dt.formatTo(buffer, buffer + 10, pattern);
+    EXPECT_EQ(result.ec, std::errc::value_too_large);
+    EXPECT_EQ(result.ptr, buffer + 10);
+    result = dt.formatTo(buffer, buffer + 10, "%F %T");
+    EXPECT_EQ(result.ec, std::errc::value_too_large);
+
+    // Exact fit
+    result = dt.formatTo(buffer, buffer + 10, "%F");
+    ASSERT_EQ(result.ec, std::errc{});
+    EXPECT_EQ(result.ptr, buffer + 10);
+
+    // Output iterators
+    std::string text;
+    dt.formatTo(std::back_inserter(text), pattern);
+    EXPECT_EQ(text, dt.toString(pattern));
+    text.clear();
+    dt.formatTo(std::back_inserter(text), std::string_view("%H:%M"));
+    EXPECT_EQ(text, "14:30");
+}
+
+TEST(FormatPatternTest, MaxFormattedSize) {
+    EXPECT_EQ(DateTime::maxFormattedSize("%m-%d %H:%M:%S.%3f"), 18u);
+    EXPECT_GE(DateTime::maxFormattedSize("%Y-%m-%d"), 10u);
+    EXPECT_EQ(DateTime::maxFormattedSize(DateTime::FormatPattern("%F")), DateTime::maxFormattedSize("%F"));
+
+    // %Z is bounded by the longest interned region identifier
+    DateTime::internRegion(DateTime::RegionTime("America/Argentina/Buenos_Aires", -3));
+    EXPECT_GE(DateTime::maxFormattedSize("%Z"), 30u);
+
+    const DateTime samples[] = {
+        DateTime(2023, 9, 13, 14, 30, 45, 0, DateTime::PacificTime),
+        DateTime(1900, 1, 1, 0, 0, 0),
+        DateTime(9999, 12, 31, 23, 59, 59, 999),
+    };
+    const DateTime::FormatPattern pattern("%A %B %e %Y %I:%M:%S %p %j %z %Z %9f %c");
+    for (const DateTime& dt : samples) {
+        EXPECT_LE(dt.toString(pattern).size(), DateTime::maxFormattedSize(pattern));
+    }
+}
+
+TEST(FormatPatternTest, StdFormatter) {
+    DateTime dt(2024, 3, 1, 12, 0, 5, std::chrono::milliseconds(123), DateTime::JapanTime);
+
+    // Specs are checked when the format string is compiled
+    EXPECT_EQ(std::format("{}", dt), "2024-03-01 12:00:05");
+    EXPECT_EQ(std::format("{:%F %T}", dt), "2024-03-01 12:00:05");
+    EXPECT_EQ(std::format("{:%Y-%m-%dT%H:%M:%S.%f%z}", dt), "2024-03-01T12:00:05.123+0900");
+    EXPECT_EQ(std::format("[{:%H:%M}] {:%Z} {}", dt, dt, 42), "[12:00] JST 42");
+    EXPECT_EQ(std::format("{:%c}", dt), dt.toString("%c"));
+
+    // Long patterns are not truncated
+    std::string longPattern;
+    for (int i = 0; i < 10; ++i) {
+        longPattern += "%Y-%m-%d ";
+    }
+    const std::string longResult = std::vformat("{:" + longPattern + "}", std::make_format_args(dt));
+    EXPECT_EQ(longResult, dt.toString(longPattern));
+    EXPECT_GT(longResult.size(), 100u);
+
+    // Runtime format strings report invalid specs
+    EXPECT_THROW(static_cast<void>(std::vformat("{:%Q}", std::make_format_args(dt))), std::format_error);
+    EXPECT_THROW(static_cast<void>(std::vformat("{:%Y%}", std::make_format_args(dt))), std::format_error);
+    EXPECT_THROW(static_cast<void>(std::vformat("{:" + longPattern + longPattern + "}", std::make_format_args(dt))),
+                 std::format_error);
+
+    // formatString goes through the same formatter
+    EXPECT_EQ(dt.formatString("{0:%Y/%m/%d} {0:%3f}"), "2024/03/01 123");
+    EXPECT_EQ(dt.formatString("{:%Z}"), "JST");
+    EXPECT_EQ(dt.formatString("%H:%M"), "12:00");
+    EXPECT_EQ(dt.formatString(""), "2024-03-01 12:00:05");
+    EXPECT_EQ(dt.formatString("{:%Q}").rfind("Format error", 0), 0u);
+}
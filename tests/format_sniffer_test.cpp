@@ -0,0 +1,80 @@
+#include "datetime.hpp"
+#include "datetime_format_sniffer.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using Format = DateTimeFormatSniffer::Format;
+
+TEST(FormatSnifferTest, DetectsCommonFormats) {
+    struct Source {
+        Format format;
+        std::vector<std::string> lines;
+        DateTime first;
+    };
+    const std::vector<Source> sources = {
+        {Format::Iso8601, {"2024-03-01T12:00:00.123+09:00 GET /", "2024-03-01T12:00:01.000+09:00 GET /a",
+                           "2024-03-01T12:00:02.500+09:00 POST /b"}, DateTime(2024, 3, 1, 3, 0, 0, 123)},
+        {Format::Apache, {"01/Mar/2024:12:00:00 +0900] \"GET /\"", "01/Mar/2024:12:00:05 +0900] \"GET /x\"",
+                          "02/Mar/2024:00:00:00 +0900] \"GET /y\""}, DateTime(2024, 3, 1, 3, 0, 0)},
+        {Format::Syslog, {"Mar  1 12:00:00 host sshd[1]: ok", "Mar  1 12:00:07 host cron[2]: run",
+                          "Mar 12 01:02:03 host kernel: x"}, DateTime(2023, 3, 1, 12, 0, 0)},
+        {Format::Rfc1123, {"Fri, 01 Mar 2024 03:00:00 GMT", "Fri, 01 Mar 2024 03:00:01 GMT",
+                           "Sat, 02 Mar 2024 03:00:01 GMT"}, DateTime(2024, 3, 1, 3, 0, 0)},
+        {Format::EpochSeconds, {"1709262000 event=a", "1709262001 event=b", "1709262002 event=c"},
+         DateTime(2024, 3, 1, 3, 0, 0)},
+        {Format::EpochMilliseconds, {"1709262000123,a", "1709262000456,b", "1709262001000,c"},
+         DateTime(2024, 3, 1, 3, 0, 0, 123)},
+    };
+
+    for (const Source& source : sources) {
+        DateTimeFormatSniffer sniffer(3, 2023);
+        auto first = sniffer.parse(source.lines[0]);
+        ASSERT_TRUE(first) << source.lines[0];
+        EXPECT_EQ(first.value, source.first) << source.lines[0];
+        for (std::size_t i = 1; i < source.lines.size(); ++i) {
+            EXPECT_TRUE(sniffer.parse(source.lines[i])) << source.lines[i];
+        }
+        EXPECT_EQ(sniffer.format(), source.format) << DateTimeFormatSniffer::formatName(source.format);
+        EXPECT_EQ(sniffer.statistics().detections, 1u);
+
+        // Locked: further lines are hits
+        EXPECT_TRUE(sniffer.parse(source.lines[1]));
+        EXPECT_EQ(sniffer.statistics().hits, 1u);
+        EXPECT_EQ(sniffer.statistics().misses, 0u);
+    }
+}
+
+TEST(FormatSnifferTest, RedetectsAfterMiss) {
+    DateTimeFormatSniffer sniffer(1);
+    EXPECT_TRUE(sniffer.parse("2024-03-01 12:00:00 start"));
+    EXPECT_EQ(sniffer.format(), Format::Iso8601);
+
+    // Source switches format: one miss, then detection locks the new format
+    auto result = sniffer.parse("1709262000 switched");
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.position, 10u);
+    EXPECT_EQ(sniffer.format(), Format::EpochSeconds);
+    EXPECT_EQ(sniffer.statistics().misses, 1u);
+    EXPECT_EQ(sniffer.statistics().detections, 2u);
+
+    // Lines nobody understands are counted as failures
+    EXPECT_FALSE(sniffer.parse("garbage"));
+    EXPECT_EQ(sniffer.statistics().failures, 1u);
+    EXPECT_EQ(sniffer.statistics().misses, 2u);
+    EXPECT_EQ(sniffer.format(), Format::Unknown);
+
+    sniffer.reset();
+    EXPECT_EQ(sniffer.statistics().misses, 0u);
+}
+
+TEST(FormatSnifferTest, CustomPatterns) {
+    DateTimeFormatSniffer sniffer(2);
+    sniffer.addPattern("%d.%m.%Y %H:%M");
+    EXPECT_TRUE(sniffer.parse("01.03.2024 12:30 msg"));
+    auto result = sniffer.parse("02.03.2024 08:15 msg");
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.value, DateTime(2024, 3, 2, 8, 15, 0));
+    EXPECT_EQ(sniffer.format(), Format::Custom);
+    EXPECT_EQ(sniffer.customPatternIndex(), 0u);
+}
@@ -0,0 +1,107 @@
+#include "datetime.hpp"
+#include "datetime_batch.hpp"
+#include "datetime_parallel.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(ParallelTest, EveryRowRunsExactlyOnce) {
+    for (std::size_t threads : {1u, 2u, 4u, 7u}) {
+        DateTimeParallelExecutor executor(threads, 100);
+        EXPECT_EQ(executor.threadCount(), threads);
+        for (std::size_t rows : {0u, 1u, 99u, 100u, 12345u}) {
+            std::vector<std::atomic<int>> visits(rows);
+            executor.forEachChunk(rows, [&](std::size_t begin, std::size_t end, std::size_t chunk,
+                                            DateTimeParallelExecutor::Scratch&) {
+                EXPECT_EQ(begin, chunk * 100);
+                EXPECT_LE(end - begin, 100u);
+                for (std::size_t i = begin; i < end; ++i) {
+                    visits[i].fetch_add(1);
+                }
+            });
+            for (std::size_t i = 0; i < rows; ++i) {
+                ASSERT_EQ(visits[i].load(), 1) << "row " << i << " threads " << threads;
+            }
+        }
+    }
+}
+
+TEST(ParallelTest, ExceptionsPropagate) {
+    DateTimeParallelExecutor executor(4, 10);
+    EXPECT_THROW(executor.forEachChunk(1000, [](std::size_t begin, std::size_t, std::size_t,
+                                                DateTimeParallelExecutor::Scratch&) {
+        if (begin == 500) {
+            throw std::runtime_error("chunk failed");
+        }
+    }), std::runtime_error);
+
+    // The executor stays usable
+    std::atomic<std::size_t> total{0};
+    executor.forEachChunk(1000, [&](std::size_t begin, std::size_t end, std::size_t, DateTimeParallelExecutor::Scratch&) {
+        total += end - begin;
+    });
+    EXPECT_EQ(total.load(), 1000u);
+}
+
+TEST(ParallelTest, BulkOperationsMatchSerial) {
+    const std::size_t rows = 5000;
+    std::vector<DateTime> values;
+    std::string column;
+    DateTime dt(1999, 12, 31, 23, 0, 0);
+    for (std::size_t i = 0; i < rows; ++i) {
+        values.push_back(dt.plusMilliseconds(static_cast<int>(i * 7654321)));
+        column += values.back().toString("%Y-%m-%d %H:%M:%S.%3f");
+    }
+    column[23 * 1234 + 5] = 'x';   // One malformed row
+    std::vector<std::int64_t> epoch(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        epoch[i] = values[i].getTimePoint<std::chrono::milliseconds>().time_since_epoch().count();
+    }
+
+    // Serial references
+    std::vector<std::int64_t> expectedParsed(rows);
+    std::vector<std::size_t> expectedMalformed;
+    DateTimeBatchParser::parse(column.data(), rows, 23, DateTimeBatchParser::Layout::Milliseconds, expectedParsed.data(),
+                               &expectedMalformed);
+    DateTimeBatchFormatter formatter("%d %B %Y %H:%M:%S %Z");
+    const DateTime::RegionHandle jst = DateTime::internRegion(DateTime::JapanTime);
+    std::vector<DateTime> converted(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        converted[i] = values[i].convertToRegion(jst);
+    }
+    formatter.format(converted);
+    std::vector<std::int32_t> expectedDay(rows);
+    DateTimeColumn::FieldArrays expectedOut;
+    expectedOut.day = expectedDay.data();
+    DateTimeColumn::extractFields(epoch.data(), rows, std::chrono::hours(9), expectedOut);
+
+    for (std::size_t threads : {1u, 3u, 8u}) {
+        DateTimeParallelExecutor executor(threads, 256);
+
+        std::vector<std::int64_t> parsed(rows);
+        std::vector<std::size_t> malformed;
+        EXPECT_EQ(executor.parse(column.data(), rows, 23, DateTimeBatchParser::Layout::Milliseconds, parsed.data(), &malformed), 1u);
+        EXPECT_EQ(parsed, expectedParsed);
+        EXPECT_EQ(malformed, expectedMalformed);
+
+        std::vector<DateTime> regionValues(rows);
+        executor.convertToRegion(values, jst, regionValues.data());
+        EXPECT_EQ(regionValues, converted);
+        EXPECT_EQ(regionValues[17].getRegionHandle(), jst);
+
+        std::string arena;
+        std::vector<std::int64_t> offsets;
+        executor.format(regionValues, formatter.pattern(), arena, offsets);
+        EXPECT_EQ(arena, formatter.arena());
+        EXPECT_EQ(offsets, formatter.offsets());
+
+        std::vector<std::int32_t> day(rows);
+        DateTimeColumn::FieldArrays out;
+        out.day = day.data();
+        executor.extractFields(epoch.data(), rows, std::chrono::hours(9), out);
+        EXPECT_EQ(day, expectedDay);
+    }
+}
@@ -0,0 +1,140 @@
+#include "datetime.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+TEST(ParseTest, CompiledPattern) {
+    const DateTime::ParsePattern pattern("%Y-%m-%d %H:%M:%S.%f %z");
+
+    auto result = DateTime::parse("2024-03-01 12:00:00.25 +09:00", pattern);
+    ASSERT_TRUE(result) << DateTime::parseErrorMessage(result.error);
+    EXPECT_EQ(result.value, DateTime(2024, 3, 1, 3, 0, 0, 250));
+    EXPECT_EQ(result.position, 29u);
+
+    // Names, 12-hour clock and whitespace runs
+    const DateTime::ParsePattern named("%a, %d %b %Y %I:%M %p");
+    result = DateTime::parse("tue,  05   MARCH 2024 07:15 pm", named);
+    ASSERT_TRUE(result) << DateTime::parseErrorMessage(result.error);
+    EXPECT_EQ(result.value, DateTime(2024, 3, 5, 19, 15, 0));
+
+    // Two-digit years and day of year
+    result = DateTime::parse("24/061", DateTime::ParsePattern("%y/%j"));
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.value, DateTime(2024, 3, 1));
+
+    // Unsupported conversions are rejected when the pattern is compiled
+    EXPECT_THROW(DateTime::ParsePattern("%Y %Z"), DateTimeException);
+    EXPECT_THROW(DateTime::ParsePattern("%c"), DateTimeException);
+    EXPECT_THROW(DateTime::ParsePattern("%Q"), DateTimeException);
+}
+
+TEST(ParseTest, ErrorPositionAndReason) {
+    const DateTime::ParsePattern pattern("%Y-%m-%d %H:%M:%S");
+
+    auto result = DateTime::parse("2024-03-01 1x:00:00", pattern);
+    EXPECT_FALSE(result);
+    EXPECT_EQ(result.error, DateTime::ParseError::ExpectedLiteral);
+    EXPECT_EQ(result.position, 12u);
+
+    result = DateTime::parse("2024-13-01 10:00:00", pattern);
+    EXPECT_EQ(result.error, DateTime::ParseError::FieldOutOfRange);
+    EXPECT_EQ(result.position, 5u);
+
+    result = DateTime::parse("2023-02-29 10:00:00", pattern);
+    EXPECT_EQ(result.error, DateTime::ParseError::InvalidDate);
+    EXPECT_EQ(result.position, 8u);
+
+    result = DateTime::parse("2024-03-01 10:00", pattern);
+    EXPECT_EQ(result.error, DateTime::ParseError::UnexpectedEnd);
+    EXPECT_EQ(result.position, 16u);
+
+    result = DateTime::parse("2024-03-01 10:00:00 extra", pattern);
+    EXPECT_EQ(result.error, DateTime::ParseError::TrailingCharacters);
+    EXPECT_EQ(result.position, 19u);
+
+    result = DateTime::parse("2024-03-01 10:00:00", DateTime::ParsePattern("%Y-%b-%d"));
+    EXPECT_EQ(result.error, DateTime::ParseError::UnknownName);
+    EXPECT_EQ(result.position, 5u);
+
+    result = DateTime::parse("2024-03-xx", DateTime::ParsePattern("%Y-%m-%d"));
+    EXPECT_EQ(result.error, DateTime::ParseError::ExpectedDigit);
+    EXPECT_EQ(result.position, 8u);
+
+    EXPECT_STREQ(DateTime::parseErrorMessage(DateTime::ParseError::InvalidDate), "date does not exist");
+}
+
+TEST(ParseTest, Iso8601FastPath) {
+    auto result = DateTime::parseIso8601("2024-03-01T12:00:00.123+09:00");
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.value, DateTime(2024, 3, 1, 3, 0, 0, 123));
+
+    result = DateTime::parseIso8601("2024-03-01T03:00:00.123456789123Z");
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.value.getNanosecond(), 123456789);
+
+    result = DateTime::parseIso8601("2024-03-01 03:00:00-0530");
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.value, DateTime(2024, 3, 1, 8, 30, 0));
+
+    result = DateTime::parseIso8601("20240301T030000,5Z");
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.value, DateTime(2024, 3, 1, 3, 0, 0, 500));
+
+    result = DateTime::parseIso8601("2024-03-01");
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.value, DateTime(2024, 3, 1));
+
+    // Round trip through the emitters
+    DateTime jst(2024, 12, 31, 23, 59, 59, 999, DateTime::JapanTime);
+    result = DateTime::parseIso8601(jst.toRfc3339(3));
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.value, jst);
+    result = DateTime::parseIso8601(jst.toIso8601({true, 9, true}));
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.value, jst);
+
+    // Failures
+    result = DateTime::parseIso8601("2024-03-01T12:00:00+9");
+    EXPECT_EQ(result.error, DateTime::ParseError::UnexpectedEnd);
+    result = DateTime::parseIso8601("2024-03-01T24:00:00Z");
+    EXPECT_EQ(result.error, DateTime::ParseError::FieldOutOfRange);
+    EXPECT_EQ(result.position, 11u);
+    result = DateTime::parseIso8601("2024-03-01X12:00:00");
+    EXPECT_EQ(result.error, DateTime::ParseError::TrailingCharacters);
+    EXPECT_EQ(result.position, 10u);
+    result = DateTime::parseIso8601("2024-02-30");
+    EXPECT_EQ(result.error, DateTime::ParseError::InvalidDate);
+    result = DateTime::parseIso8601("2024-03-01T12:00:00.Z");
+    EXPECT_EQ(result.error, DateTime::ParseError::ExpectedDigit);
+    EXPECT_EQ(result.position, 20u);
+}
+
+TEST(ParseTest, LegacyParseKeepsBehavior) {
+    // Text after the pattern is still ignored by the std::string overload
+    auto dt = DateTime::parse("2023-10-15 14:30:45.123");
+    ASSERT_TRUE(dt.has_value());
+    EXPECT_EQ(*dt, DateTime(2023, 10, 15, 14, 30, 45));
+
+    // Unsupported patterns fail without throwing
+    EXPECT_FALSE(DateTime::parse("2023", "%Z").has_value());
+    EXPECT_TRUE(DateTime::parse("2023-10-15", "%F").has_value());
+}
+
+TEST(ParseTest, PrefixMode) {
+    // Prefix mode stops after the timestamp and reports where it ended
+    const DateTime::ParsePattern pattern("%Y-%m-%d %H:%M:%S");
+    auto result = DateTime::parse("2024-03-01 12:00:00 GET /index.html", pattern, DateTime::ParseMode::Prefix);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.value, DateTime(2024, 3, 1, 12, 0, 0));
+    EXPECT_EQ(result.position, 19u);
+    EXPECT_FALSE(DateTime::parse("2024-03-01 12:00:00 GET", pattern));
+
+    result = DateTime::parseIso8601("2024-03-01T12:00:00Z level=info", DateTime::ParseMode::Prefix);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.position, 20u);
+    result = DateTime::parseIso8601("2024-03-01 message", DateTime::ParseMode::Prefix);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.value, DateTime(2024, 3, 1, 0, 0, 0));
+    EXPECT_EQ(result.position, 10u);
+}
@@ -1,7 +1,24 @@
 #include "datetime.hpp"
+#include "datetime_ticker.hpp"
+#include "datetime_streaming_formatter.hpp"
+#include "datetime_batch.hpp"
+#include "datetime_format_sniffer.hpp"
+#include "datetime_column.hpp"
+#include "datetime_parallel.hpp"
+#include "datetime_posix_rule.hpp"
+#include "datetime_zone.hpp"
+#include "datetime_zone_registry.hpp"
 #include <gtest/gtest.h>
 #include <chrono>
 #include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <mutex>
 
 // Helper class for timing performance tests
 class Timer {
@@ -17,6 +34,26 @@ private:
     std::chrono::time_point<std::chrono::high_resolution_clock> start;
 };
 
+// Speedups are only asserted with optimization (Release builds define NDEBUG); other builds just report
+#ifdef NDEBUG
+constexpr bool optimizedBuild = true;
+#else
+constexpr bool optimizedBuild = false;
+#endif
+
+// Fastest of several runs of body in milliseconds. A stall (preemption, another process) slows single
+// runs by up to 2x here, which would otherwise decide a relative assertion.
+template <class Body>
+double fastestMilliseconds(int runs, Body&& body) {
+    double fastest = std::numeric_limits<double>::max();
+    for (int run = 0; run < runs; ++run) {
+        Timer timer;
+        body();
+        fastest = std::min(fastest, timer.elapsedMilliseconds());
+    }
+    return fastest;
+}
+
 // Performance test for mass datetime operations
 TEST(PerformanceTest, MassDateTimeOperations) {
     constexpr int iterations = 10000;
@@ -82,6 +119,66 @@ TEST(PerformanceTest, CurrentTimePerformance) {
     EXPECT_LT(totalTime / iterations, 5.0);
 }
 
+// Performance test for value-returning current time from each clock source
+TEST(PerformanceTest, NowClockSourcePerformance) {
+    constexpr int iterations = 1000000;
+    using Source = DateTime::ClockSource;
+    long long checksum = 0;
+    
+    Timer sharedTimer;
+    for (int i = 0; i < iterations / 10; ++i) {
+        checksum += DateTime::current()->getSystemTime().time_since_epoch().count() & 1;
+    }
+    double sharedTime = sharedTimer.elapsedMilliseconds() * 10;
+    std::cout << "current() (shared_ptr): " << (sharedTime * 1e6 / iterations) << "ns per call" << std::endl;
+    
+    DateTime::now(Source::Tsc);  // Calibrate outside the timed loop
+    const std::pair<Source, const char*> sources[] = {
+        {Source::Precise, "Precise"}, {Source::Coarse, "Coarse"}, {Source::Tsc, "Tsc"}};
+    for (const auto& [source, name] : sources) {
+        Timer timer;
+        for (int i = 0; i < iterations; ++i) {
+            checksum += DateTime::now(source).getSystemTime().time_since_epoch().count() & 1;
+        }
+        double elapsed = timer.elapsedMilliseconds();
+        std::cout << "now(" << name << "): " << (elapsed * 1e6 / iterations) << "ns per call" << std::endl;
+        
+        // Less than 1 microsecond per timestamp
+        EXPECT_LT(elapsed / iterations, 0.001);
+    }
+    EXPECT_GE(checksum, 0);
+}
+
+// Performance test for cached timestamps published by the background ticker
+TEST(PerformanceTest, TickerSnapshotPerformance) {
+    constexpr int iterations = 1000000;
+    DateTimeTicker ticker(std::chrono::milliseconds(100));
+    auto id = ticker.addFormat("%Y-%m-%d %H:%M:%S");
+    ticker.start();
+    
+    std::size_t totalLength = 0;
+    char buffer[64];
+    const double elapsed = fastestMilliseconds(3, [&]() {
+        for (int i = 0; i < iterations; ++i) {
+            totalLength += static_cast<std::size_t>(ticker.text(id, buffer, buffer + sizeof(buffer)).ptr - buffer);
+        }
+    });
+    
+    const double formatElapsed = fastestMilliseconds(3, [&]() {
+        for (int i = 0; i < iterations / 10; ++i) {
+            totalLength += DateTime::current()->toString().size();
+        }
+    }) * 10;
+    
+    std::cout << "Ticker text read: " << (elapsed * 1e6 / iterations) << "ns per call" << std::endl;
+    std::cout << "current()->toString(): " << (formatElapsed * 1e6 / iterations) << "ns per call" << std::endl;
+    
+    EXPECT_GT(totalLength, 0u);
+    if (optimizedBuild) {
+        EXPECT_LT(elapsed * 5, formatElapsed);  // Copying the cached text is well over 5x cheaper than formatting
+    }
+}
+
 // Performance test for millisecond operations
 TEST(PerformanceTest, MillisecondOperations) {
     constexpr int iterations = 10000;
@@ -109,3 +206,728 @@ TEST(PerformanceTest, MillisecondOperations) {
     EXPECT_LT(msCreateTime / iterations, 1.0);  // Less than 1ms per object
     EXPECT_LT(msOpTime / iterations, 0.1);      // Less than 0.1ms per operation
 }
+
+// Contention benchmark: date field getters from an increasing number of threads
+TEST(PerformanceTest, GetterContentionScaling) {
+    constexpr int iterations = 200000;
+    const int maxThreads = std::max(4, static_cast<int>(std::thread::hardware_concurrency()));
+    
+    double singleThreadRate = 0.0;
+    for (int threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+        std::atomic<long long> checksum(0);
+        std::vector<std::thread> threads;
+        
+        Timer timer;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([t, &checksum]() {
+                DateTime dt(2023, 1, 1, 12, 0, 0, 0, DateTime::JapanTime);
+                long long localSum = 0;
+                for (int i = 0; i < iterations; ++i) {
+                    DateTime shifted = dt.plusSeconds(i + t);
+                    localSum += shifted.getYear() + shifted.getMonth() + shifted.getDay() +
+                                shifted.getHour() + shifted.getMinute() + shifted.getSecond() +
+                                shifted.getDayOfWeek();
+                }
+                checksum += localSum;
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        double elapsed = timer.elapsedMilliseconds();
+        
+        // Getter calls per millisecond across all threads
+        double rate = (7.0 * iterations * threadCount) / elapsed;
+        if (threadCount == 1) {
+            singleThreadRate = rate;
+        }
+        std::cout << threadCount << " thread(s): " << (7LL * iterations * threadCount) << " getter calls in "
+                  << elapsed << "ms (" << rate << " calls/ms, speedup x" << (rate / singleThreadRate) << ")" << std::endl;
+        
+        EXPECT_GT(checksum.load(), 0);
+        // Less than 1 microsecond per getter call even under contention
+        EXPECT_LT(elapsed / (7.0 * iterations), 1.0 * threadCount);
+    }
+}
+
+// Performance test for single-pass decomposition versus individual getters
+TEST(PerformanceTest, FieldDecompositionPerformance) {
+    constexpr int iterations = 100000;
+    DateTime dt(2023, 1, 1, 12, 0, 0, 0, DateTime::JapanTime);
+    long long checksum = 0;
+    
+    // Six individual getters per instant
+    Timer getterTimer;
+    for (int i = 0; i < iterations; ++i) {
+        DateTime shifted = dt.plusSeconds(i);
+        checksum += shifted.getYear() + shifted.getMonth() + shifted.getDay() +
+                    shifted.getHour() + shifted.getMinute() + shifted.getSecond();
+    }
+    double getterTime = getterTimer.elapsedMilliseconds();
+    
+    // One fields() call per instant
+    Timer fieldsTimer;
+    for (int i = 0; i < iterations; ++i) {
+        DateTime::Fields f = dt.plusSeconds(i).fields();
+        checksum += f.year + f.month + f.day + f.hour + f.minute + f.second;
+    }
+    double fieldsTime = fieldsTimer.elapsedMilliseconds();
+    
+    // Six getters on the same object with memoization enabled
+    DateTime::setFieldCaching(true);
+    const double cachedTime = fastestMilliseconds(3, [&]() {
+        for (int i = 0; i < iterations; ++i) {
+            DateTime shifted = dt.plusSeconds(i);
+            checksum += shifted.getYear() + shifted.getMonth() + shifted.getDay() +
+                        shifted.getHour() + shifted.getMinute() + shifted.getSecond();
+        }
+    });
+    DateTime::setFieldCaching(false);
+    
+    std::cout << "Six getters x " << iterations << ": " << getterTime << "ms" << std::endl;
+    std::cout << "fields() x " << iterations << ": " << fieldsTime << "ms" << std::endl;
+    std::cout << "Six cached getters x " << iterations << ": " << cachedTime << "ms" << std::endl;
+    
+    EXPECT_GT(checksum, 0);
+    EXPECT_LT(fieldsTime / iterations, 0.1);  // Less than 0.1ms per decomposition
+}
+
+// Performance test for compiled format patterns versus stringstream + put_time
+TEST(PerformanceTest, CompiledFormatPerformance) {
+    constexpr int iterations = 100000;
+    DateTime dt(2023, 1, 1, 12, 0, 0, 0, DateTime::JapanTime);
+    const std::string format = "%Y-%m-%d %H:%M:%S";
+    std::size_t totalLength = 0;
+    
+    // Previous implementation: broken-down time through an ostringstream
+    const double streamTime = fastestMilliseconds(3, [&]() {
+        for (int i = 0; i < iterations; ++i) {
+            std::time_t seconds = std::chrono::system_clock::to_time_t(dt.plusSeconds(i).getSystemTime()) + 9 * 3600;
+            std::tm timeStruct{};
+            gmtime_r(&seconds, &timeStruct);
+            std::stringstream stream;
+            stream << std::put_time(&timeStruct, format.c_str());
+            totalLength += stream.str().size();
+        }
+    });
+    
+    const DateTime::FormatPattern pattern(format);
+    const double compiledTime = fastestMilliseconds(3, [&]() {
+        for (int i = 0; i < iterations; ++i) {
+            totalLength += dt.plusSeconds(i).toString(pattern).size();
+        }
+    });
+    
+    Timer cachedTimer;
+    for (int i = 0; i < iterations; ++i) {
+        totalLength += dt.plusSeconds(i).toString(format).size();
+    }
+    double cachedTime = cachedTimer.elapsedMilliseconds();
+    
+    std::cout << "stringstream + put_time x " << iterations << ": " << streamTime << "ms" << std::endl;
+    std::cout << "toString(FormatPattern) x " << iterations << ": " << compiledTime << "ms" << std::endl;
+    std::cout << "toString(string) x " << iterations << ": " << cachedTime << "ms" << std::endl;
+    std::cout << "Speedup: " << (streamTime / compiledTime) << "x" << std::endl;
+    
+    EXPECT_GT(totalLength, 0u);
+    if (optimizedBuild) {
+        EXPECT_LT(compiledTime * 10, streamTime);  // At least 10x the stringstream + put_time path
+    }
+}
+
+// Performance test for incremental formatting of a monotonically increasing timestamp stream
+TEST(PerformanceTest, StreamingFormatterPerformance) {
+    constexpr int iterations = 1000000;
+    DateTime dt(2023, 1, 1, 12, 0, 0, 0, DateTime::JapanTime);
+    const DateTime::FormatPattern pattern("%Y-%m-%d %H:%M:%S.%3f");
+    std::size_t totalLength = 0;
+    
+    const double fullTime = fastestMilliseconds(3, [&]() {
+        for (int i = 0; i < iterations; ++i) {
+            totalLength += dt.plusMicroseconds(i * 10LL).toString(pattern).size();
+        }
+    });
+    
+    DateTimeStreamingFormatter formatter("%Y-%m-%d %H:%M:%S.%3f");
+    const double streamingTime = fastestMilliseconds(3, [&]() {
+        for (int i = 0; i < iterations; ++i) {
+            totalLength += formatter.format(dt.plusMicroseconds(i * 10LL)).size();
+        }
+    });
+    
+    std::cout << "toString(FormatPattern) x " << iterations << ": " << fullTime << "ms" << std::endl;
+    std::cout << "DateTimeStreamingFormatter x " << iterations << ": " << streamingTime << "ms" << std::endl;
+    
+    EXPECT_GT(totalLength, 0u);
+    if (optimizedBuild) {
+        EXPECT_LT(streamingTime * 1.5, fullTime);  // Reusing the cached prefix must stay well ahead of a full render
+    }
+}
+
+// Performance test for the fixed-layout standard emitters versus the generic pattern path
+TEST(PerformanceTest, StandardFormatPerformance) {
+    constexpr int iterations = 200000;
+    DateTime dt(2024, 3, 1, 12, 0, 0, 123, DateTime::JapanTime);
+    const DateTime::FormatPattern pattern("%Y-%m-%dT%H:%M:%S.%3f%z");
+    char buffer[DateTime::MaxStandardFormatSize];
+    std::size_t totalLength = 0;
+    
+    const double patternTime = fastestMilliseconds(3, [&]() {
+        for (int i = 0; i < iterations; ++i) {
+            totalLength += dt.plusMilliseconds(i).formatTo(buffer, buffer + sizeof(buffer), pattern).ptr - buffer;
+        }
+    });
+    
+    const double rfc3339Time = fastestMilliseconds(3, [&]() {
+        for (int i = 0; i < iterations; ++i) {
+            totalLength += dt.plusMilliseconds(i).formatRfc3339(buffer, buffer + sizeof(buffer), 3).ptr - buffer;
+        }
+    });
+    
+    const double rfc1123Time = fastestMilliseconds(3, [&]() {
+        for (int i = 0; i < iterations; ++i) {
+            totalLength += dt.plusMilliseconds(i).formatRfc1123(buffer, buffer + sizeof(buffer)).ptr - buffer;
+        }
+    });
+    
+    std::cout << "Pattern formatTo x " << iterations << ": " << patternTime << "ms" << std::endl;
+    std::cout << "formatRfc3339 x " << iterations << ": " << rfc3339Time << "ms" << std::endl;
+    std::cout << "formatRfc1123 x " << iterations << ": " << rfc1123Time << "ms" << std::endl;
+    
+    EXPECT_GT(totalLength, 0u);
+    if (optimizedBuild) {
+        // Fixed-layout emitters must keep a clear lead over the generic pattern path
+        EXPECT_LT(rfc3339Time * 1.5, patternTime);
+        EXPECT_LT(rfc1123Time * 1.5, patternTime);
+    }
+}
+
+// Performance test for parsing: istringstream + get_time versus compiled pattern and ISO fast path
+TEST(PerformanceTest, ParsePerformance) {
+    constexpr int iterations = 100000;
+    const std::string input = "2024-03-01 12:34:56";
+    const std::string isoInput = "2024-03-01T12:34:56.789+09:00";
+    long long checksum = 0;
+    
+    // Previous implementation
+    const double streamTime = fastestMilliseconds(3, [&]() {
+        for (int i = 0; i < iterations; ++i) {
+            std::tm timeStruct{};
+            std::istringstream stream(input);
+            stream >> std::get_time(&timeStruct, "%Y-%m-%d %H:%M:%S");
+            checksum += timeStruct.tm_sec;
+        }
+    });
+    
+    const DateTime::ParsePattern pattern("%Y-%m-%d %H:%M:%S");
+    const double patternTime = fastestMilliseconds(3, [&]() {
+        for (int i = 0; i < iterations; ++i) {
+            checksum += DateTime::parse(input, pattern).position;
+        }
+    });
+    
+    const double isoTime = fastestMilliseconds(3, [&]() {
+        for (int i = 0; i < iterations; ++i) {
+            checksum += DateTime::parseIso8601(isoInput).position;
+        }
+    });
+    
+    std::cout << "istringstream + get_time x " << iterations << ": " << streamTime << "ms" << std::endl;
+    std::cout << "parse(ParsePattern) x " << iterations << ": " << patternTime << "ms" << std::endl;
+    std::cout << "parseIso8601 x " << iterations << ": " << isoTime << "ms" << std::endl;
+    
+    EXPECT_GT(checksum, 0);
+    if (optimizedBuild) {
+        // Both are over 10x faster than istringstream + get_time; leave room for noisy machines
+        EXPECT_LT(patternTime * 4, streamTime);
+        EXPECT_LT(isoTime * 4, streamTime);
+    }
+}
+
+// Performance test for batch parsing of a fixed-width timestamp column
+TEST(PerformanceTest, BatchParsePerformance) {
+    constexpr std::size_t rows = 1000000;
+    const std::size_t rowLength = DateTimeBatchParser::rowLength(DateTimeBatchParser::Layout::Milliseconds);
+    std::string column;
+    column.reserve(rows * rowLength);
+    DateTime dt(2024, 1, 1, 0, 0, 0);
+    const DateTime::FormatPattern pattern("%Y-%m-%d %H:%M:%S.%3f");
+    for (std::size_t i = 0; i < rows; ++i) {
+        column += dt.plusMilliseconds(static_cast<long long>(i) * 1237).toString(pattern);
+    }
+    std::vector<std::int64_t> values(rows);
+    
+    // Row-by-row parse with a compiled pattern
+    const DateTime::ParsePattern parsePattern("%Y-%m-%d %H:%M:%S.%3f");
+    const double rowTime = fastestMilliseconds(3, [&]() {
+        for (std::size_t i = 0; i < rows; ++i) {
+            auto result = DateTime::parse(std::string_view(column.data() + i * rowLength, rowLength), parsePattern);
+            values[i] = std::chrono::duration_cast<std::chrono::milliseconds>(result.value.getSystemTime().time_since_epoch()).count();
+        }
+    });
+    std::cout << "parse(ParsePattern) per row x " << rows << ": " << rowTime << "ms" << std::endl;
+    
+    double batchTimes[3] = {};
+    const DateTimeBatchParser::Isa isas[] = {DateTimeBatchParser::Isa::Scalar, DateTimeBatchParser::Isa::Sse42,
+                                             DateTimeBatchParser::Isa::Avx2};
+    const char* names[] = {"scalar", "SSE4.2", "AVX2"};
+    for (int i = 0; i < 3; ++i) {
+        std::size_t malformed = 0;
+        batchTimes[i] = fastestMilliseconds(3, [&]() {
+            malformed = DateTimeBatchParser::parse(column.data(), rows, rowLength, DateTimeBatchParser::Layout::Milliseconds,
+                                                   values.data(), nullptr, isas[i]);
+        });
+        std::cout << "Batch parse (" << names[i] << ") x " << rows << ": " << batchTimes[i] << "ms" << std::endl;
+        EXPECT_EQ(malformed, 0u);
+    }
+    const int supported = static_cast<int>(DateTimeBatchParser::supportedIsa()) - 1;
+    std::cout << "Supported ISA: " << names[supported] << std::endl;
+    
+    if (optimizedBuild) {
+        // The scalar batch is over 3x faster than parsing row by row, the vector paths a little faster still
+        EXPECT_LT(batchTimes[0] * 2, rowTime);
+        if (supported > 0) {
+            const double vectorTime = *std::min_element(batchTimes + 1, batchTimes + 1 + supported);
+            EXPECT_LT(vectorTime * 2.5, rowTime);
+            EXPECT_LT(vectorTime, batchTimes[0] * 1.1);
+        }
+    }
+}
+
+TEST(PerformanceTest, FormatSnifferPerformance) {
+    const int iterations = 100000;
+    std::vector<std::string> lines;
+    lines.reserve(1000);
+    DateTime dt(2024, 3, 1, 0, 0, 0);
+    const DateTime::FormatPattern pattern("%d/%b/%Y:%H:%M:%S +0000] \"GET / HTTP/1.1\" 200");
+    for (int i = 0; i < 1000; ++i) {
+        lines.push_back(dt.plusSeconds(i * 7).toString(pattern));
+    }
+
+    // Naive ingestion: try every known pattern on each line
+    const DateTime::ParsePattern candidates[] = {
+        DateTime::ParsePattern("%Y-%m-%dT%H:%M:%S"), DateTime::ParsePattern("%a, %d %b %Y %H:%M:%S GMT"),
+        DateTime::ParsePattern("%b %e %H:%M:%S"), DateTime::ParsePattern("%d/%b/%Y:%H:%M:%S %z")};
+    constexpr int runs = 3;
+    std::size_t parsed = 0;
+    const double naiveTime = fastestMilliseconds(runs, [&]() {
+        for (int i = 0; i < iterations; ++i) {
+            for (const auto& candidate : candidates) {
+                if (DateTime::parse(lines[i % 1000], candidate, DateTime::ParseMode::Prefix)) {
+                    ++parsed;
+                    break;
+                }
+            }
+        }
+    });
+    std::cout << "Trying " << std::size(candidates) << " patterns per line x " << iterations << ": " << naiveTime << "ms" << std::endl;
+
+    DateTimeFormatSniffer sniffer;
+    const double snifferTime = fastestMilliseconds(runs, [&]() {
+        for (int i = 0; i < iterations; ++i) {
+            if (sniffer.parse(lines[i % 1000])) {
+                ++parsed;
+            }
+        }
+    });
+    std::cout << "DateTimeFormatSniffer x " << iterations << ": " << snifferTime << "ms ("
+              << sniffer.statistics().hits << " hits, " << sniffer.statistics().misses << " misses)" << std::endl;
+
+    EXPECT_EQ(parsed, 2u * runs * iterations);
+    EXPECT_EQ(sniffer.format(), DateTimeFormatSniffer::Format::Apache);
+    if (optimizedBuild) {
+        EXPECT_LT(snifferTime * 2, naiveTime);  // The remembered format skips the failing candidates
+    }
+}
+
+TEST(PerformanceTest, ColumnPerformance) {
+    const std::size_t rows = 4000000;
+    std::vector<DateTime> values;
+    values.reserve(rows);
+    DateTime dt(2024, 1, 1, 0, 0, 0);
+    for (std::size_t i = 0; i < rows; ++i) {
+        values.push_back(dt.plusMilliseconds(static_cast<int>((i * 7919) % 86400000)));
+    }
+    const DateTime from(2024, 1, 1, 6, 0, 0);
+    const DateTime to(2024, 1, 1, 18, 0, 0);
+
+    // Array of DateTime: shift, count a range and find the maximum. Each side keeps the fastest of three
+    // runs (see fastestMilliseconds), undoing the shift outside the timed part.
+    constexpr int runs = 3;
+    double rowTime = std::numeric_limits<double>::max();
+    std::size_t rowMatches = 0;
+    DateTime rowMax = values.front();
+    for (int run = 0; run < runs; ++run) {
+        Timer rowTimer;
+        rowMatches = 0;
+        rowMax = values.front();
+        for (auto& value : values) {
+            value = value.plusHours(1);
+        }
+        for (const auto& value : values) {
+            rowMatches += (value >= from && value < to) ? 1 : 0;
+            rowMax = std::max(rowMax, value);
+        }
+        rowTime = std::min(rowTime, rowTimer.elapsedMilliseconds());
+        for (auto& value : values) {
+            value = value.plusHours(-1);
+        }
+    }
+    std::cout << "std::vector<DateTime> shift/count/max x " << rows << ": " << rowTime << "ms" << std::endl;
+
+    DateTimeColumn column{std::vector<std::int64_t>(rows)};
+    for (std::size_t i = 0; i < rows; ++i) {
+        column.data()[i] = values[i].getTimePoint<std::chrono::milliseconds>().time_since_epoch().count();
+    }
+    const char* names[] = {"scalar", "AVX2"};
+    const DateTimeColumn::Isa isas[] = {DateTimeColumn::Isa::Scalar, DateTimeColumn::Isa::Avx2};
+    double columnTimes[2] = {};
+    for (int i = 0; i < 2; ++i) {
+        column.setIsa(isas[i]);
+        std::size_t matches = 0;
+        DateTime columnMax = values.front();
+        columnTimes[i] = std::numeric_limits<double>::max();
+        for (int run = 0; run < runs; ++run) {
+            Timer columnTimer;
+            column.plusHours(1);
+            matches = column.countInRange(from, to);
+            columnMax = *column.max();
+            columnTimes[i] = std::min(columnTimes[i], columnTimer.elapsedMilliseconds());
+            column.plusHours(-1);
+        }
+        std::cout << "DateTimeColumn (" << names[i] << ") shift/count/max x " << rows << ": " << columnTimes[i] << "ms ("
+                  << rows * 3 / 1000.0 / std::max(columnTimes[i], 0.001) << "M rows/s)" << std::endl;
+        EXPECT_EQ(matches, rowMatches);
+        EXPECT_EQ(columnMax, rowMax);
+    }
+
+    if (optimizedBuild) {
+        // Bound by memory bandwidth: the column reads half the bytes of std::vector<DateTime> per pass
+        // but makes three passes, so the leads are modest (measured 1.3-1.5x scalar, 1.7-1.8x AVX2)
+        EXPECT_LT(columnTimes[0], rowTime);
+        if (DateTimeBatchParser::supportedIsa() == DateTimeColumn::Isa::Avx2) {
+            EXPECT_LT(columnTimes[1] * 1.3, rowTime);
+        }
+    }
+}
+
+TEST(PerformanceTest, FieldExtractionPerformance) {
+    const std::size_t rows = 2000000;
+    std::vector<std::int64_t> values(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        values[i] = 1700000000000LL + static_cast<std::int64_t>(i) * 123457;
+    }
+    const DateTime::RegionHandle jst = DateTime::internRegion(DateTime::JapanTime);
+    std::vector<std::int32_t> year(rows), month(rows), day(rows), hour(rows), weekday(rows);
+
+    // Row by row through DateTime::fields()
+    const double rowTime = fastestMilliseconds(3, [&]() {
+        for (std::size_t i = 0; i < rows; ++i) {
+            const DateTime::Fields fields =
+                DateTime(std::chrono::system_clock::time_point(std::chrono::milliseconds(values[i])), jst).fields();
+            year[i] = fields.year;
+            month[i] = fields.month;
+            day[i] = fields.day;
+            hour[i] = fields.hour;
+            weekday[i] = fields.dayOfWeek;
+        }
+    });
+    std::cout << "DateTime::fields() x " << rows << ": " << rowTime << "ms" << std::endl;
+    const std::vector<std::int32_t> expectedDay = day;
+
+    DateTimeColumn::FieldArrays out;
+    out.year = year.data();
+    out.month = month.data();
+    out.day = day.data();
+    out.hour = hour.data();
+    out.dayOfWeek = weekday.data();
+    const char* names[] = {"scalar", "AVX2"};
+    const DateTimeColumn::Isa isas[] = {DateTimeColumn::Isa::Scalar, DateTimeColumn::Isa::Avx2};
+    double batchTimes[2] = {};
+    for (int i = 0; i < 2; ++i) {
+        std::fill(day.begin(), day.end(), 0);
+        batchTimes[i] = fastestMilliseconds(3, [&]() { DateTimeColumn::extractFields(values.data(), rows, jst, out, isas[i]); });
+        std::cout << "DateTimeColumn::extractFields (" << names[i] << ") x " << rows << ": " << batchTimes[i] << "ms" << std::endl;
+        EXPECT_EQ(day, expectedDay);
+    }
+
+    if (optimizedBuild) {
+        EXPECT_LT(batchTimes[0] * 1.2, rowTime);
+        if (DateTimeBatchParser::supportedIsa() == DateTimeColumn::Isa::Avx2) {
+            EXPECT_LT(batchTimes[1] * 2, batchTimes[0]);  // Four rows per instruction
+        }
+    }
+}
+
+TEST(PerformanceTest, BatchFormatPerformance) {
+    const std::size_t rows = 1000000;
+    std::vector<DateTime> values;
+    values.reserve(rows);
+    DateTime dt(2024, 1, 1, 0, 0, 0);
+    for (std::size_t i = 0; i < rows; ++i) {
+        values.push_back(dt.plusMilliseconds(static_cast<int>(i * 1237)));
+    }
+
+    // One std::string per row
+    const DateTime::FormatPattern pattern("%Y-%m-%d %H:%M:%S.%3f");
+    std::vector<std::string> strings;
+    const double stringTime = fastestMilliseconds(3, [&]() {
+        std::vector<std::string>().swap(strings);
+        strings.reserve(rows);
+        for (const auto& value : values) {
+            strings.push_back(value.toString(pattern));
+        }
+    });
+    std::cout << "toString(FormatPattern) into std::vector<std::string> x " << rows << ": " << stringTime << "ms" << std::endl;
+
+    DateTimeBatchFormatter formatter("%Y-%m-%d %H:%M:%S.%3f");
+    Timer batchTimer;
+    formatter.format(values);
+    double batchTime = batchTimer.elapsedMilliseconds();
+    std::cout << "DateTimeBatchFormatter (first batch) x " << rows << ": " << batchTime << "ms" << std::endl;
+    const double reuseTime = fastestMilliseconds(3, [&]() { formatter.format(values); });
+    std::cout << "DateTimeBatchFormatter (reused arena) x " << rows << ": " << reuseTime << "ms" << std::endl;
+
+    EXPECT_EQ(formatter.arena().size(), rows * 23);
+    EXPECT_EQ(formatter[rows - 1], strings.back());
+    if (optimizedBuild) {
+        // No allocation per row: measured 2x with a reused arena
+        EXPECT_LT(reuseTime * 1.5, stringTime);
+    }
+}
+
+TEST(PerformanceTest, ParallelScalingPerformance) {
+    const std::size_t rows = 2000000;
+    const std::size_t rowLength = DateTimeBatchParser::rowLength(DateTimeBatchParser::Layout::Milliseconds);
+    std::vector<DateTime> values;
+    values.reserve(rows);
+    std::string column;
+    column.reserve(rows * rowLength);
+    DateTime dt(2024, 1, 1, 0, 0, 0);
+    DateTimeBatchFormatter rowFormatter("%Y-%m-%d %H:%M:%S.%3f");
+    for (std::size_t i = 0; i < rows; ++i) {
+        values.push_back(dt.plusMilliseconds(static_cast<int>(i * 1237)));
+    }
+    rowFormatter.format(values);
+    column.assign(rowFormatter.arena());
+
+    const DateTime::FormatPattern pattern("%Y-%m-%d %H:%M:%S.%3f");
+    std::vector<std::int64_t> parsed(rows);
+    std::string arena;
+    std::vector<std::int64_t> offsets;
+    // Up to the hardware concurrency (at least 4, oversubscribed on small machines)
+    const std::size_t maxThreads = std::max(4u, std::thread::hardware_concurrency());
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    double singleTime = 0;
+    for (std::size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        DateTimeParallelExecutor executor(threads);
+        Timer timer;
+        std::size_t malformed = executor.parse(column.data(), rows, rowLength, DateTimeBatchParser::Layout::Milliseconds,
+                                               parsed.data());
+        double parseTime = timer.elapsedMilliseconds();
+        Timer formatTimer;
+        executor.format(values, pattern, arena, offsets);
+        double formatTime = formatTimer.elapsedMilliseconds();
+        if (threads == 1) {
+            singleTime = parseTime + formatTime;
+        }
+        std::cout << threads << " thread(s): parse " << parseTime << "ms, format " << formatTime << "ms (speedup "
+                  << singleTime / std::max(parseTime + formatTime, 0.001) << "x)" << std::endl;
+        EXPECT_EQ(malformed, 0u);
+        EXPECT_EQ(arena, column);
+    }
+}
+
+TEST(PerformanceTest, TruncationPerformance) {
+    const std::size_t rows = 1000000;
+    const DateTime::RegionHandle jst = DateTime::internRegion(DateTime::JapanTime);
+    std::vector<std::int64_t> values(rows);
+    const std::int64_t start = DateTime(2020, 1, 1, 0, 0, 0).getTimePoint<std::chrono::milliseconds>().time_since_epoch().count();
+    for (std::size_t i = 0; i < rows; ++i) {
+        values[i] = start + static_cast<std::int64_t>(i) * 97003;  // ~3 years of events
+    }
+    std::vector<std::int64_t> keys(rows);
+
+    // Per event: decompose, then rebuild the month start in local time
+    const double rowTime = fastestMilliseconds(3, [&]() {
+        for (std::size_t i = 0; i < rows; ++i) {
+            const DateTime event(std::chrono::system_clock::time_point{std::chrono::milliseconds(values[i])}, jst);
+            DateTime bucket(event.getYear(), event.getMonth(), 1, 0, 0, 0, 0, DateTime::JapanTime);
+            keys[i] = bucket.getTimePoint<std::chrono::milliseconds>().time_since_epoch().count();
+        }
+    });
+    std::cout << "Month keys via getYear/getMonth + DateTime x " << rows << ": " << rowTime << "ms" << std::endl;
+    const std::vector<std::int64_t> expected = keys;
+
+    const double monthTime = fastestMilliseconds(3, [&]() {
+        DateTime::floorTo(values.data(), rows, DateTime::TimeUnit::Month, jst, keys.data());
+    });
+    std::cout << "DateTime::floorTo(Month) batch x " << rows << ": " << monthTime << "ms" << std::endl;
+    EXPECT_EQ(keys, expected);
+
+    const double hourTime = fastestMilliseconds(3, [&]() {
+        DateTime::floorTo(values.data(), rows, DateTime::TimeUnit::Hour, jst, keys.data());
+    });
+    std::cout << "DateTime::floorTo(Hour) batch x " << rows << ": " << hourTime << "ms" << std::endl;
+
+    if (optimizedBuild) {
+        // Integer bucketing over the whole array instead of two DateTime objects per row (measured 50-80x)
+        EXPECT_LT(monthTime * 10, rowTime);
+        EXPECT_LT(hourTime * 10, rowTime);
+    }
+}
+
+TEST(PerformanceTest, ZoneLookupPerformance) {
+    std::shared_ptr<const DateTimeZone> zone;
+    try {
+        zone = DateTimeZone::load("America/New_York");
+    } catch (const DateTimeException&) {
+        GTEST_SKIP() << "America/New_York not found in " << DateTimeZone::zoneInfoDirectory();
+    }
+    const std::size_t lookups = 2000000;
+    std::vector<std::int64_t> instants(lookups);
+    std::uint64_t state = 88172645463325252ull;
+    const std::int64_t from = DateTime(1970, 1, 1, 0, 0, 0).getTimePoint<std::chrono::seconds>().time_since_epoch().count();
+    const std::int64_t span = DateTime(2100, 1, 1, 0, 0, 0).getTimePoint<std::chrono::seconds>().time_since_epoch().count() - from;
+    for (std::int64_t& instant : instants) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        instant = from + static_cast<std::int64_t>(state % static_cast<std::uint64_t>(span));
+    }
+
+    std::int64_t searchSum = 0;
+    const double searchTime = fastestMilliseconds(3, [&]() {
+        for (std::int64_t instant : instants) {
+            searchSum += zone->searchOffsetAt(instant);
+        }
+    });
+    std::cout << "Binary search offsetAt x " << lookups << " (" << zone->transitionCount() << " transitions): "
+              << searchTime << "ms" << std::endl;
+
+    std::int64_t indexSum = 0;
+    const double indexTime = fastestMilliseconds(3, [&]() {
+        for (std::int64_t instant : instants) {
+            indexSum += zone->offsetAt(instant);
+        }
+    });
+    std::cout << "Indexed offsetAt x " << lookups << " (" << zone->indexBucketCount() << " buckets): " << indexTime << "ms"
+              << std::endl;
+
+    const DateTime::RegionHandle region = DateTime::internRegion(*DateTime::getRegionFromTZDB("America/New_York"));
+    int hourSum = 0;
+    Timer getterTimer;
+    for (std::size_t i = 0; i < lookups; i += 4) {
+        hourSum += DateTime(std::chrono::system_clock::time_point(std::chrono::seconds(instants[i])), region).getHour();
+    }
+    double getterTime = getterTimer.elapsedMilliseconds();
+    std::cout << "getHour() in America/New_York x " << lookups / 4 << ": " << getterTime << "ms" << std::endl;
+
+    EXPECT_EQ(indexSum, searchSum);
+    EXPECT_GT(hourSum, 0);
+    if (optimizedBuild) {
+        EXPECT_LT(indexTime * 5, searchTime);  // One bucket probe instead of a binary search (measured ~20x)
+    }
+}
+
+TEST(PerformanceTest, PosixRulePerformance) {
+    DateTimePosixRule rule("EST5EDT,M3.2.0,M11.1.0");
+    const std::size_t lookups = 2000000;
+    const std::int64_t from = DateTime(2150, 1, 1, 0, 0, 0).getTimePoint<std::chrono::seconds>().time_since_epoch().count();
+    const std::int64_t year = 365 * 86400;
+
+    // Consecutive instants stay within a year, so the transitions come from the cache
+    std::int64_t cachedSum = 0;
+    const double cachedTime = fastestMilliseconds(3, [&]() {
+        for (std::size_t i = 0; i < lookups; ++i) {
+            cachedSum += rule.offsetAt(from + static_cast<std::int64_t>(i) * 15);
+        }
+    });
+    std::cout << "POSIX rule offsetAt x " << lookups << " (cached years): " << cachedTime << "ms" << std::endl;
+
+    // Years 16 apart share a cache slot, so alternating between them recomputes every time
+    std::int64_t missSum = 0;
+    const double missTime = fastestMilliseconds(3, [&]() {
+        for (std::size_t i = 0; i < lookups; ++i) {
+            missSum += rule.offsetAt(from + static_cast<std::int64_t>(i) * 15 + static_cast<std::int64_t>(i % 2) * 16 * year);
+        }
+    });
+    std::cout << "POSIX rule offsetAt x " << lookups << " (recomputed years): " << missTime << "ms" << std::endl;
+
+    EXPECT_NE(cachedSum, 0);
+    EXPECT_NE(missSum, 0);
+    if (optimizedBuild) {
+        // A cache hit skips the rule evaluation; measured ~3x faster than recomputing
+        EXPECT_LT(cachedTime * 2, missTime);
+    }
+}
+
+// Contention benchmark: zone lookups by name from several threads, registry versus a mutex-guarded map
+TEST(PerformanceTest, ZoneRegistryContention) {
+    DateTimeZoneRegistry& registry = DateTimeZoneRegistry::instance();
+    std::vector<std::string> names;
+    for (const char* name : {"America/New_York", "America/Chicago", "America/Denver", "America/Los_Angeles",
+                             "Europe/London", "Europe/Paris", "Europe/Berlin", "Asia/Tokyo", "Asia/Kolkata",
+                             "Australia/Sydney", "America/Sao_Paulo", "Africa/Cairo"}) {
+        if (registry.find(name) != nullptr) {
+            names.emplace_back(name);
+        }
+    }
+    if (names.empty()) {
+        GTEST_SKIP() << "No IANA zones found in " << DateTimeZone::zoneInfoDirectory();
+    }
+    std::mutex mapMutex;
+    std::map<std::string, std::shared_ptr<const DateTimeZone>, std::less<>> map;
+    for (const std::string& name : names) {
+        map.emplace(name, registry.get(name));
+    }
+
+    constexpr int iterations = 200000;
+    const int maxThreads = std::max(4, static_cast<int>(std::thread::hardware_concurrency()));
+    for (int threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+        auto run = [&](auto lookup) {
+            std::atomic<long long> checksum(0);
+            const double elapsed = fastestMilliseconds(3, [&]() {
+                std::vector<std::thread> threads;
+                for (int t = 0; t < threadCount; ++t) {
+                    threads.emplace_back([&, t]() {
+                        long long localSum = 0;
+                        for (int i = 0; i < iterations; ++i) {
+                            localSum += lookup(names[(i + t) % names.size()])->standardOffset() != 0;
+                        }
+                        checksum += localSum;
+                    });
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+            });
+            EXPECT_GE(checksum.load(), 0);
+            return elapsed;
+        };
+        const double mutexTime = run([&](const std::string& name) {
+            std::lock_guard<std::mutex> lock(mapMutex);
+            return map.find(name)->second.get();
+        });
+        const double registryTime = run([&](const std::string& name) { return registry.find(name); });
+
+        // Reloads running alongside the readers
+        std::atomic<bool> reloading(true);
+        std::thread reloader([&]() {
+            while (reloading.load()) {
+                registry.reload();
+            }
+        });
+        const double reloadTime = run([&](const std::string& name) { return registry.find(name); });
+        reloading.store(false);
+        reloader.join();
+
+        const double lookups = static_cast<double>(iterations) * threadCount;
+        std::cout << threadCount << " thread(s): mutex map " << (mutexTime * 1e6 / lookups) << "ns, registry "
+                  << (registryTime * 1e6 / lookups) << "ns, registry during reloads " << (reloadTime * 1e6 / lookups)
+                  << "ns per lookup" << std::endl;
+        if (optimizedBuild) {
+            EXPECT_LT(registryTime * 1.5, mutexTime);  // Lock-free reads stay well ahead of a mutex-guarded map
+        }
+    }
+}
@@ -0,0 +1,138 @@
+#include "datetime.hpp"
+#include "datetime_posix_rule.hpp"
+#include "datetime_zone.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace {
+
+std::int64_t epochSeconds(const DateTime& dt) {
+    return dt.getTimePoint<std::chrono::seconds>().time_since_epoch().count();
+}
+
+} // namespace
+
+TEST(PosixRuleTest, UnitedStatesRules) {
+    DateTimePosixRule rule("EST5EDT,M3.2.0,M11.1.0");
+    EXPECT_EQ(rule.standardName(), "EST");
+    EXPECT_EQ(rule.dstName(), "EDT");
+    EXPECT_EQ(rule.standardOffset(), -5 * 3600);
+    EXPECT_EQ(rule.dstOffset(), -4 * 3600);
+
+    // 02:00 EST on March 10 and 02:00 EDT on November 3
+    const DateTimePosixRule::YearTransitions transitions = rule.transitionsFor(2024);
+    EXPECT_EQ(transitions.dstStart, epochSeconds(DateTime(2024, 3, 10, 7, 0, 0)));
+    EXPECT_EQ(transitions.dstEnd, epochSeconds(DateTime(2024, 11, 3, 6, 0, 0)));
+    EXPECT_FALSE(rule.isDstAt(transitions.dstStart - 1));
+    EXPECT_TRUE(rule.isDstAt(transitions.dstStart));
+    EXPECT_TRUE(rule.isDstAt(transitions.dstEnd - 1));
+    EXPECT_FALSE(rule.isDstAt(transitions.dstEnd));
+
+    // Cached and uncached years agree, also after another year evicts the slot
+    for (std::int64_t year : {2024, 2040, 2024, 1900, 2300, 100000}) {
+        const DateTimePosixRule::YearTransitions first = rule.transitionsFor(year);
+        const DateTimePosixRule::YearTransitions second = rule.transitionsFor(year);
+        EXPECT_EQ(first.dstStart, second.dstStart) << year;
+        EXPECT_EQ(first.dstEnd, second.dstEnd) << year;
+    }
+    EXPECT_EQ(rule.transitionsFor(2040).dstStart, epochSeconds(DateTime(2040, 3, 11, 7, 0, 0)));
+
+    // Skipped local times read with the offset before the gap, repeated ones take the earlier instant
+    EXPECT_EQ(rule.offsetForLocal(epochSeconds(DateTime(2024, 3, 10, 2, 30, 0))), -5 * 3600);
+    EXPECT_EQ(rule.offsetForLocal(epochSeconds(DateTime(2024, 11, 3, 1, 30, 0))), -4 * 3600);
+    EXPECT_EQ(rule.offsetForLocal(epochSeconds(DateTime(2024, 7, 1, 12, 0, 0))), -4 * 3600);
+}
+
+TEST(PosixRuleTest, SouthernHemisphereAndDateForms) {
+    // DST from the first Sunday of October to 03:00 on the first Sunday of April
+    DateTimePosixRule sydney("AEST-10AEDT,M10.1.0,M4.1.0/3");
+    EXPECT_EQ(sydney.standardOffset(), 10 * 3600);
+    EXPECT_EQ(sydney.dstOffset(), 11 * 3600);
+    EXPECT_EQ(sydney.offsetAt(epochSeconds(DateTime(2024, 1, 15, 0, 0, 0))), 11 * 3600);
+    EXPECT_EQ(sydney.offsetAt(epochSeconds(DateTime(2024, 7, 15, 0, 0, 0))), 10 * 3600);
+    EXPECT_EQ(sydney.transitionsFor(2024).dstEnd, epochSeconds(DateTime(2024, 4, 6, 16, 0, 0)));
+    EXPECT_EQ(sydney.transitionsFor(2024).dstStart, epochSeconds(DateTime(2024, 10, 5, 16, 0, 0)));
+
+    // Jn never counts February 29, n does; M.5 is the last occurrence
+    DateTimePosixRule julian("AAA0BBB,J60/0,300/0");
+    EXPECT_EQ(julian.transitionsFor(2024).dstStart, epochSeconds(DateTime(2024, 3, 1, 0, 0, 0)));
+    EXPECT_EQ(julian.transitionsFor(2023).dstStart, epochSeconds(DateTime(2023, 3, 1, 0, 0, 0)));
+    EXPECT_EQ(julian.transitionsFor(2024).dstEnd, epochSeconds(DateTime(2024, 10, 26, 23, 0, 0)));
+    DateTimePosixRule europe("CET-1CEST,M3.5.0,M10.5.0/3");
+    EXPECT_EQ(europe.transitionsFor(2024).dstStart, epochSeconds(DateTime(2024, 3, 31, 1, 0, 0)));
+    EXPECT_EQ(europe.transitionsFor(2024).dstEnd, epochSeconds(DateTime(2024, 10, 27, 1, 0, 0)));
+
+    // Extended transition times and permanent DST
+    DateTimePosixRule greenland("<-02>2<-01>,M3.5.0/-1,M10.5.0/0");
+    EXPECT_EQ(greenland.standardName(), "-02");
+    EXPECT_EQ(greenland.transitionsFor(2024).dstStart, epochSeconds(DateTime(2024, 3, 31, 1, 0, 0)));
+    DateTimePosixRule permanent("EST5EDT,0/0,J365/25");
+    EXPECT_EQ(permanent.offsetAt(epochSeconds(DateTime(2024, 1, 1, 0, 0, 0))), -4 * 3600);
+    EXPECT_EQ(permanent.offsetAt(epochSeconds(DateTime(2024, 12, 31, 23, 0, 0))), -4 * 3600);
+}
+
+TEST(PosixRuleTest, StandardOnlyAndInvalidRules) {
+    DateTimePosixRule tehran("<+0330>-3:30");
+    EXPECT_FALSE(tehran.hasDst());
+    EXPECT_EQ(tehran.standardName(), "+0330");
+    EXPECT_EQ(tehran.offsetAt(0), 3 * 3600 + 30 * 60);
+    EXPECT_EQ(DateTimePosixRule("UTC0").offsetAt(epochSeconds(DateTime(2024, 7, 1, 0, 0, 0))), 0);
+    // A DST name without dates uses the US rules
+    EXPECT_EQ(DateTimePosixRule("PST8PDT").transitionsFor(2024).dstStart, epochSeconds(DateTime(2024, 3, 10, 10, 0, 0)));
+
+    for (const char* invalid : {"", "EST", "ES5", "EST5EDT,M13.1.0,M11.1.0", "EST5EDT,M3.6.0,M11.1.0",
+                                "EST5EDT,M3.2.7,M11.1.0", "EST5EDT,J0,J365", "EST5EDT,M3.2.0", "<+03-3", "EST5EDT,M3.2.0/168,M11.1.0",
+                                "EST5 EDT"}) {
+        EXPECT_THROW(DateTimePosixRule rule(invalid), DateTimeException) << invalid;
+    }
+}
+
+TEST(PosixRuleTest, ZonesFollowFooterAfterLastTransition) {
+    std::shared_ptr<const DateTimeZone> zone;
+    try {
+        zone = DateTimeZone::load("America/New_York");
+    } catch (const DateTimeException&) {
+        GTEST_SKIP() << "America/New_York not found in " << DateTimeZone::zoneInfoDirectory();
+    }
+    ASSERT_NE(zone->rule(), nullptr);
+    const std::int64_t july2050 = epochSeconds(DateTime(2050, 7, 1, 12, 0, 0));
+    EXPECT_EQ(zone->offsetAt(july2050), -4 * 3600);
+    EXPECT_EQ(zone->searchOffsetAt(july2050), -4 * 3600);
+    EXPECT_EQ(zone->localTypeAt(july2050).abbreviation, "EDT");
+    EXPECT_EQ(zone->offsetAt(epochSeconds(DateTime(2050, 1, 1, 12, 0, 0))), -5 * 3600);
+    EXPECT_EQ(zone->offsetAt(epochSeconds(DateTime(2150, 7, 1, 12, 0, 0))), -4 * 3600);
+    for (std::int64_t time = epochSeconds(DateTime(2030, 1, 1, 0, 0, 0)); time < epochSeconds(DateTime(2110, 1, 1, 0, 0, 0)); time += 86413) {
+        ASSERT_EQ(zone->offsetAt(time), zone->searchOffsetAt(time)) << time;
+    }
+
+    auto region = DateTime::getRegionFromTZDB("America/New_York");
+    ASSERT_TRUE(region.has_value());
+    DateTime summer(2050, 7, 4, 12, 0, 0, 0, *region);
+    EXPECT_EQ(summer, DateTime(2050, 7, 4, 16, 0, 0));
+    EXPECT_EQ(summer.getUtcOffset(), std::chrono::hours(-4));
+}
+
+TEST(PosixRuleTest, ZonesFromRuleStrings) {
+    auto zone = DateTimeZone::fromPosixRule("CET-1CEST,M3.5.0,M10.5.0/3");
+    EXPECT_EQ(zone->transitionCount(), 0u);
+    EXPECT_EQ(zone->footer(), "CET-1CEST,M3.5.0,M10.5.0/3");
+    EXPECT_EQ(zone->standardOffset(), 3600);
+    EXPECT_EQ(zone->offsetAt(epochSeconds(DateTime(2024, 7, 1, 0, 0, 0))), 7200);
+    EXPECT_EQ(zone->offsetAt(epochSeconds(DateTime(1950, 7, 1, 0, 0, 0))), 7200);
+    EXPECT_EQ(zone->localTypeAt(epochSeconds(DateTime(2024, 1, 1, 0, 0, 0))).abbreviation, "CET");
+    EXPECT_THROW(DateTimeZone::fromPosixRule("not a rule"), DateTimeException);
+
+    // Not a zone name but a valid rule: usable as a region
+    auto region = DateTime::getRegionFromTZDB("<+0330>-3:30");
+    ASSERT_TRUE(region.has_value());
+    EXPECT_EQ(region->hourOffset, 3);
+    EXPECT_EQ(region->minuteOffset, 30);
+    EXPECT_EQ(DateTime(2024, 1, 1, 12, 0, 0, 0, *region), DateTime(2024, 1, 1, 8, 30, 0));
+    auto sydney = DateTime::getRegionFromTZDB("AEST-10AEDT,M10.1.0,M4.1.0/3");
+    ASSERT_TRUE(sydney.has_value());
+    EXPECT_EQ(DateTime(2024, 1, 15, 12, 0, 0, 0, *sydney).getUtcOffset(), std::chrono::hours(11));
+    EXPECT_FALSE(DateTime::getRegionFromTZDB("Not/AZone").has_value());
+}
@@ -0,0 +1,80 @@
+#include "datetime.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+TEST(PrecisionTest, SubMillisecondConstruction) {
+    DateTime dt(2024, 1, 2, 3, 4, 5, std::chrono::microseconds(123456));
+    EXPECT_EQ(dt.getMillisecond(), 123);
+    EXPECT_EQ(dt.getMicrosecond(), 123456);
+    EXPECT_EQ(dt.getNanosecond(), 123456000);
+    EXPECT_EQ(dt.getFraction<std::chrono::microseconds>(), 123456us);
+    EXPECT_EQ(dt.fields().nanosecond, 123456000);
+    
+    DateTime ns(2024, 1, 2, 3, 4, 5, 987654321ns, DateTime::JapanTime);
+    EXPECT_EQ(ns.getNanosecond(), 987654321);
+    EXPECT_EQ(ns.getHour(), 3);
+    EXPECT_EQ(ns.convertToRegion(DateTime::WorldTime).getNanosecond(), 987654321);
+    
+    // Millisecond constructor and fraction constructor agree
+    EXPECT_EQ(DateTime(2024, 1, 2, 3, 4, 5, 250), DateTime(2024, 1, 2, 3, 4, 5, 250ms));
+    EXPECT_THROW(DateTime(2024, 1, 2, 3, 4, 5, 1s), DateTimeException);
+    EXPECT_THROW(DateTime(2024, 1, 2, 3, 4, 5, -1ns), DateTimeException);
+}
+
+TEST(PrecisionTest, SubMillisecondArithmetic) {
+    constexpr DateTime base(2024, 1, 1, 0, 0, 0);
+    static_assert(base.plusNanoseconds(1) > base);
+    static_assert(base.plus(1500us) == base.plusMicroseconds(1500));
+    
+    DateTime dt = base.plusMicroseconds(1500);
+    EXPECT_EQ(dt.getMillisecond(), 1);
+    EXPECT_EQ(dt.getMicrosecond(), 1500);
+    
+    DateTime before = base.plusNanoseconds(-1);
+    EXPECT_EQ(before.getYear(), 2023);
+    EXPECT_EQ(before.getSecond(), 59);
+    EXPECT_EQ(before.getNanosecond(), 999999999);
+    
+    EXPECT_EQ(dt.getTimePoint<std::chrono::milliseconds>().time_since_epoch(),
+              std::chrono::floor<std::chrono::milliseconds>(dt.getSystemTime().time_since_epoch()));
+}
+
+TEST(PrecisionTest, SetTimeWithFraction) {
+    DateTime dt(2024, 6, 1, 0, 0, 0, 0, DateTime::EasternTime);
+    dt.setTime(10, 20, 30, 5us);
+    EXPECT_EQ(dt.getHour(), 10);
+    EXPECT_EQ(dt.getSecond(), 30);
+    EXPECT_EQ(dt.getMicrosecond(), 5);
+    EXPECT_THROW(dt.setTime(10, 20, 30, 2s), DateTimeException);
+}
+
+TEST(PrecisionTest, FractionFormatting) {
+    DateTime dt(2024, 3, 1, 12, 0, 0, 7654321ns);
+    EXPECT_EQ(dt.toString("%H:%M:%S.%f"), "12:00:00.007");
+    EXPECT_EQ(dt.toString("%H:%M:%S.%6f"), "12:00:00.007654");
+    EXPECT_EQ(dt.toString("%H:%M:%S.%9f"), "12:00:00.007654321");
+    EXPECT_EQ(dt.toString("%S.%1f"), "00.0");
+    EXPECT_EQ(dt.toString("100%%f"), "100%f");
+    EXPECT_EQ(dt.toStringWithRegion("%H:%M:%S.%6f %Z"), "12:00:00.007654 UTC");
+}
+
+TEST(PrecisionTest, FractionParsing) {
+    auto dt = DateTime::parse("2024-03-01 12:00:00.123456789", "%Y-%m-%d %H:%M:%S.%f");
+    ASSERT_TRUE(dt.has_value());
+    EXPECT_EQ(dt->getSecond(), 0);
+    EXPECT_EQ(dt->getNanosecond(), 123456789);
+    
+    auto ms = DateTime::parse("2024-03-01 12:00:00.5", "%Y-%m-%d %H:%M:%S.%f");
+    ASSERT_TRUE(ms.has_value());
+    EXPECT_EQ(ms->getMillisecond(), 500);
+    
+    auto micro = DateTime::parse("2024-03-01T12:00:00.000042Z", "%Y-%m-%dT%H:%M:%S.%6fZ");
+    ASSERT_TRUE(micro.has_value());
+    EXPECT_EQ(micro->getMicrosecond(), 42);
+    
+    // %Nf requires exactly N digits
+    EXPECT_FALSE(DateTime::parse("2024-03-01 12:00:00.12", "%Y-%m-%d %H:%M:%S.%3f").has_value());
+    EXPECT_FALSE(DateTime::parse("2024-03-01 12:00:00.", "%Y-%m-%d %H:%M:%S.%f").has_value());
+}
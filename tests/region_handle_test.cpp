@@ -0,0 +1,96 @@
+#include "datetime.hpp"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+TEST(RegionHandleTest, CompactValueType) {
+    EXPECT_TRUE(std::is_trivially_copyable_v<DateTime>);
+    EXPECT_EQ(sizeof(DateTime), 16u);
+}
+
+TEST(RegionHandleTest, BuiltInRegions) {
+    EXPECT_EQ(DateTime::internRegion(DateTime::WorldTime), DateTime::RegionHandle::World);
+    EXPECT_EQ(DateTime().getRegionHandle(), DateTime::RegionHandle::World);
+    
+    DateTime::RegionHandle jst = DateTime::internRegion(DateTime::JapanTime);
+    EXPECT_EQ(DateTime::regionFromHandle(jst).identifier, "JST");
+    EXPECT_EQ(DateTime::regionFromHandle(jst).hourOffset, 9);
+    
+    // Equal contents intern to the same handle
+    EXPECT_EQ(DateTime::internRegion(DateTime::RegionTime("JST", 9)), jst);
+    EXPECT_NE(DateTime::internRegion(DateTime::RegionTime("JST", 8)), jst);
+}
+
+TEST(RegionHandleTest, CustomRegionRoundTrip) {
+    DateTime::RegionTime india("IST", 5, 30);
+    DateTime dt(2023, 5, 1, 12, 0, 0, 0, india);
+    
+    EXPECT_EQ(dt.getRegion().identifier, "IST");
+    EXPECT_EQ(dt.getRegion().minuteOffset, 30);
+    EXPECT_EQ(dt.getHour(), 12);
+    EXPECT_EQ(dt.convertToRegion(DateTime::WorldTime).getHour(), 6);
+    EXPECT_EQ(dt.convertToRegion(DateTime::WorldTime).getMinute(), 30);
+    
+    // Arithmetic and conversion by handle keep the region
+    DateTime later = dt.plusHours(1);
+    EXPECT_EQ(later.getRegionHandle(), dt.getRegionHandle());
+    EXPECT_EQ(later.getRegion().identifier, "IST");
+    DateTime back = dt.convertToRegion(DateTime::RegionHandle::World).convertToRegion(dt.getRegionHandle());
+    EXPECT_EQ(back.getHour(), 12);
+    
+    EXPECT_THROW(DateTime::regionFromHandle(static_cast<DateTime::RegionHandle>(1u << 30)), DateTimeException);
+}
+
+TEST(RegionHandleTest, MemcpyBulkStorage) {
+    std::vector<DateTime> source;
+    for (int i = 0; i < 100; ++i) {
+        source.emplace_back(2023, 1, 1, i % 24, 0, 0, 0, i % 2 ? DateTime::JapanTime : DateTime::EasternTime);
+    }
+    
+    std::vector<DateTime> copy(source.size(), DateTime(std::chrono::system_clock::time_point{}));
+    std::memcpy(static_cast<void*>(copy.data()), source.data(), source.size() * sizeof(DateTime));
+    
+    for (std::size_t i = 0; i < source.size(); ++i) {
+        EXPECT_EQ(copy[i], source[i]);
+        EXPECT_EQ(copy[i].getHour(), source[i].getHour());
+        EXPECT_EQ(copy[i].getRegion().identifier, source[i].getRegion().identifier);
+    }
+}
+
+TEST(RegionHandleTest, ConcurrentInterning) {
+    std::vector<std::thread> threads;
+    std::vector<DateTime::RegionHandle> handles(8);
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([t, &handles]() {
+            // All threads race to register the same new regions
+            for (int i = 0; i < 50; ++i) {
+                DateTime::internRegion(DateTime::RegionTime("RACE" + std::to_string(i), i % 12));
+            }
+            handles[t] = DateTime::internRegion(DateTime::RegionTime("RACE7", 7));
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int t = 1; t < 8; ++t) {
+        EXPECT_EQ(handles[t], handles[0]);
+    }
+    EXPECT_EQ(DateTime::regionFromHandle(handles[0]).identifier, "RACE7");
+}
+
+TEST(RegionHandleTest, GrowsPastTheLockFreeIndex) {
+    // Far more distinct regions than the lock-free index holds: none of them may fail
+    const auto epoch = std::chrono::system_clock::time_point{};
+    std::vector<DateTime::RegionHandle> handles;
+    for (int i = 0; i < 10000; ++i) {
+        DateTime dt(epoch + std::chrono::hours(i), DateTime::RegionTime("zone-" + std::to_string(i), i % 24 - 12));
+        handles.push_back(dt.getRegionHandle());
+        EXPECT_EQ(dt.getHour(), (i + i % 24 - 12 + 24) % 24);
+    }
+    for (int i = 0; i < 10000; i += 997) {
+        EXPECT_EQ(DateTime::regionFromHandle(handles[i]).identifier, "zone-" + std::to_string(i));
+        EXPECT_EQ(DateTime::internRegion(DateTime::RegionTime("zone-" + std::to_string(i), i % 24 - 12)), handles[i]);
+    }
+}
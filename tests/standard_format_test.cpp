@@ -0,0 +1,49 @@
+#include "datetime.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+
+TEST(StandardFormatTest, Iso8601) {
+    DateTime jst(2024, 3, 1, 12, 0, 0, std::chrono::nanoseconds(123456789), DateTime::JapanTime);
+    DateTime utc(2024, 3, 1, 3, 4, 5, 7);
+
+    EXPECT_EQ(jst.toIso8601(), "2024-03-01T12:00:00+09:00");
+    EXPECT_EQ(jst.toIso8601({false, 3, true}), "2024-03-01T12:00:00.123+09:00");
+    EXPECT_EQ(jst.toIso8601({true, 6, true}), "20240301T120000.123456+0900");
+    EXPECT_EQ(jst.toIso8601({false, 9, true}), "2024-03-01T12:00:00.123456789+09:00");
+    EXPECT_EQ(utc.toIso8601(), "2024-03-01T03:04:05Z");
+    EXPECT_EQ(utc.toIso8601({false, 3, false}), "2024-03-01T03:04:05.007+00:00");
+    EXPECT_EQ(utc.convertToRegion(DateTime::PacificTime).toIso8601({true, 0, true}), "20240229T190405-0800");
+
+    // Unpadded millisecond bug of the hand-written version does not recur
+    EXPECT_EQ(DateTime(2024, 1, 1, 0, 0, 0, 5).toRfc3339(3), "2024-01-01T00:00:00.005Z");
+
+    EXPECT_THROW(jst.toIso8601({false, 10, true}), DateTimeException);
+}
+
+TEST(StandardFormatTest, Rfc3339AndRfc1123) {
+    DateTime est(2023, 11, 5, 8, 9, 10, 250, DateTime::EasternTime);
+
+    EXPECT_EQ(est.toRfc3339(), "2023-11-05T08:09:10-05:00");
+    EXPECT_EQ(est.toRfc3339(2), "2023-11-05T08:09:10.25-05:00");
+    EXPECT_EQ(est.toRfc1123(), "Sun, 05 Nov 2023 08:09:10 -0500");
+    EXPECT_EQ(est.convertToRegion(DateTime::WorldTime).toRfc1123(), "Sun, 05 Nov 2023 13:09:10 GMT");
+
+    // Matches the generic pattern path
+    EXPECT_EQ(est.toRfc1123(), est.toString("%a, %d %b %Y %H:%M:%S %z"));
+}
+
+TEST(StandardFormatTest, CallerBuffers) {
+    DateTime dt(2024, 3, 1, 12, 0, 0, 123, DateTime::JapanTime);
+    char buffer[DateTime::MaxStandardFormatSize];
+
+    auto result = dt.formatRfc3339(buffer, buffer + sizeof(buffer), 3);
+    ASSERT_EQ(result.ec, std::errc{});
+    EXPECT_EQ(std::string_view(buffer, result.ptr - buffer), "2024-03-01T12:00:00.123+09:00");
+
+    result = dt.formatIso8601(buffer, buffer + 10);
+    EXPECT_EQ(result.ec, std::errc::value_too_large);
+    result = dt.formatRfc1123(buffer, buffer + 5);
+    EXPECT_EQ(result.ec, std::errc::value_too_large);
+    result = dt.formatIso8601(buffer, buffer + sizeof(buffer), {false, -1, true});
+    EXPECT_EQ(result.ec, std::errc::invalid_argument);
+}
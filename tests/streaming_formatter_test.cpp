@@ -0,0 +1,47 @@
+#include "datetime.hpp"
+#include "datetime_streaming_formatter.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+
+using namespace std::chrono_literals;
+
+TEST(StreamingFormatterTest, MatchesToStringForIncreasingStream) {
+    const char* patterns[] = {
+        "%Y-%m-%d %H:%M:%S",
+        "%Y-%m-%dT%H:%M:%S.%6f%z [%Z]",
+        "%a %b %e %I:%M:%S %p %j",
+        "%c.%3f",
+        "%H%M%S%9f",
+    };
+    for (const char* pattern : patterns) {
+        DateTimeStreamingFormatter formatter(pattern);
+        const DateTime::FormatPattern compiled(pattern);
+        // Steps cross second, minute, hour, day, month and year boundaries
+        DateTime dt(2023, 12, 31, 22, 58, 58, 0, DateTime::JapanTime);
+        const std::chrono::nanoseconds steps[] = {0ns, 1ms, 999ms, 250us, 1s, 59s, 1min, 7ns, 1h, 30min, 1s};
+        for (int round = 0; round < 3; ++round) {
+            for (std::chrono::nanoseconds step : steps) {
+                dt = dt.plus(step);
+                EXPECT_EQ(formatter.format(dt), dt.toString(compiled)) << pattern;
+            }
+        }
+    }
+}
+
+TEST(StreamingFormatterTest, HandlesJumpsAndRegionChanges) {
+    DateTimeStreamingFormatter formatter("%F %T.%3f %Z %z");
+    DateTime utc(2024, 6, 1, 12, 0, 0, 500);
+
+    EXPECT_EQ(formatter.format(utc), "2024-06-01 12:00:00.500 UTC +0000");
+    // Same instant in another region
+    EXPECT_EQ(formatter.format(utc.convertToRegion(DateTime::EasternTime)), "2024-06-01 07:00:00.500 EST -0500");
+    // Backwards in time and before the epoch
+    EXPECT_EQ(formatter.format(utc.plusSeconds(-1)), "2024-06-01 11:59:59.500 UTC +0000");
+    DateTime early(1900, 1, 1, 0, 0, 0, 1);
+    EXPECT_EQ(formatter.format(early), "1900-01-01 00:00:00.001 UTC +0000");
+    EXPECT_EQ(formatter.format(early.plusMilliseconds(-2)), early.plusMilliseconds(-2).toString("%F %T.%3f %Z %z"));
+    // Repeated instant returns the same text
+    EXPECT_EQ(formatter.format(early), "1900-01-01 00:00:00.001 UTC +0000");
+    EXPECT_EQ(formatter.format(early), "1900-01-01 00:00:00.001 UTC +0000");
+}
@@ -0,0 +1,121 @@
+#include "datetime_ticker.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <string>
+
+namespace {
+
+// Latest text of a format, or an empty string if it cannot be read
+std::string readText(const DateTimeTicker& ticker, DateTimeTicker::FormatId id, DateTimeTicker::Tick* tick = nullptr) {
+    std::vector<char> buffer(ticker.maxTextSize(id));
+    auto result = ticker.text(id, buffer.data(), buffer.data() + buffer.size(), tick);
+    return result.ec == std::errc{} ? std::string(buffer.data(), result.ptr) : std::string();
+}
+
+} // namespace
+
+TEST(TickerTest, PublishesRegisteredFormats) {
+    DateTimeTicker ticker(std::chrono::milliseconds(10));
+    auto utcId = ticker.addFormat("%Y-%m-%d %H:%M:%S");
+    auto jstId = ticker.addFormat("%H:%M %Z", DateTime::JapanTime);
+    ticker.start();
+    EXPECT_TRUE(ticker.isRunning());
+    
+    DateTimeTicker::Tick tick{};
+    const std::string utcText = readText(ticker, utcId, &tick);
+    EXPECT_GT(tick.sequence, 0u);
+    EXPECT_EQ(utcText, tick.time.toString("%Y-%m-%d %H:%M:%S"));
+    const std::string jstText = readText(ticker, jstId, &tick);
+    EXPECT_EQ(jstText, tick.time.convertToRegion(DateTime::JapanTime).toString("%H:%M") + " JST");
+    
+    // Unknown formats and short buffers are reported, not truncated
+    char small[4];
+    EXPECT_EQ(ticker.text(99, small, small + sizeof(small)).ec, std::errc::invalid_argument);
+    EXPECT_EQ(ticker.maxTextSize(99), 0u);
+    EXPECT_EQ(ticker.text(utcId, small, small + sizeof(small)).ec, std::errc::value_too_large);
+    
+    // Cached time stays close to the real clock and advances with ticks
+    auto difference = std::chrono::abs(ticker.now().getSystemTime() - DateTime::now().getSystemTime());
+    EXPECT_LT(difference, std::chrono::milliseconds(500));
+    std::uint64_t firstSequence = ticker.tick().sequence;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_GT(ticker.tick().sequence, firstSequence);
+    
+    ticker.stop();
+    EXPECT_FALSE(ticker.isRunning());
+}
+
+TEST(TickerTest, FormatAddedWhileRunning) {
+    DateTimeTicker ticker(std::chrono::milliseconds(5));
+    EXPECT_EQ(ticker.tick().sequence, 0u);
+    ticker.start();
+    auto id = ticker.addFormat("%Y");
+    EXPECT_EQ(readText(ticker, id), std::to_string(ticker.now().getYear()));
+}
+
+TEST(TickerTest, ConcurrentReaders) {
+    DateTimeTicker ticker(std::chrono::milliseconds(1));
+    auto id = ticker.addFormat("%Y-%m-%d %H:%M:%S.%f");
+    ticker.start();
+    
+    std::atomic<int> failures(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&]() {
+            char buffer[64];
+            for (int i = 0; i < 20000; ++i) {
+                auto result = ticker.text(id, buffer, buffer + sizeof(buffer));
+                if (result.ec != std::errc{} || result.ptr - buffer != 23) {
+                    failures++;
+                }
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(failures, 0);
+}
+
+TEST(TickerTest, ReadsMatchTheirPublication) {
+    DateTimeTicker ticker(std::chrono::milliseconds(1));
+    const std::string pattern = "%Y-%m-%d %H:%M:%S.%f";
+    auto id = ticker.addFormat(pattern);
+    ticker.start();
+    
+    // Readers keep going while every addFormat and tick overwrites ring slots
+    std::atomic<bool> done(false);
+    std::atomic<int> mismatches(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 2; ++t) {
+        readers.emplace_back([&]() {
+            std::uint64_t lastSequence = 0;
+            while (!done.load()) {
+                DateTimeTicker::Tick tick{};
+                const std::string text = readText(ticker, id, &tick);
+                if (text != tick.time.toString(pattern) || tick.sequence < lastSequence) {
+                    mismatches++;
+                }
+                lastSequence = tick.sequence;
+            }
+        });
+    }
+    for (int i = 0; i < 100; ++i) {
+        ticker.addFormat("%H:%M:%S");
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    done.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(mismatches, 0);
+    EXPECT_GT(ticker.tick().sequence, 100u);
+    
+    // The number of formats is bounded
+    for (std::size_t i = 101; i < DateTimeTicker::dt_maxFormats; ++i) {
+        ticker.addFormat("%S");
+    }
+    EXPECT_THROW(ticker.addFormat("%S"), DateTimeException);
+}
@@ -0,0 +1,193 @@
+#include "datetime.hpp"
+#include "datetime_column.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using Unit = DateTime::TimeUnit;
+
+const Unit allUnits[] = {Unit::Millisecond, Unit::Second, Unit::Minute, Unit::Hour, Unit::Day,
+                         Unit::Week,        Unit::Month,  Unit::Quarter, Unit::Year};
+
+std::int64_t epochMs(const DateTime& dt) {
+    return std::chrono::floor<std::chrono::milliseconds>(dt.getTimePoint<std::chrono::nanoseconds>()).time_since_epoch().count();
+}
+
+// Reference floor from the civil fields, independent of the batch kernels
+std::int64_t referenceFloor(std::int64_t ms, Unit unit, std::int64_t offsetMs) {
+    const std::int64_t msPerDay = 86400000;
+    const std::int64_t local = ms + offsetMs;
+    std::int64_t days = local / msPerDay - (local % msPerDay < 0 ? 1 : 0);
+    const std::int64_t dayMs = local - days * msPerDay;
+    auto fixed = [&](std::int64_t size) { return local - (dayMs % size) - offsetMs; };
+    switch (unit) {
+        case Unit::Millisecond: return ms;
+        case Unit::Second: return fixed(1000);
+        case Unit::Minute: return fixed(60000);
+        case Unit::Hour: return fixed(3600000);
+        case Unit::Day: return days * msPerDay - offsetMs;
+        case Unit::Week: {
+            // 1970-01-01 was a Thursday (Monday = 0 -> offset 3)
+            const std::int64_t weekday = ((days + 3) % 7 + 7) % 7;
+            return (days - weekday) * msPerDay - offsetMs;
+        }
+        default: break;
+    }
+    const DateTime::CivilDate civil = DateTime::civilFromDays(days);
+    int month = civil.month;
+    if (unit == Unit::Quarter) {
+        month = (month - 1) / 3 * 3 + 1;
+    } else if (unit == Unit::Year) {
+        month = 1;
+    }
+    return DateTime::daysFromCivil(civil.year, month, 1) * msPerDay - offsetMs;
+}
+
+} // namespace
+
+TEST(TruncationTest, FloorInUtc) {
+    DateTime dt(2024, 8, 14, 17, 42, 35, 250);  // Wednesday
+    EXPECT_EQ(dt.floorTo(Unit::Millisecond), dt);
+    EXPECT_EQ(dt.floorTo(Unit::Second), DateTime(2024, 8, 14, 17, 42, 35));
+    EXPECT_EQ(dt.floorTo(Unit::Minute), DateTime(2024, 8, 14, 17, 42, 0));
+    EXPECT_EQ(dt.floorTo(Unit::Hour), DateTime(2024, 8, 14, 17, 0, 0));
+    EXPECT_EQ(dt.floorTo(Unit::Day), DateTime(2024, 8, 14, 0, 0, 0));
+    EXPECT_EQ(dt.floorTo(Unit::Week), DateTime(2024, 8, 12, 0, 0, 0));
+    EXPECT_EQ(dt.floorTo(Unit::Month), DateTime(2024, 8, 1, 0, 0, 0));
+    EXPECT_EQ(dt.floorTo(Unit::Quarter), DateTime(2024, 7, 1, 0, 0, 0));
+    EXPECT_EQ(dt.floorTo(Unit::Year), DateTime(2024, 1, 1, 0, 0, 0));
+}
+
+TEST(TruncationTest, CeilInUtc) {
+    DateTime dt(2024, 11, 14, 17, 42, 35, 250);
+    EXPECT_EQ(dt.ceilTo(Unit::Second), DateTime(2024, 11, 14, 17, 42, 36));
+    EXPECT_EQ(dt.ceilTo(Unit::Hour), DateTime(2024, 11, 14, 18, 0, 0));
+    EXPECT_EQ(dt.ceilTo(Unit::Day), DateTime(2024, 11, 15, 0, 0, 0));
+    EXPECT_EQ(dt.ceilTo(Unit::Week), DateTime(2024, 11, 18, 0, 0, 0));
+    EXPECT_EQ(dt.ceilTo(Unit::Month), DateTime(2024, 12, 1, 0, 0, 0));
+    EXPECT_EQ(dt.ceilTo(Unit::Quarter), DateTime(2025, 1, 1, 0, 0, 0));
+    EXPECT_EQ(dt.ceilTo(Unit::Year), DateTime(2025, 1, 1, 0, 0, 0));
+
+    // Aligned values are their own ceiling
+    DateTime aligned(2024, 3, 1, 0, 0, 0);
+    for (Unit unit : {Unit::Second, Unit::Hour, Unit::Day, Unit::Month}) {
+        EXPECT_EQ(aligned.ceilTo(unit), aligned);
+    }
+    // A sub-millisecond remainder rounds up to the next millisecond
+    DateTime fine(2024, 3, 1, 0, 0, 0, std::chrono::microseconds(250));
+    EXPECT_EQ(fine.floorTo(Unit::Millisecond), aligned);
+    EXPECT_EQ(fine.ceilTo(Unit::Millisecond), aligned.plusMilliseconds(1));
+    EXPECT_EQ(fine.ceilTo(Unit::Day), DateTime(2024, 3, 2, 0, 0, 0));
+}
+
+TEST(TruncationTest, BeforeEpochAndLeapDays) {
+    DateTime dt(1969, 12, 31, 23, 59, 59, 999);  // Wednesday
+    EXPECT_EQ(dt.floorTo(Unit::Second), DateTime(1969, 12, 31, 23, 59, 59));
+    EXPECT_EQ(dt.floorTo(Unit::Day), DateTime(1969, 12, 31, 0, 0, 0));
+    EXPECT_EQ(dt.floorTo(Unit::Week), DateTime(1969, 12, 29, 0, 0, 0));
+    EXPECT_EQ(dt.floorTo(Unit::Quarter), DateTime(1969, 10, 1, 0, 0, 0));
+    EXPECT_EQ(dt.ceilTo(Unit::Day), DateTime(1970, 1, 1, 0, 0, 0));
+
+    DateTime leap(2024, 2, 29, 12, 0, 0);
+    EXPECT_EQ(leap.floorTo(Unit::Month), DateTime(2024, 2, 1, 0, 0, 0));
+    EXPECT_EQ(leap.ceilTo(Unit::Month), DateTime(2024, 3, 1, 0, 0, 0));
+}
+
+TEST(TruncationTest, LocalTimeOfRegion) {
+    // 2024-03-31 20:30 UTC is 2024-04-01 05:30 in JST
+    DateTime utc(2024, 3, 31, 20, 30, 0);
+    DateTime jstDay = utc.floorTo(Unit::Day, DateTime::internRegion(DateTime::JapanTime));
+    EXPECT_EQ(jstDay.getRegion().identifier, "JST");
+    EXPECT_EQ(jstDay.getYear(), 2024);
+    EXPECT_EQ(jstDay.getMonth(), 4);
+    EXPECT_EQ(jstDay.getDay(), 1);
+    EXPECT_EQ(jstDay.getHour(), 0);
+    EXPECT_EQ(jstDay, DateTime(2024, 3, 31, 15, 0, 0));
+    EXPECT_EQ(utc.floorTo(Unit::Month, DateTime::internRegion(DateTime::JapanTime)), DateTime(2024, 3, 31, 15, 0, 0));
+    EXPECT_EQ(utc.floorTo(Unit::Month), DateTime(2024, 3, 1, 0, 0, 0));
+
+    // Half-hour offsets shift hour buckets too
+    DateTime nst(2024, 6, 10, 8, 45, 0, 0, DateTime::RegionTime("NST", -3, -30));
+    EXPECT_EQ(nst.floorTo(Unit::Hour), DateTime(2024, 6, 10, 8, 0, 0, 0, DateTime::RegionTime("NST", -3, -30)));
+    EXPECT_EQ(nst.ceilTo(Unit::Hour), DateTime(2024, 6, 10, 9, 0, 0, 0, DateTime::RegionTime("NST", -3, -30)));
+    EXPECT_EQ(nst.floorTo(Unit::Hour).getRegion().identifier, "NST");
+}
+
+TEST(TruncationTest, BatchMatchesPerValue) {
+    const DateTime::RegionHandle regions[] = {DateTime::RegionHandle::World,
+                                              DateTime::internRegion(DateTime::JapanTime),
+                                              DateTime::internRegion(DateTime::RegionTime("NST", -3, -30))};
+    std::vector<std::int64_t> values;
+    DateTime dt(1968, 11, 30, 22, 15, 0);
+    for (int i = 0; i < 500; ++i) {
+        values.push_back(epochMs(dt.plusMilliseconds(static_cast<std::int64_t>(i) * 7919 * 11113 * 61)));
+    }
+    std::vector<std::int64_t> floors(values.size());
+    std::vector<std::int64_t> ceils(values.size());
+    for (DateTime::RegionHandle region : regions) {
+        for (Unit unit : allUnits) {
+            DateTime::floorTo(values.data(), values.size(), unit, region, floors.data());
+            DateTime::ceilTo(values.data(), values.size(), unit, region, ceils.data());
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                DateTime value(std::chrono::system_clock::time_point(std::chrono::milliseconds(values[i])), region);
+                ASSERT_EQ(floors[i], epochMs(value.floorTo(unit))) << i;
+                ASSERT_EQ(ceils[i], epochMs(value.ceilTo(unit))) << i;
+                ASSERT_LE(floors[i], values[i]);
+                ASSERT_GE(ceils[i], values[i]);
+            }
+        }
+    }
+}
+
+TEST(TruncationTest, BatchOutsideMonthTable) {
+    // Beyond the DateTime range (and the cached month table) the batch kernels stay exact
+    const std::int64_t offsets[] = {0, 9 * 3600000, -(3 * 3600000 + 30 * 60000)};
+    std::vector<std::int64_t> values;
+    for (std::int64_t days : {-200000LL, -146097LL, -1LL, 0LL, 59LL, 146097LL, 300000LL, 4000000LL}) {
+        for (std::int64_t ms : {0LL, 1LL, 43200000LL, 86399999LL}) {
+            values.push_back(days * 86400000 + ms);
+        }
+    }
+    std::vector<std::int64_t> out(values.size());
+    for (std::int64_t offsetMs : offsets) {
+        const DateTime::RegionHandle region =
+            offsetMs == 0 ? DateTime::RegionHandle::World
+                          : DateTime::internRegion(DateTime::RegionTime(offsetMs > 0 ? "JST" : "NST",
+                                                                        static_cast<int>(offsetMs / 3600000),
+                                                                        static_cast<int>(offsetMs / 60000 % 60)));
+        for (Unit unit : allUnits) {
+            DateTime::floorTo(values.data(), values.size(), unit, region, out.data());
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                ASSERT_EQ(out[i], referenceFloor(values[i], unit, offsetMs)) << i << " unit " << static_cast<int>(unit);
+            }
+        }
+    }
+}
+
+TEST(TruncationTest, BatchInPlace) {
+    std::vector<std::int64_t> values = {epochMs(DateTime(2024, 5, 17, 9, 30, 0)), epochMs(DateTime(2023, 12, 31, 23, 59, 59))};
+    DateTime::floorTo(values.data(), values.size(), Unit::Year, DateTime::RegionHandle::World, values.data());
+    EXPECT_EQ(values[0], epochMs(DateTime(2024, 1, 1, 0, 0, 0)));
+    EXPECT_EQ(values[1], epochMs(DateTime(2023, 1, 1, 0, 0, 0)));
+}
+
+TEST(TruncationTest, ColumnBucketsRowsInTheirRegion) {
+    std::vector<DateTime> rows = {
+        DateTime(2024, 3, 31, 20, 30, 0),
+        DateTime(2024, 3, 31, 20, 30, 0).convertToRegion(DateTime::JapanTime),
+        DateTime(2024, 3, 31, 20, 30, 0).convertToRegion(DateTime::JapanTime),
+        DateTime(2024, 3, 31, 20, 30, 0),
+    };
+    DateTimeColumn column(rows);
+    ASSERT_TRUE(column.hasRowRegions());
+    column.floorTo(Unit::Month);
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        EXPECT_EQ(column[i], rows[i].floorTo(Unit::Month)) << i;
+    }
+    column.ceilTo(Unit::Year);
+    EXPECT_EQ(column[0], DateTime(2025, 1, 1, 0, 0, 0));
+    EXPECT_EQ(column[1].getYear(), 2025);
+}
@@ -0,0 +1,260 @@
+#include "datetime.hpp"
+#include "datetime_zone.hpp"
+#include "datetime_zone_registry.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void putBigEndian(std::vector<unsigned char>& out, std::uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<unsigned char>(value >> shift));
+    }
+}
+
+// Version 1 TZif without transitions and a single fixed offset
+std::vector<unsigned char> fixedZone(std::int32_t offset) {
+    std::vector<unsigned char> data{'T', 'Z', 'i', 'f'};
+    data.resize(20, 0);
+    for (std::uint32_t header : {0u, 0u, 0u, 0u, 1u, 4u}) {  // isut, isstd, leap, time, type, char
+        putBigEndian(data, header);
+    }
+    putBigEndian(data, static_cast<std::uint32_t>(offset));
+    data.push_back(0);
+    data.push_back(0);
+    for (char c : std::string("FIX\0", 4)) {
+        data.push_back(static_cast<unsigned char>(c));
+    }
+    return data;
+}
+
+// Replace a zone file the way tzdata updates do: write a new file, then rename it over the old one
+void installZone(const std::filesystem::path& path, std::int32_t offset) {
+    const std::vector<unsigned char> data = fixedZone(offset);
+    const std::filesystem::path temporary = path.string() + ".new";
+    std::ofstream(temporary, std::ios::binary).write(reinterpret_cast<const char*>(data.data()), data.size());
+    std::filesystem::rename(temporary, path);
+}
+
+// Points the zone directory at a scratch directory for the duration of a test
+class ScratchZoneDirectory {
+public:
+    ScratchZoneDirectory() : previous(DateTimeZone::zoneInfoDirectory()) {
+        std::filesystem::create_directories(directory / "Registry");
+        DateTimeZone::setZoneInfoDirectory(directory.string());
+    }
+    ~ScratchZoneDirectory() {
+        DateTimeZone::setZoneInfoDirectory(previous);
+        std::filesystem::remove_all(directory);
+    }
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "datetime_zone_registry_test";
+
+private:
+    std::string previous;
+};
+
+} // namespace
+
+TEST(ZoneRegistryTest, LoadsOnFirstUseAndResolvesAliases) {
+    ScratchZoneDirectory scratch;
+    installZone(scratch.directory / "Registry" / "Lazy", 3600);
+    DateTimeZoneRegistry& registry = DateTimeZoneRegistry::instance();
+
+    const std::size_t before = registry.size();
+    std::shared_ptr<const DateTimeZone> zone = registry.find("Registry/Lazy");
+    ASSERT_NE(zone, nullptr);
+    EXPECT_EQ(zone->name(), "Registry/Lazy");
+    EXPECT_EQ(zone->offsetAt(0), 3600);
+    EXPECT_EQ(registry.find("Registry/Lazy"), zone);
+    EXPECT_EQ(DateTimeZone::load("Registry/Lazy"), zone);
+    EXPECT_EQ(registry.size(), before + 1);
+
+    // Unknown names are not registered
+    EXPECT_EQ(registry.find("Registry/Missing"), nullptr);
+    EXPECT_THROW(registry.get("Registry/Missing"), DateTimeException);
+    EXPECT_EQ(registry.size(), before + 1);
+
+    // Aliases share the target's zone, also through another alias
+    registry.addAlias("Registry/LazyAlias", "Registry/Lazy");
+    registry.addAlias("Registry/LazyAlias2", "Registry/LazyAlias");
+    registry.addAlias("Registry/LazyAlias", "Registry/Lazy");  // Same mapping again is fine
+    EXPECT_EQ(registry.find("Registry/LazyAlias"), zone);
+    EXPECT_EQ(registry.find("Registry/LazyAlias2"), zone);
+    EXPECT_THROW(registry.addAlias("Registry/Lazy", "UTC"), DateTimeException);
+    EXPECT_THROW(registry.addAlias("Registry/LazyAlias", "UTC"), DateTimeException);
+
+    // An alias may be added before its target is loaded
+    installZone(scratch.directory / "Registry" / "Later", -7200);
+    registry.addAlias("Registry/LaterAlias", "Registry/Later");
+    std::shared_ptr<const DateTimeZone> later = registry.find("Registry/LaterAlias");
+    ASSERT_NE(later, nullptr);
+    EXPECT_EQ(later->name(), "Registry/Later");
+    EXPECT_EQ(registry.find("Registry/Later"), later);
+
+    const std::vector<std::string> names = registry.names();
+    EXPECT_NE(std::find(names.begin(), names.end(), "Registry/LazyAlias2"), names.end());
+}
+
+TEST(ZoneRegistryTest, ReloadPublishesNewData) {
+    ScratchZoneDirectory scratch;
+    const std::filesystem::path path = scratch.directory / "Registry" / "Reloaded";
+    installZone(path, 3600);
+    DateTimeZoneRegistry& registry = DateTimeZoneRegistry::instance();
+
+    std::shared_ptr<const DateTimeZone> original = registry.find("Registry/Reloaded");
+    ASSERT_NE(original, nullptr);
+    auto region = DateTime::getRegionFromTZDB("Registry/Reloaded");
+    ASSERT_TRUE(region.has_value());
+
+    // Reading an unchanged file again keeps the zone and the region handle
+    const std::uint64_t generation = registry.generation();
+    registry.reload();
+    EXPECT_EQ(registry.generation(), generation + 1);
+    EXPECT_EQ(registry.find("Registry/Reloaded"), original);
+    EXPECT_EQ(DateTime::internRegion(*DateTime::getRegionFromTZDB("Registry/Reloaded")), DateTime::internRegion(*region));
+
+    installZone(path, 7200);
+    EXPECT_EQ(registry.find("Registry/Reloaded"), original);  // Nothing changes before the reload
+    EXPECT_GE(registry.reload(), 1u);
+
+    std::shared_ptr<const DateTimeZone> reloaded = registry.find("Registry/Reloaded");
+    ASSERT_NE(reloaded, nullptr);
+    EXPECT_NE(reloaded, original);
+    EXPECT_EQ(reloaded->offsetAt(0), 7200);
+    // Earlier zones and regions keep their data
+    EXPECT_EQ(original->offsetAt(0), 3600);
+    EXPECT_EQ(DateTime(2024, 1, 1, 12, 0, 0, 0, *region), DateTime(2024, 1, 1, 11, 0, 0));
+    EXPECT_EQ(DateTime(2024, 1, 1, 12, 0, 0, 0, *DateTime::getRegionFromTZDB("Registry/Reloaded")), DateTime(2024, 1, 1, 10, 0, 0));
+
+    // A zone that disappears keeps its last data
+    std::filesystem::remove(path);
+    registry.reload();
+    EXPECT_EQ(registry.find("Registry/Reloaded"), reloaded);
+}
+
+TEST(ZoneRegistryTest, ReadersNeverBlockOnReload) {
+    ScratchZoneDirectory scratch;
+    const std::filesystem::path path = scratch.directory / "Registry" / "Busy";
+    installZone(path, 3600);
+    DateTimeZoneRegistry& registry = DateTimeZoneRegistry::instance();
+    registry.addAlias("Registry/BusyAlias", "Registry/Busy");
+    ASSERT_NE(registry.find("Registry/Busy"), nullptr);
+
+    std::atomic<bool> done(false);
+    std::atomic<long long> lookups(0);
+    std::atomic<int> unexpected(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&, t]() {
+            long long localLookups = 0;
+            while (!done.load(std::memory_order_relaxed) || localLookups == 0) {
+                std::shared_ptr<const DateTimeZone> zone = registry.find(t % 2 == 0 ? "Registry/Busy" : "Registry/BusyAlias");
+                const std::int32_t offset = zone != nullptr ? zone->offsetAt(0) : 0;
+                if (offset != 3600 && offset != 7200) {
+                    unexpected.fetch_add(1);
+                }
+                ++localLookups;
+            }
+            lookups.fetch_add(localLookups);
+        });
+    }
+    for (int round = 0; round < 20; ++round) {
+        installZone(path, round % 2 == 0 ? 7200 : 3600);
+        registry.reload();
+    }
+    done.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(unexpected.load(), 0);
+    EXPECT_GT(lookups.load(), 0);
+    EXPECT_EQ(registry.find("Registry/BusyAlias")->offsetAt(0), 3600);
+}
+
+TEST(ZoneRegistryTest, SupersededZonesStayValid) {
+    ScratchZoneDirectory scratch;
+    const std::filesystem::path path = scratch.directory / "Registry" / "Superseded";
+    installZone(path, 3600);
+    DateTimeZoneRegistry& registry = DateTimeZoneRegistry::instance();
+
+    // Registered zones are owned by the registry, so handing them out shares no counter
+    std::shared_ptr<const DateTimeZone> first = registry.find("Registry/Superseded");
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first.use_count(), 0);
+    const std::size_t regions = static_cast<std::size_t>(DateTime::internRegion(*DateTime::getRegionFromTZDB("Registry/Superseded")));
+    // Interned regions do not pin registered zones either
+    EXPECT_EQ(DateTime::regionFromHandle(static_cast<DateTime::RegionHandle>(regions)).zone.use_count(), 0);
+
+    std::vector<std::shared_ptr<const DateTimeZone>> versions{first};
+    for (int round = 0; round < 4; ++round) {
+        installZone(path, round % 2 == 0 ? 7200 : 3600);
+        EXPECT_EQ(registry.reload(), 1u);
+        versions.push_back(registry.find("Registry/Superseded"));
+    }
+    // Every version handed out keeps its data
+    for (std::size_t i = 0; i < versions.size(); ++i) {
+        EXPECT_EQ(versions[i]->offsetAt(0), i % 2 == 0 ? 3600 : 7200);
+    }
+    // An unchanged file does not replace the zone
+    EXPECT_EQ(registry.reload(), 0u);
+    EXPECT_EQ(registry.find("Registry/Superseded"), versions.back());
+
+    // Same name and data as the first zone: interning reuses its handle
+    EXPECT_EQ(static_cast<std::size_t>(DateTime::internRegion(*DateTime::getRegionFromTZDB("Registry/Superseded"))), regions);
+}
+
+TEST(ZoneRegistryTest, MissesAreRememberedUntilReload) {
+    ScratchZoneDirectory scratch;
+    DateTimeZoneRegistry& registry = DateTimeZoneRegistry::instance();
+    const std::size_t before = registry.size();
+
+    EXPECT_EQ(registry.find("Registry/Appears"), nullptr);
+    EXPECT_THROW(registry.get("Registry/Appears"), DateTimeException);
+    EXPECT_EQ(registry.size(), before);
+    const std::vector<std::string> names = registry.names();
+    EXPECT_EQ(std::find(names.begin(), names.end(), "Registry/Appears"), names.end());
+
+    // The file is not looked up again until the next reload
+    installZone(scratch.directory / "Registry" / "Appears", 3600);
+    EXPECT_EQ(registry.find("Registry/Appears"), nullptr);
+    registry.reload();
+    std::shared_ptr<const DateTimeZone> zone = registry.find("Registry/Appears");
+    ASSERT_NE(zone, nullptr);
+    EXPECT_EQ(zone->offsetAt(0), 3600);
+    EXPECT_EQ(registry.size(), before + 1);
+
+    // A name that only failed to load can still become an alias
+    EXPECT_EQ(registry.find("Registry/LateAlias"), nullptr);
+    registry.addAlias("Registry/LateAlias", "Registry/Appears");
+    EXPECT_EQ(registry.find("Registry/LateAlias"), zone);
+    EXPECT_EQ(registry.size(), before + 2);
+}
+
+TEST(ZoneRegistryTest, PosixRulesAreNotRegistered) {
+    DateTimeZoneRegistry& registry = DateTimeZoneRegistry::instance();
+    const std::size_t before = registry.size();
+    for (int hours = 1; hours <= 12; ++hours) {
+        const std::string rule = "ABC" + std::to_string(hours);
+        std::shared_ptr<const DateTimeZone> zone = registry.find(rule);
+        ASSERT_NE(zone, nullptr);
+        EXPECT_EQ(zone->offsetAt(0), -hours * 3600);
+    }
+    EXPECT_EQ(registry.size(), before);
+
+    // An alias registers its target explicitly, also when that is a POSIX string
+    registry.addAlias("Registry/PosixAlias", "XYZ-3");
+    std::shared_ptr<const DateTimeZone> aliased = registry.find("Registry/PosixAlias");
+    ASSERT_NE(aliased, nullptr);
+    EXPECT_EQ(aliased->offsetAt(0), 3 * 3600);
+    EXPECT_EQ(registry.find("XYZ-3"), aliased);
+    EXPECT_EQ(registry.size(), before + 2);
+}
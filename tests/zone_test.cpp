@@ -0,0 +1,298 @@
+#include "datetime.hpp"
+#include "datetime_column.hpp"
+#include "datetime_zone.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::int64_t epochSeconds(const DateTime& dt) {
+    return dt.getTimePoint<std::chrono::seconds>().time_since_epoch().count();
+}
+
+void putBigEndian(std::vector<unsigned char>& out, std::uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<unsigned char>(value >> shift));
+    }
+}
+
+// Version 1 TZif alternating "DST" (+2h) and "STD" (+1h) at the given instants; the default is
+// "STD" until 1,000,000 s, "DST" until 2,000,000 s, then "STD" again
+std::vector<unsigned char> syntheticZone(const std::vector<std::uint32_t>& transitions = {1000000, 2000000}) {
+    std::vector<unsigned char> data(20, 0);
+    data[0] = 'T';
+    data[1] = 'Z';
+    data[2] = 'i';
+    data[3] = 'f';
+    const std::uint32_t count = static_cast<std::uint32_t>(transitions.size());
+    for (std::uint32_t header : {0u, 0u, 0u, count, 2u, 8u}) {  // isut, isstd, leap, time, type, char
+        putBigEndian(data, header);
+    }
+    for (std::uint32_t time : transitions) {
+        putBigEndian(data, time);
+    }
+    for (std::uint32_t i = 0; i < count; ++i) {
+        data.push_back(i % 2 == 0 ? 1 : 0);
+    }
+    putBigEndian(data, 3600);
+    data.push_back(0);  // Not DST, abbreviation at 0
+    data.push_back(0);
+    putBigEndian(data, 7200);
+    data.push_back(1);  // DST, abbreviation at 4
+    data.push_back(4);
+    for (char c : std::string("STD\0DST\0", 8)) {
+        data.push_back(static_cast<unsigned char>(c));
+    }
+    return data;
+}
+
+std::shared_ptr<const DateTimeZone> loadOrSkip(const char* name) {
+    try {
+        return DateTimeZone::load(name);
+    } catch (const DateTimeException&) {
+        return nullptr;
+    }
+}
+
+} // namespace
+
+TEST(ZoneTest, ReadsTransitionTablesInPlace) {
+    static const std::vector<unsigned char> data = syntheticZone();
+    auto zone = DateTimeZone::fromMemory("Test/Zone", data);
+    EXPECT_EQ(zone->name(), "Test/Zone");
+    EXPECT_EQ(zone->version(), '\0');
+    EXPECT_FALSE(zone->isMapped());
+    EXPECT_TRUE(zone->footer().empty());
+    ASSERT_EQ(zone->transitionCount(), 2u);
+    ASSERT_EQ(zone->localTypeCount(), 2u);
+    EXPECT_EQ(zone->transition(0).utcSeconds, 1000000);
+    EXPECT_EQ(zone->transition(0).type.abbreviation, "DST");
+    EXPECT_TRUE(zone->transition(0).type.isDst);
+    EXPECT_EQ(zone->transition(1).type.utcOffset, 3600);
+    EXPECT_THROW(zone->transition(2), DateTimeException);
+
+    EXPECT_EQ(zone->offsetAt(-5000000), 3600);  // Type 0 before the first transition
+    EXPECT_EQ(zone->offsetAt(999999), 3600);
+    EXPECT_EQ(zone->offsetAt(1000000), 7200);
+    EXPECT_EQ(zone->offsetAt(1999999), 7200);
+    EXPECT_EQ(zone->offsetAt(2000000), 3600);
+    EXPECT_EQ(zone->localTypeAt(1500000).abbreviation, "DST");
+    EXPECT_EQ(zone->standardOffset(), 3600);
+
+    // Gap: local [1003600, 1007200) does not exist; ambiguity: local [2003600, 2007200) occurs twice
+    EXPECT_EQ(zone->offsetForLocal(1003599), 3600);
+    EXPECT_EQ(zone->offsetForLocal(1005000), 3600);  // Moved forward by the gap
+    EXPECT_EQ(zone->offsetForLocal(1007200), 7200);
+    EXPECT_EQ(zone->offsetForLocal(2005000), 7200);  // Earlier instant
+    EXPECT_EQ(zone->offsetForLocal(2007200), 3600);
+}
+
+TEST(ZoneTest, RejectsMalformedData) {
+    std::vector<unsigned char> data = syntheticZone();
+    std::vector<unsigned char> badMagic = data;
+    badMagic[0] = 'X';
+    EXPECT_THROW(DateTimeZone::fromMemory("Bad", badMagic), DateTimeException);
+    std::vector<unsigned char> truncated(data.begin(), data.end() - 3);
+    EXPECT_THROW(DateTimeZone::fromMemory("Bad", truncated), DateTimeException);
+    std::vector<unsigned char> badType = data;
+    badType[44 + 8] = 7;  // First transition type index
+    EXPECT_THROW(DateTimeZone::fromMemory("Bad", badType), DateTimeException);
+    std::vector<unsigned char> version2 = data;
+    version2[4] = '2';  // Claims a 64-bit block that is missing
+    EXPECT_THROW(DateTimeZone::fromMemory("Bad", version2), DateTimeException);
+}
+
+TEST(ZoneTest, LoadsFromConfiguredDirectory) {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "datetime_zone_test";
+    std::filesystem::create_directories(directory / "Test");
+    {
+        const std::vector<unsigned char> data = syntheticZone();
+        std::ofstream(directory / "Test" / "Zone", std::ios::binary).write(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+    const std::string previous = DateTimeZone::zoneInfoDirectory();
+    DateTimeZone::setZoneInfoDirectory(directory.string());
+
+    auto zone = DateTimeZone::load("Test/Zone");
+    EXPECT_TRUE(zone->isMapped());
+    EXPECT_EQ(zone->offsetAt(1500000), 7200);
+    EXPECT_EQ(DateTimeZone::load("Test/Zone"), zone);  // Cached
+    EXPECT_THROW(DateTimeZone::load("Test/Missing"), DateTimeException);
+    EXPECT_THROW(DateTimeZone::load("../Test/Zone"), DateTimeException);
+    EXPECT_THROW(DateTimeZone::load("/etc/passwd"), DateTimeException);
+    EXPECT_FALSE(DateTime::getRegionFromTZDB("Test/Missing").has_value());
+
+    DateTimeZone::setZoneInfoDirectory(previous);
+    std::filesystem::remove_all(directory);
+    // The zone stays usable after its directory is gone
+    EXPECT_EQ(zone->localTypeAt(2500000).abbreviation, "STD");
+}
+
+TEST(ZoneTest, NewYorkOffsetsFollowDst) {
+    auto zone = loadOrSkip("America/New_York");
+    if (!zone) {
+        GTEST_SKIP() << "America/New_York not found in " << DateTimeZone::zoneInfoDirectory();
+    }
+    EXPECT_GT(zone->transitionCount(), 0u);
+    EXPECT_EQ(zone->offsetAt(epochSeconds(DateTime(2024, 7, 4, 16, 0, 0))), -4 * 3600);
+    EXPECT_EQ(zone->offsetAt(epochSeconds(DateTime(2024, 1, 15, 17, 0, 0))), -5 * 3600);
+    EXPECT_EQ(zone->localTypeAt(epochSeconds(DateTime(2024, 7, 4, 16, 0, 0))).abbreviation, "EDT");
+    EXPECT_EQ(zone->standardOffset(), -5 * 3600);
+    if (zone->version() != '\0') {
+        EXPECT_FALSE(zone->footer().empty());
+    }
+
+    auto region = DateTime::getRegionFromTZDB("America/New_York");
+    ASSERT_TRUE(region.has_value());
+    EXPECT_EQ(region->identifier, "America/New_York");
+    EXPECT_EQ(region->hourOffset, -5);
+    EXPECT_EQ(region->zone, zone);
+    EXPECT_EQ(DateTime::internRegion(*region), DateTime::internRegion(*DateTime::getRegionFromTZDB("America/New_York")));
+
+    // Construction, getters and conversion use the offset of the instant
+    DateTime july(2024, 7, 4, 12, 0, 0, 0, *region);
+    EXPECT_EQ(july, DateTime(2024, 7, 4, 16, 0, 0));
+    EXPECT_EQ(july.getHour(), 12);
+    EXPECT_EQ(july.getUtcOffset(), std::chrono::hours(-4));
+    DateTime january = DateTime(2024, 1, 15, 17, 0, 0).convertToRegion(*region);
+    EXPECT_EQ(january.getHour(), 12);
+    EXPECT_EQ(january.getUtcOffset(), std::chrono::hours(-5));
+    EXPECT_EQ(july.plusMonths(6).getHour(), 12);
+    EXPECT_EQ(july.plusMonths(6), DateTime(2025, 1, 4, 17, 0, 0));
+
+    // %Z renders the abbreviation in effect, and maxFormattedSize covers the longest one
+    EXPECT_EQ(july.toString("%H:%M %Z"), "12:00 EDT");
+    EXPECT_EQ(january.toString("%H:%M %Z"), "12:00 EST");
+    EXPECT_EQ(january.toString(DateTime::FormatPattern("%Z")), "EST");
+    EXPECT_GE(DateTime::maxFormattedSize("%Z"), zone->maxAbbreviationLength());
+
+    // Skipped and repeated local times
+    EXPECT_EQ(DateTime(2024, 3, 10, 2, 30, 0, 0, *region), DateTime(2024, 3, 10, 7, 30, 0));
+    EXPECT_EQ(DateTime(2024, 11, 3, 1, 30, 0, 0, *region), DateTime(2024, 11, 3, 5, 30, 0));
+}
+
+TEST(ZoneTest, BucketingAndFieldsAcrossDst) {
+    auto region = DateTime::getRegionFromTZDB("America/New_York");
+    if (!region) {
+        GTEST_SKIP() << "America/New_York not found in " << DateTimeZone::zoneInfoDirectory();
+    }
+    const DateTime::RegionHandle handle = DateTime::internRegion(*region);
+
+    // Local midnight before the spring-forward is still EST
+    DateTime noon(2024, 3, 10, 12, 0, 0, 0, *region);
+    EXPECT_EQ(noon.floorTo(DateTime::TimeUnit::Day), DateTime(2024, 3, 10, 5, 0, 0));
+    EXPECT_EQ(noon.ceilTo(DateTime::TimeUnit::Day), DateTime(2024, 3, 11, 4, 0, 0));
+    EXPECT_EQ(noon.floorTo(DateTime::TimeUnit::Month), DateTime(2024, 3, 1, 5, 0, 0));
+
+    // Both occurrences of the repeated hour keep their own hour bucket
+    DateTime firstPass(std::chrono::system_clock::time_point(std::chrono::seconds(epochSeconds(DateTime(2024, 11, 3, 5, 40, 0)))), handle);
+    DateTime secondPass = firstPass.plusHours(1);
+    EXPECT_EQ(firstPass.floorTo(DateTime::TimeUnit::Hour), DateTime(2024, 11, 3, 5, 0, 0));
+    EXPECT_EQ(secondPass.floorTo(DateTime::TimeUnit::Hour), DateTime(2024, 11, 3, 6, 0, 0));
+
+    std::vector<std::int64_t> values;
+    for (int hour = 0; hour < 24 * 400; hour += 7) {
+        values.push_back(DateTime(2024, 1, 1, 0, 0, 0).plusHours(hour).getTimePoint<std::chrono::milliseconds>().time_since_epoch().count());
+    }
+    std::vector<std::int64_t> floors(values.size());
+    DateTime::floorTo(values.data(), values.size(), DateTime::TimeUnit::Day, handle, floors.data());
+    std::vector<std::int32_t> hours(values.size());
+    std::vector<std::int32_t> days(values.size());
+    DateTimeColumn::FieldArrays fields;
+    fields.hour = hours.data();
+    fields.day = days.data();
+    DateTimeColumn::extractFields(values.data(), values.size(), handle, fields);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        DateTime value(std::chrono::system_clock::time_point(std::chrono::milliseconds(values[i])), handle);
+        ASSERT_EQ(floors[i], value.floorTo(DateTime::TimeUnit::Day).getTimePoint<std::chrono::milliseconds>().time_since_epoch().count());
+        DateTime dayStart(std::chrono::system_clock::time_point(std::chrono::milliseconds(floors[i])), handle);
+        ASSERT_EQ(dayStart.getHour(), 0) << i;
+        ASSERT_EQ(dayStart.getDay(), value.getDay()) << i;
+        ASSERT_EQ(hours[i], value.getHour()) << i;
+        ASSERT_EQ(days[i], value.getDay()) << i;
+    }
+}
+
+TEST(ZoneTest, IndexMatchesSearch) {
+    auto check = [](const DateTimeZone& zone) {
+        ASSERT_GT(zone.indexBucketCount(), 0u);
+        std::vector<std::int64_t> instants;
+        for (std::size_t i = 0; i < zone.transitionCount(); ++i) {
+            const std::int64_t time = zone.transition(i).utcSeconds;
+            instants.insert(instants.end(), {time - 1, time, time + 1});
+        }
+        const std::int64_t from = epochSeconds(DateTime(1900, 1, 1, 0, 0, 0));
+        const std::int64_t to = epochSeconds(DateTime(2200, 1, 1, 0, 0, 0));
+        for (std::int64_t time = from; time < to; time += 86413) {
+            instants.push_back(time);
+        }
+        for (std::int64_t time : instants) {
+            ASSERT_EQ(zone.offsetAt(time), zone.searchOffsetAt(time)) << zone.name() << " at " << time;
+        }
+    };
+    static const std::vector<unsigned char> simple = syntheticZone();
+    check(*DateTimeZone::fromMemory("Test/Zone", simple));
+    // Four transitions inside one bucket fall back to the search
+    static const std::vector<unsigned char> crowded = syntheticZone({1000000, 2000000, 3000000, 4000000});
+    auto zone = DateTimeZone::fromMemory("Test/Crowded", crowded);
+    check(*zone);
+    EXPECT_EQ(zone->offsetAt(3500000), 7200);
+    if (auto newYork = loadOrSkip("America/New_York")) {
+        check(*newYork);
+    }
+}
+
+TEST(ZoneTest, IndexWindowIsConfigurable) {
+    const auto previous = DateTimeZone::indexYears();
+    EXPECT_EQ(previous, std::make_pair(1970, 2100));
+    static const std::vector<unsigned char> data = syntheticZone();
+
+    DateTimeZone::setIndexYears(1960, 1980);
+    auto narrow = DateTimeZone::fromMemory("Test/Zone", data);
+    EXPECT_EQ(narrow->indexBucketCount(), static_cast<std::size_t>((epochSeconds(DateTime(1980, 1, 1, 0, 0, 0)) -
+                                                                    epochSeconds(DateTime(1960, 1, 1, 0, 0, 0)) + (1 << 24) - 1) >> 24));
+    EXPECT_EQ(narrow->offsetAt(1500000), 7200);
+    EXPECT_EQ(narrow->offsetAt(epochSeconds(DateTime(2050, 1, 1, 0, 0, 0))), 3600);
+
+    DateTimeZone::setIndexYears(0, 0);
+    auto unindexed = DateTimeZone::fromMemory("Test/Zone", data);
+    EXPECT_EQ(unindexed->indexBucketCount(), 0u);
+    EXPECT_EQ(unindexed->offsetAt(1500000), 7200);
+
+    DateTimeZone::setIndexYears(previous.first, previous.second);
+}
+
+TEST(ZoneTest, EmbeddedZonesNeedNoFilesystem) {
+    EXPECT_FALSE(DateTimeZone::isEmbedded("Nowhere/Zone"));
+    EXPECT_FALSE(DateTimeZone::isEmbedded(""));
+    const std::vector<std::string_view> names = DateTimeZone::embeddedZoneNames();
+    if (names.empty()) {
+        GTEST_SKIP() << "Library built without DATETIME_EMBED_ZONES";
+    }
+    const std::string systemDirectory = DateTimeZone::zoneInfoDirectory();
+    DateTimeZone::setZoneInfoDirectory("/nonexistent/zoneinfo");
+    for (std::string_view name : names) {
+        EXPECT_TRUE(DateTimeZone::isEmbedded(name)) << name;
+        auto zone = DateTimeZone::load(name);
+        EXPECT_FALSE(zone->isMapped());
+        EXPECT_EQ(zone->name(), name);
+        // Same offsets as the tzdata file the zone was generated from, where that is available
+        std::shared_ptr<const DateTimeZone> file;
+        try {
+            file = DateTimeZone::fromFile(systemDirectory + "/" + std::string(name), name);
+        } catch (const DateTimeException&) {
+            continue;
+        }
+        ASSERT_EQ(zone->transitionCount(), file->transitionCount()) << name;
+        for (std::int64_t time = -2000000000; time < 4000000000; time += 7776000) {
+            ASSERT_EQ(zone->offsetAt(time), file->offsetAt(time)) << name << " at " << time;
+        }
+    }
+    EXPECT_THROW(DateTimeZone::load("Nowhere/Zone"), DateTimeException);
+    DateTimeZone::setZoneInfoDirectory(systemDirectory);
+}